@@ -17,6 +17,7 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBTimeStampUtils.h"
+#include "CCDB/CCDBShmCache.h"
 #include "CommonUtils/NameConf.h"
 #include <string>
 #include <chrono>
@@ -238,6 +239,10 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
         cached.objPtr.reset(ptr);
       }
       cached.uuid = mHeaders["ETag"];
+      if constexpr (CCDBShmCache::isShareableFlatObject<T>::value) {
+        // a single copy of the flat buffer per node, when the shared memory cache is active
+        CCDBShmCache::instance().shareFlatObject(getURL() + "/" + path + "#" + cached.uuid, *ptr);
+      }
       try { // this conversion can throw, better to catch immediately
         cached.startvalidity = std::stol(mHeaders["Valid-From"]);
         cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.h
+/// \brief  Persistent on-disk cache of CCDB objects indexed by validity
+///
+
+#ifndef O2_CCDB_CCDBDISKCACHE_H
+#define O2_CCDB_CCDBDISKCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::ccdb
+{
+
+/// A persistent cache of CCDB objects in a local directory, which can be
+/// shared by all the jobs of a node (or distributed to sites without network).
+/// Contrary to the snapshots of ALICEO2_CCDB_LOCALCACHE, it keeps all the
+/// versions of an object together with their validity, such that a query
+/// for a timestamp covered by a cached object needs no HTTP request.
+///
+/// Layout of the directory:
+/// - objects/<content hash>: the blobs as returned by the server. Identical
+///   blobs are stored once. The index keeps the size and hash of each blob,
+///   which are checked when it is read, and a file which does not match
+///   (e.g. truncated by a crash) is rewritten by the next store.
+/// - headers/<ETag>: the response headers of an object, one per line.
+/// - index: an append-only array of IndexEntry, written under an exclusive
+///   file lock and memory mapped by the readers. The objects are indexed by
+///   the URL of the server they come from and their path, since different
+///   servers may hold different objects under the same path.
+///
+/// The cache used by CcdbApi is activated by ALICEO2_CCDB_DISK_CACHE=<dir>.
+/// o2-ccdb-cache-server can serve such a directory over HTTP as a stand-in
+/// for the CCDB when running offline.
+class CCDBDiskCache
+{
+ public:
+  struct IndexEntry {
+    static constexpr size_t MaxURL = 128;
+    static constexpr size_t MaxPath = 224;
+    static constexpr size_t MaxETag = 64;
+    int64_t startValidity;
+    int64_t endValidity;
+    uint64_t contentHash;
+    uint64_t size;
+    char url[MaxURL];
+    char path[MaxPath];
+    char etag[MaxETag];
+  };
+
+  struct Entry {
+    std::string url;
+    std::string path;
+    long startValidity = 0;
+    long endValidity = -1;
+    std::string etag;
+    uint64_t contentHash = 0;
+    size_t size = 0;
+    std::string blobFile;
+    std::string headersFile;
+  };
+
+  explicit CCDBDiskCache(std::string const& dir);
+  ~CCDBDiskCache();
+
+  /// The instance configured by ALICEO2_CCDB_DISK_CACHE, nullptr if not set.
+  static CCDBDiskCache* instance();
+
+  std::string const& getDirectory() const { return mDir; }
+
+  /// Find the most recently cached object for @a path of the server @a url valid at @a timestamp.
+  bool lookup(std::string const& url, std::string const& path, long timestamp, Entry& entry);
+
+  /// All the cached versions of @a path of the server @a url, in the order they were stored.
+  std::vector<Entry> versions(std::string const& url, std::string const& path);
+
+  /// Store the blob of an object of the server @a url. The validity and the ETag are taken
+  /// from the Valid-From, Valid-Until and ETag headers, which must be present.
+  bool store(std::string const& url, std::string const& path, const char* data, size_t size, std::map<std::string, std::string> const& headers);
+
+  /// Read the headers of a cached object.
+  static bool readHeaders(Entry const& entry, std::map<std::string, std::string>& headers);
+
+  /// Read the blob of a cached object into @a dest.
+  /// @return false if it is missing or does not match the size and hash of the index.
+  template <typename Container>
+  static bool readBlob(Entry const& entry, Container& dest);
+
+  static uint64_t contentHash(const char* data, size_t size);
+
+ private:
+  void refresh();
+  Entry makeEntry(IndexEntry const& index) const;
+
+  std::string mDir;
+  std::mutex mMutex;
+  int mIndexFd = -1;
+  const IndexEntry* mIndex = nullptr; // mapped index
+  size_t mMappedSize = 0;
+  size_t mNIndexed = 0;
+  std::unordered_map<std::string, std::vector<size_t>> mByKey; // positions in the index for each server URL and path
+};
+
+template <typename Container>
+bool CCDBDiskCache::readBlob(Entry const& entry, Container& dest)
+{
+  std::ifstream in(entry.blobFile, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return false;
+  }
+  if (size_t(in.tellg()) != entry.size) {
+    return false;
+  }
+  dest.resize(entry.size);
+  in.seekg(0);
+  return in.read(dest.data(), dest.size()) && contentHash(dest.data(), dest.size()) == entry.contentHash;
+}
+
+} // namespace o2::ccdb
+
+#endif // O2_CCDB_CCDBDISKCACHE_H
@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBShmCache.h
+/// \brief  Node level cache of CCDB objects in shared memory
+///
+
+#ifndef O2_CCDB_CCDBSHMCACHE_H
+#define O2_CCDB_CCDBSHMCACHE_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace o2::ccdb
+{
+
+/// A cache of CCDB objects shared by all the processes of a node, living in a
+/// named shared memory segment. It holds
+/// - the blobs as returned by the server (i.e. the serialized ROOT files),
+///   indexed by server URL, path and validity, together with the response
+///   headers, so that processes talking to different servers never mix them,
+/// - the flat buffers of deserialized FlatObject derivatives (e.g.
+///   TPCFastTransform, MatLayerCylSet), indexed by path and ETag, so that
+///   each process keeps only the small object header on its heap. The
+///   buffers are relocated to their shared address before being published,
+///   processes attaching to them only update their own object header.
+///
+/// Entries are never modified nor removed once published, therefore they can
+/// be used without locking and stay valid until the segment is removed
+/// (e.g. between runs, with CCDBShmCache::remove). When the segment is full
+/// nothing new gets published and the callers keep their private copy.
+///
+/// The cache used by CcdbApi and BasicCCDBManager is activated by exporting
+/// ALICEO2_CCDB_SHM_CACHE=<segment name>[:<size in MB>].
+class CCDBShmCache
+{
+ public:
+  struct Blob {
+    const char* data = nullptr;
+    size_t size = 0;
+    long startValidity = 0;
+    long endValidity = -1;
+    std::map<std::string, std::string> headers;
+  };
+
+  /// Create or attach to the segment @a name. When @a size is 0 the cache is inactive.
+  CCDBShmCache(std::string const& name, size_t size);
+  ~CCDBShmCache();
+
+  /// The node level instance, as configured by ALICEO2_CCDB_SHM_CACHE.
+  static CCDBShmCache& instance();
+
+  /// Remove the segment @a name from the node.
+  static bool remove(std::string const& name);
+
+  bool isActive() const { return mImpl != nullptr; }
+
+  /// Look up the most recently published blob for @a path of the server @a url valid at @a timestamp.
+  bool find(std::string const& url, std::string const& path, long timestamp, Blob& blob) const;
+
+  /// Publish the blob of an object for @a path of the server @a url. The validity is taken
+  /// from the Valid-From / Valid-Until headers, which therefore must be present.
+  bool store(std::string const& url, std::string const& path, const char* data, size_t size, std::map<std::string, std::string> const& headers);
+
+  /// @return the shared flat buffer of @a size bytes identified by @a key, or nullptr
+  /// if it cannot be shared. If there was none yet, a new one is allocated and
+  /// @a fill is invoked to write its content before it becomes visible to others.
+  const char* shareBuffer(std::string const& key, size_t size, std::function<void(char*)> const& fill);
+
+  /// Make @a obj, a FlatObject derivative owning its buffer, use the shared
+  /// copy of its flat buffer identified by @a key. The shared bytes are never
+  /// written once published: the pointers of @a obj are relocated to the shared
+  /// address on its private buffer, which is then dropped.
+  template <typename T>
+  bool shareFlatObject(std::string const& key, T& obj);
+
+  /// Whether @a T is a FlatObject derivative whose buffer can be shared.
+  template <typename T, typename = void>
+  struct isShareableFlatObject : std::false_type {
+  };
+  template <typename T>
+  struct isShareableFlatObject<T, std::void_t<decltype(std::declval<T&>().releaseInternalBuffer()),
+                                              decltype(std::declval<T&>().adoptInternalBuffer((char*)nullptr)),
+                                              decltype(std::declval<T&>().setFutureBufferAddress((char*)nullptr)),
+                                              decltype(std::declval<T const&>().getFlatBufferPtr()),
+                                              decltype(std::declval<T const&>().getFlatBufferSize())>> : std::true_type {
+  };
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> mImpl;
+};
+
+template <typename T>
+bool CCDBShmCache::shareFlatObject(std::string const& key, T& obj)
+{
+  if (!isActive() || !obj.isBufferInternal()) {
+    return false;
+  }
+  // from now on the object uses its own buffer as an external one
+  std::unique_ptr<char[]> own{obj.releaseInternalBuffer()};
+  const size_t size = obj.getFlatBufferSize();
+  bool published = false;
+  auto shared = shareBuffer(key, size, [&obj, &own, size, &published](char* target) {
+    // relocate the pointers to the shared address, then publish the relocated bytes
+    obj.setFutureBufferAddress(target);
+    std::memcpy(target, own.get(), size);
+    published = true;
+  });
+  if (shared == nullptr) {
+    obj.adoptInternalBuffer(own.release());
+    return false;
+  }
+  if (!published) {
+    // the shared copy was already relocated by its publisher, relocate our private one the same way
+    obj.setFutureBufferAddress(const_cast<char*>(shared));
+  }
+  return true;
+}
+
+} // namespace o2::ccdb
+
+#endif // O2_CCDB_CCDBSHMCACHE_H
@@ -45,6 +45,7 @@ namespace ccdb
 {
 
 class CCDBQuery;
+class CCDBDiskCache;
 
 /**
  * Interface to the CCDB.
@@ -376,6 +377,12 @@ class CcdbApi //: public DatabaseInterface
   // report what file is read and for which purpose
   void logReading(const std::string& path, long ts, const std::map<std::string, std::string>* headers, const std::string& comment) const;
 
+  // whether a query can be served from / published to the node level shared memory cache (see CCDBShmCache)
+  bool useShmCache(std::map<std::string, std::string> const& metadata, const std::string& createdNotAfter, const std::string& createdNotBefore) const;
+
+  // the node level disk cache (see CCDBDiskCache) to use for a query, nullptr if none
+  CCDBDiskCache* diskCache(std::map<std::string, std::string> const& metadata, const std::string& createdNotAfter, const std::string& createdNotBefore) const;
+
   /**
    * Initialize in local mode; Objects will be retrieved from snapshot
    *
@@ -0,0 +1,200 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// A minimal HTTP server answering the retrieval queries of CcdbApi from a
+// CCDBDiskCache directory, to be used as a stand-in for the CCDB when running
+// without network: o2-ccdb-cache-server --dir <cache> --port 8080 and
+// http://localhost:8080 as CCDB URL on the client side. It serves the objects
+// cached from the server given by --url, with a fixed number of threads.
+
+#include "CCDB/CCDBDiskCache.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace bpo = boost::program_options;
+using o2::ccdb::CCDBDiskCache;
+
+namespace
+{
+bool sendAll(int fd, const char* data, size_t size)
+{
+  while (size > 0) {
+    auto sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+bool sendStatus(int fd, int code, const char* reason)
+{
+  auto reply = std::string("HTTP/1.1 ") + std::to_string(code) + " " + reason + "\r\nContent-Length: 0\r\n\r\n";
+  return sendAll(fd, reply.data(), reply.size());
+}
+
+// The targets are <path>/<timestamp>. Those with metadata filters
+// (<key>=<value> components) or query parameters are rejected, since the
+// cache does not keep the metadata and could serve the wrong object.
+bool parseTarget(std::string const& target, std::string& path, long& timestamp)
+{
+  if (target.find_first_of("?=") != std::string::npos) {
+    return false;
+  }
+  std::vector<std::string> tokens;
+  boost::split(tokens, target, boost::is_any_of("/"), boost::token_compress_on);
+  std::vector<std::string> components;
+  for (auto& token : tokens) {
+    if (!token.empty()) {
+      components.push_back(token);
+    }
+  }
+  if (components.size() < 2 || components.back().find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  timestamp = std::stol(components.back());
+  components.pop_back();
+  path = boost::join(components, "/");
+  return true;
+}
+
+void serve(int fd, CCDBDiskCache& cache, std::string const& url)
+{
+  std::string request;
+  char buffer[4096];
+  // keep-alive connections, as used by curl
+  while (true) {
+    size_t endOfHeaders;
+    while ((endOfHeaders = request.find("\r\n\r\n")) == std::string::npos) {
+      auto received = recv(fd, buffer, sizeof(buffer), 0);
+      if (received <= 0) {
+        return;
+      }
+      request.append(buffer, received);
+    }
+    std::istringstream lines(request.substr(0, endOfHeaders));
+    request.erase(0, endOfHeaders + 4);
+    std::string method, target, line, ifNoneMatch;
+    lines >> method >> target;
+    std::getline(lines, line);
+    while (std::getline(lines, line)) {
+      auto sep = line.find(':');
+      if (sep != std::string::npos && boost::iequals(line.substr(0, sep), "If-None-Match")) {
+        ifNoneMatch = boost::trim_copy(line.substr(sep + 1));
+      }
+    }
+
+    std::string path;
+    long timestamp;
+    CCDBDiskCache::Entry entry;
+    bool ok;
+    if (method != "GET" && method != "HEAD") {
+      ok = sendStatus(fd, 405, "Method Not Allowed");
+    } else if (!parseTarget(target, path, timestamp) || !cache.lookup(url, path, timestamp, entry)) {
+      ok = sendStatus(fd, 404, "Not Found");
+    } else if (!ifNoneMatch.empty() && ifNoneMatch == entry.etag) {
+      ok = sendStatus(fd, 304, "Not Modified");
+    } else {
+      std::map<std::string, std::string> headers;
+      std::vector<char> blob;
+      if (!CCDBDiskCache::readHeaders(entry, headers) || !CCDBDiskCache::readBlob(entry, blob)) {
+        ok = sendStatus(fd, 500, "Internal Server Error");
+      } else {
+        std::string reply = "HTTP/1.1 200 OK\r\n";
+        for (auto& [key, value] : headers) {
+          // the transfer related headers are those of this reply
+          if (!boost::iequals(key, "Content-Length") && !boost::iequals(key, "Transfer-Encoding") && !boost::iequals(key, "Connection") &&
+              !boost::iequals(key, "Location") && !boost::iequals(key, "Content-Location")) {
+            reply += key + ": " + value + "\r\n";
+          }
+        }
+        reply += "Content-Length: " + std::to_string(blob.size()) + "\r\n\r\n";
+        ok = sendAll(fd, reply.data(), reply.size()) && (method == "HEAD" || sendAll(fd, blob.data(), blob.size()));
+      }
+    }
+    if (!ok) {
+      return;
+    }
+  }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description options("Serve a CCDB disk cache directory over HTTP. Allowed options");
+  bpo::variables_map vm;
+  options.add_options()(
+    "dir,d", bpo::value<std::string>()->required(), "CCDB disk cache directory, as filled with ALICEO2_CCDB_DISK_CACHE")(
+    "url,u", bpo::value<std::string>()->default_value("http://alice-ccdb.cern.ch"), "CCDB server whose objects are served, as used by the jobs which filled the cache")(
+    "port,p", bpo::value<int>()->default_value(8080), "port to listen on")(
+    "threads,t", bpo::value<int>()->default_value(16), "number of clients served concurrently, the others wait to be accepted")(
+    "idle-timeout", bpo::value<int>()->default_value(30), "seconds after which an idle connection is closed, to free its thread")(
+    "help,h", "Produce help message.");
+  try {
+    bpo::store(parse_command_line(argc, argv, options), vm);
+    if (vm.count("help")) {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    bpo::notify(vm);
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n";
+    std::cerr << "Error parsing command line arguments; Available options:\n";
+    std::cerr << options << std::endl;
+    return 1;
+  }
+
+  CCDBDiskCache cache(vm["dir"].as<std::string>());
+  int server = socket(AF_INET, SOCK_STREAM, 0);
+  int reuse = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(vm["port"].as<int>());
+  if (server < 0 || bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, 64) != 0) {
+    std::cerr << "Unable to listen on port " << vm["port"].as<int>() << ": " << strerror(errno) << "\n";
+    return 1;
+  }
+  const auto url = vm["url"].as<std::string>();
+  const int nThreads = std::max(1, vm["threads"].as<int>());
+  const timeval idleTimeout{vm["idle-timeout"].as<int>(), 0};
+  std::cout << "Serving " << cache.getDirectory() << " for " << url << " on port " << vm["port"].as<int>() << " with " << nThreads << " threads" << std::endl;
+  // each thread accepts and serves one client at a time, the others wait in the listen backlog
+  auto worker = [server, &cache, &url, idleTimeout]() {
+    while (true) {
+      int client = accept(server, nullptr, nullptr);
+      if (client < 0) {
+        continue;
+      }
+      setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &idleTimeout, sizeof(idleTimeout));
+      serve(client, cache, url);
+      close(client);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 1; i < nThreads; i++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+}
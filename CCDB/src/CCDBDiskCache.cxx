@@ -0,0 +1,267 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "CCDB/CCDBDiskCache.h"
+#include <fairlogger/Logger.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::ccdb
+{
+
+namespace
+{
+// ETags are quoted UUIDs, keep only what is safe in a file name
+std::string sanitizeETag(std::string const& etag)
+{
+  std::string result;
+  std::copy_if(etag.begin(), etag.end(), std::back_inserter(result), [](char c) { return std::isalnum(c) || c == '-'; });
+  return result;
+}
+
+std::string indexKey(std::string const& url, std::string const& path)
+{
+  return url + '\n' + path;
+}
+
+// write to a temporary file and rename, such that readers never see partial files.
+// The temporary name is unique among the threads of all the processes sharing the cache.
+bool writeAtomically(std::string const& target, const char* data, size_t size)
+{
+  static std::atomic<uint64_t> counter{0};
+  auto tmp = fmt::format("{}.tmp{}.{}", target, getpid(), counter++);
+  {
+    std::ofstream out(tmp, std::ios::binary);
+    if (!out.write(data, size)) {
+      std::filesystem::remove(tmp);
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, target, ec);
+  return !ec;
+}
+
+// Blobs are named after their content hash. An existing file is kept only if
+// it holds the very same bytes. One which does not even match its own name
+// (e.g. truncated by a crash) is rewritten, while a valid blob with the same
+// hash but a different content (a collision) is left alone and the store fails.
+bool writeBlob(std::string const& target, const char* data, size_t size, uint64_t hash)
+{
+  std::vector<char> existing;
+  std::ifstream in(target, std::ios::binary | std::ios::ate);
+  if (in) {
+    existing.resize(in.tellg());
+    in.seekg(0);
+    if (in.read(existing.data(), existing.size())) {
+      if (existing.size() == size && std::equal(existing.begin(), existing.end(), data)) {
+        return true;
+      }
+      if (CCDBDiskCache::contentHash(existing.data(), existing.size()) == hash) {
+        LOGP(warn, "Hash collision for {} in the CCDB disk cache, not storing", target);
+        return false;
+      }
+    }
+    LOGP(warn, "Replacing corrupted {} in the CCDB disk cache", target);
+  }
+  return writeAtomically(target, data, size);
+}
+} // namespace
+
+CCDBDiskCache::CCDBDiskCache(std::string const& dir) : mDir{dir}
+{
+  std::error_code ec;
+  std::filesystem::create_directories(mDir + "/objects", ec);
+  std::filesystem::create_directories(mDir + "/headers", ec);
+  mIndexFd = open((mDir + "/index").c_str(), O_RDWR | O_CREAT | O_APPEND, 0664);
+  if (mIndexFd < 0) {
+    LOGP(error, "Unable to open CCDB disk cache index in {}: {}", mDir, strerror(errno));
+  }
+}
+
+CCDBDiskCache::~CCDBDiskCache()
+{
+  if (mIndex) {
+    munmap((void*)mIndex, mMappedSize);
+  }
+  if (mIndexFd >= 0) {
+    close(mIndexFd);
+  }
+}
+
+CCDBDiskCache* CCDBDiskCache::instance()
+{
+  static std::unique_ptr<CCDBDiskCache> inst = []() -> std::unique_ptr<CCDBDiskCache> {
+    const char* dir = getenv("ALICEO2_CCDB_DISK_CACHE");
+    if (dir == nullptr || dir[0] == 0) {
+      return nullptr;
+    }
+    LOGP(info, "Using CCDB disk cache in {}", dir);
+    return std::make_unique<CCDBDiskCache>(dir);
+  }();
+  return inst.get();
+}
+
+uint64_t CCDBDiskCache::contentHash(const char* data, size_t size)
+{
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ (unsigned char)data[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Must be called with the lock held. Maps whatever was appended to the index
+// since the last call, by us or by other processes.
+void CCDBDiskCache::refresh()
+{
+  struct stat st;
+  if (mIndexFd < 0 || fstat(mIndexFd, &st) != 0) {
+    return;
+  }
+  size_t size = st.st_size - st.st_size % sizeof(IndexEntry); // ignore a record being appended
+  if (size == mMappedSize) {
+    return;
+  }
+  if (mIndex) {
+    munmap((void*)mIndex, mMappedSize);
+    mIndex = nullptr;
+    mMappedSize = 0;
+  }
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, mIndexFd, 0);
+  if (addr == MAP_FAILED) {
+    LOGP(error, "Unable to map CCDB disk cache index in {}: {}", mDir, strerror(errno));
+    return;
+  }
+  mIndex = static_cast<const IndexEntry*>(addr);
+  mMappedSize = size;
+  for (size_t n = size / sizeof(IndexEntry); mNIndexed < n; mNIndexed++) {
+    mByKey[indexKey(mIndex[mNIndexed].url, mIndex[mNIndexed].path)].push_back(mNIndexed);
+  }
+}
+
+CCDBDiskCache::Entry CCDBDiskCache::makeEntry(IndexEntry const& index) const
+{
+  Entry entry{index.url, index.path, index.startValidity, index.endValidity, index.etag, index.contentHash, index.size};
+  entry.blobFile = fmt::format("{}/objects/{:016x}", mDir, index.contentHash);
+  entry.headersFile = fmt::format("{}/headers/{}", mDir, sanitizeETag(index.etag));
+  return entry;
+}
+
+bool CCDBDiskCache::lookup(std::string const& url, std::string const& path, long timestamp, Entry& entry)
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  refresh();
+  auto found = mByKey.find(indexKey(url, path));
+  if (found == mByKey.end()) {
+    return false;
+  }
+  // the latest stored version wins in case of overlapping validities
+  for (auto it = found->second.rbegin(); it != found->second.rend(); ++it) {
+    auto& index = mIndex[*it];
+    if (timestamp >= index.startValidity && timestamp < index.endValidity) {
+      entry = makeEntry(index);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<CCDBDiskCache::Entry> CCDBDiskCache::versions(std::string const& url, std::string const& path)
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  refresh();
+  std::vector<Entry> result;
+  auto found = mByKey.find(indexKey(url, path));
+  if (found != mByKey.end()) {
+    for (auto pos : found->second) {
+      result.push_back(makeEntry(mIndex[pos]));
+    }
+  }
+  return result;
+}
+
+bool CCDBDiskCache::store(std::string const& url, std::string const& path, const char* data, size_t size, std::map<std::string, std::string> const& headers)
+{
+  auto validFrom = headers.find("Valid-From");
+  auto validUntil = headers.find("Valid-Until");
+  auto etag = headers.find("ETag");
+  if (mIndexFd < 0 || validFrom == headers.end() || validUntil == headers.end() || etag == headers.end() ||
+      url.size() >= IndexEntry::MaxURL || path.size() >= IndexEntry::MaxPath || etag->second.size() >= IndexEntry::MaxETag) {
+    return false;
+  }
+  IndexEntry index{};
+  try {
+    index.startValidity = std::stol(validFrom->second);
+    index.endValidity = std::stol(validUntil->second);
+  } catch (std::exception const&) {
+    return false;
+  }
+  index.contentHash = contentHash(data, size);
+  index.size = size;
+  std::strncpy(index.url, url.c_str(), IndexEntry::MaxURL - 1);
+  std::strncpy(index.path, path.c_str(), IndexEntry::MaxPath - 1);
+  std::strncpy(index.etag, etag->second.c_str(), IndexEntry::MaxETag - 1);
+  auto entry = makeEntry(index);
+
+  // the content first, then the index entry which makes it visible
+  std::string headersText;
+  for (auto& [key, value] : headers) {
+    headersText += key + ": " + value + "\n";
+  }
+  if (!writeBlob(entry.blobFile, data, size, index.contentHash) || !writeAtomically(entry.headersFile, headersText.data(), headersText.size())) {
+    LOGP(warn, "Unable to store {} in the CCDB disk cache {}", path, mDir);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mMutex);
+  flock(mIndexFd, LOCK_EX);
+  refresh();
+  bool known = false;
+  if (auto found = mByKey.find(indexKey(url, path)); found != mByKey.end()) {
+    known = std::any_of(found->second.begin(), found->second.end(), [&](size_t pos) {
+      return mIndex[pos].startValidity == index.startValidity && mIndex[pos].endValidity == index.endValidity && std::strcmp(mIndex[pos].etag, index.etag) == 0;
+    });
+  }
+  bool ok = known || write(mIndexFd, &index, sizeof(index)) == sizeof(index);
+  flock(mIndexFd, LOCK_UN);
+  return ok;
+}
+
+bool CCDBDiskCache::readHeaders(Entry const& entry, std::map<std::string, std::string>& headers)
+{
+  std::ifstream in(entry.headersFile);
+  if (!in) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    auto sep = line.find(": ");
+    if (sep != std::string::npos) {
+      headers[line.substr(0, sep)] = line.substr(sep + 2);
+    }
+  }
+  return true;
+}
+
+} // namespace o2::ccdb
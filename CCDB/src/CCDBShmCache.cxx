@@ -0,0 +1,258 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "CCDB/CCDBShmCache.h"
+#include <fairlogger/Logger.h>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <cstdlib>
+#include <cstring>
+
+namespace bip = boost::interprocess;
+
+namespace o2::ccdb
+{
+
+namespace
+{
+using SegmentManager = bip::managed_shared_memory::segment_manager;
+template <typename T>
+using ShmAllocator = bip::allocator<T, SegmentManager>;
+using ShmString = bip::basic_string<char, std::char_traits<char>, ShmAllocator<char>>;
+
+struct ShmBlob {
+  long startValidity;
+  long endValidity;
+  bip::offset_ptr<char> data;
+  size_t size;
+  bip::offset_ptr<char> headers; // sequence of null terminated key, value pairs
+  size_t headersSize;
+};
+using ShmBlobs = bip::vector<ShmBlob, ShmAllocator<ShmBlob>>;
+using BlobIndex = bip::map<ShmString, ShmBlobs, std::less<ShmString>, ShmAllocator<std::pair<const ShmString, ShmBlobs>>>;
+
+struct ShmBuffer {
+  bip::offset_ptr<char> data;
+  size_t size;
+};
+using BufferIndex = bip::map<ShmString, ShmBuffer, std::less<ShmString>, ShmAllocator<std::pair<const ShmString, ShmBuffer>>>;
+
+// Everything the processes attached to the segment need to agree on.
+struct ShmHeader {
+  bip::interprocess_mutex mutex;
+  void* address; // where the segment is mapped in all processes, see CCDBShmCache::Impl
+  BlobIndex blobs;
+  BufferIndex buffers;
+  ShmHeader(void* addr, SegmentManager* manager) : address{addr}, blobs{std::less<ShmString>(), manager}, buffers{std::less<ShmString>(), manager} {}
+};
+
+constexpr const char* HeaderName = "O2CCDBShmCache";
+
+// the same path may hold different objects on different servers
+std::string blobKey(std::string const& url, std::string const& path)
+{
+  return url + '\n' + path;
+}
+} // namespace
+
+struct CCDBShmCache::Impl {
+  std::unique_ptr<bip::managed_shared_memory> segment;
+  ShmHeader* header = nullptr;
+  // Flat buffers contain pointers into themselves (e.g. the splines of
+  // TPCFastSpaceChargeCorrection), so they can only be shared when the
+  // segment is mapped at the same address in all processes.
+  bool sameAddress = false;
+
+  char* allocate(size_t size)
+  {
+    return static_cast<char*>(segment->allocate(size, std::nothrow));
+  }
+};
+
+CCDBShmCache::CCDBShmCache(std::string const& name, size_t size)
+{
+  if (size == 0) {
+    return;
+  }
+  try {
+    auto impl = std::make_unique<Impl>();
+    impl->segment = std::make_unique<bip::managed_shared_memory>(bip::open_or_create, name.c_str(), size);
+    impl->header = impl->segment->find_or_construct<ShmHeader>(HeaderName)(impl->segment->get_address(), impl->segment->get_segment_manager());
+    void* address = impl->header->address;
+    if (address != impl->segment->get_address()) {
+      // Remap at the address chosen by the creator of the segment, if available in this process.
+      impl->header = nullptr;
+      impl->segment.reset();
+      try {
+        impl->segment = std::make_unique<bip::managed_shared_memory>(bip::open_only, name.c_str(), address);
+      } catch (bip::interprocess_exception const&) {
+        LOGP(warn, "Cannot map CCDB shared memory cache {} at {}, flat objects will not be shared", name, address);
+        impl->segment = std::make_unique<bip::managed_shared_memory>(bip::open_only, name.c_str());
+      }
+      impl->header = impl->segment->find<ShmHeader>(HeaderName).first;
+    }
+    impl->sameAddress = impl->header->address == impl->segment->get_address();
+    LOGP(info, "Attached to CCDB shared memory cache {} ({} MB, {} MB free)", name, impl->segment->get_size() >> 20, impl->segment->get_free_memory() >> 20);
+    mImpl = std::move(impl);
+  } catch (bip::interprocess_exception const& e) {
+    LOGP(error, "Unable to attach to CCDB shared memory cache {}: {}. Continuing without", name, e.what());
+  }
+}
+
+CCDBShmCache::~CCDBShmCache() = default;
+
+CCDBShmCache& CCDBShmCache::instance()
+{
+  static CCDBShmCache inst = []() {
+    const char* config = getenv("ALICEO2_CCDB_SHM_CACHE");
+    if (config == nullptr || config[0] == 0) {
+      return CCDBShmCache{"", 0};
+    }
+    std::string name = config;
+    size_t sizeMB = 4096;
+    auto colon = name.find(':');
+    if (colon != std::string::npos) {
+      sizeMB = std::strtoul(name.c_str() + colon + 1, nullptr, 10);
+      name.resize(colon);
+    }
+    return CCDBShmCache{name, sizeMB << 20};
+  }();
+  return inst;
+}
+
+bool CCDBShmCache::remove(std::string const& name)
+{
+  return bip::shared_memory_object::remove(name.c_str());
+}
+
+bool CCDBShmCache::find(std::string const& url, std::string const& path, long timestamp, Blob& blob) const
+{
+  if (!isActive()) {
+    return false;
+  }
+  auto& header = *mImpl->header;
+  try {
+    ShmString key(blobKey(url, path).c_str(), mImpl->segment->get_segment_manager());
+    bip::scoped_lock<bip::interprocess_mutex> lock(header.mutex);
+    auto entry = header.blobs.find(key);
+    if (entry == header.blobs.end()) {
+      return false;
+    }
+    // the latest upload wins in case of overlapping validities
+    for (auto it = entry->second.rbegin(); it != entry->second.rend(); ++it) {
+      if (timestamp >= it->startValidity && timestamp < it->endValidity) {
+        blob.data = it->data.get();
+        blob.size = it->size;
+        blob.startValidity = it->startValidity;
+        blob.endValidity = it->endValidity;
+        blob.headers.clear();
+        for (const char *h = it->headers.get(), *end = h + it->headersSize; h < end;) {
+          const char* value = h + std::strlen(h) + 1;
+          blob.headers[h] = value;
+          h = value + std::strlen(value) + 1;
+        }
+        return true;
+      }
+    }
+  } catch (bip::bad_alloc const&) {
+    // no room left even for the lookup key
+  }
+  return false;
+}
+
+bool CCDBShmCache::store(std::string const& url, std::string const& path, const char* data, size_t size, std::map<std::string, std::string> const& headers)
+{
+  if (!isActive()) {
+    return false;
+  }
+  auto validFrom = headers.find("Valid-From");
+  auto validUntil = headers.find("Valid-Until");
+  if (validFrom == headers.end() || validUntil == headers.end()) {
+    return false;
+  }
+  ShmBlob shmBlob{};
+  try {
+    shmBlob.startValidity = std::stol(validFrom->second);
+    shmBlob.endValidity = std::stol(validUntil->second);
+  } catch (std::exception const&) {
+    return false;
+  }
+  for (auto& [key, value] : headers) {
+    shmBlob.headersSize += key.size() + value.size() + 2;
+  }
+  auto& header = *mImpl->header;
+  try {
+    ShmString key(blobKey(url, path).c_str(), mImpl->segment->get_segment_manager());
+    bip::scoped_lock<bip::interprocess_mutex> lock(header.mutex);
+    auto& blobs = header.blobs.try_emplace(key, mImpl->segment->get_segment_manager()).first->second;
+    for (auto& existing : blobs) {
+      if (existing.startValidity == shmBlob.startValidity && existing.endValidity == shmBlob.endValidity && existing.size == size) {
+        return true; // somebody else was faster
+      }
+    }
+    shmBlob.data = mImpl->allocate(size);
+    shmBlob.headers = mImpl->allocate(shmBlob.headersSize);
+    if (!shmBlob.data || !shmBlob.headers) {
+      LOGP(warn, "CCDB shared memory cache is full, not storing {}", path);
+      return false; // the memory is lost, as everything else published in the segment
+    }
+    std::memcpy(shmBlob.data.get(), data, size);
+    char* h = shmBlob.headers.get();
+    for (auto& [key, value] : headers) {
+      h = std::copy(key.begin(), key.end(), h);
+      *h++ = 0;
+      h = std::copy(value.begin(), value.end(), h);
+      *h++ = 0;
+    }
+    blobs.push_back(shmBlob);
+  } catch (bip::bad_alloc const&) {
+    LOGP(warn, "CCDB shared memory cache is full, not storing {}", path);
+    return false;
+  }
+  return true;
+}
+
+const char* CCDBShmCache::shareBuffer(std::string const& key, size_t size, std::function<void(char*)> const& fill)
+{
+  if (!isActive() || !mImpl->sameAddress) {
+    return nullptr;
+  }
+  auto& header = *mImpl->header;
+  try {
+    ShmString shmKey(key.c_str(), mImpl->segment->get_segment_manager());
+    bip::scoped_lock<bip::interprocess_mutex> lock(header.mutex);
+    auto existing = header.buffers.find(shmKey);
+    if (existing != header.buffers.end()) {
+      return existing->second.size == size ? existing->second.data.get() : nullptr;
+    }
+    char* buffer = mImpl->allocate(size);
+    if (!buffer) {
+      return nullptr;
+    }
+    try {
+      header.buffers.emplace(shmKey, ShmBuffer{buffer, size});
+    } catch (bip::bad_alloc const&) {
+      mImpl->segment->deallocate(buffer);
+      return nullptr;
+    }
+    // nobody can see the buffer before we release the lock
+    fill(buffer);
+    return buffer;
+  } catch (bip::bad_alloc const&) {
+    return nullptr;
+  }
+}
+
+} // namespace o2::ccdb
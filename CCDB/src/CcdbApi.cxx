@@ -16,6 +16,8 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBQuery.h"
+#include "CCDB/CCDBShmCache.h"
+#include "CCDB/CCDBDiskCache.h"
 
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -44,6 +46,11 @@
 #include <boost/interprocess/sync/named_semaphore.hpp>
 #include <regex>
 #include <cstdio>
+#include <condition_variable>
+#include <deque>
+#include <set>
+#include <tuple>
+#include <thread>
 
 namespace o2::ccdb
 {
@@ -53,6 +60,101 @@ using namespace std;
 std::mutex gIOMutex; // to protect TMemFile IO operations
 unique_ptr<TJAlienCredentials> CcdbApi::mJAlienCredentials = nullptr;
 
+namespace
+{
+// Fetches into the disk cache the objects which will be needed next, i.e. the
+// versions starting where the validity of the ones just downloaded ends.
+// Enabled by ALICEO2_CCDB_DISK_CACHE_PREFETCH=1 on top of the disk cache.
+class DiskCachePrefetcher
+{
+ public:
+  static DiskCachePrefetcher* instance()
+  {
+    static std::unique_ptr<DiskCachePrefetcher> inst = []() -> std::unique_ptr<DiskCachePrefetcher> {
+      const char* prefetch = getenv("ALICEO2_CCDB_DISK_CACHE_PREFETCH");
+      if (prefetch == nullptr || std::atoi(prefetch) == 0) {
+        return nullptr;
+      }
+      return std::make_unique<DiskCachePrefetcher>();
+    }();
+    return inst.get();
+  }
+
+  ~DiskCachePrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+  void request(std::string const& url, std::string const& path, long timestamp)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mRequested.emplace(url, path, timestamp).second) {
+      return;
+    }
+    mQueue.push_back({url, path, timestamp});
+    if (!mThread.joinable()) {
+      mThread = std::thread([this]() { run(); });
+    }
+    mCondition.notify_one();
+  }
+
+  /// whether the current thread is the one fetching, in which case nothing more is requested
+  static bool& isPrefetching()
+  {
+    static thread_local bool prefetching = false;
+    return prefetching;
+  }
+
+ private:
+  struct Request {
+    std::string url;
+    std::string path;
+    long timestamp;
+  };
+
+  void run()
+  {
+    isPrefetching() = true;
+    std::map<std::string, std::unique_ptr<CcdbApi>> apis;
+    while (true) {
+      Request request;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+        if (mStop) {
+          return;
+        }
+        request = std::move(mQueue.front());
+        mQueue.pop_front();
+      }
+      auto& api = apis[request.url];
+      if (!api) {
+        api = std::make_unique<CcdbApi>();
+        api->init(request.url);
+      }
+      o2::pmr::vector<char> buffer;
+      std::map<std::string, std::string> headers;
+      api->loadFileToMemory(buffer, request.path, {}, request.timestamp, &headers, "", "", "", false);
+      LOGP(debug, "Prefetched {} at {} into the CCDB disk cache: {} bytes", request.path, request.timestamp, buffer.size());
+    }
+  }
+
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::deque<Request> mQueue;
+  std::set<std::tuple<std::string, std::string, long>> mRequested;
+  std::thread mThread;
+  bool mStop = false;
+};
+} // namespace
+
 CcdbApi::CcdbApi()
 {
   setUniqueAgentID();
@@ -1035,6 +1137,25 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
 
   // normal mode follows
 
+  // with the node level caches the object is extracted from the shared blob, fetching it first if needed
+  bool shmCache = useShmCache(metadata, createdNotAfter, createdNotBefore);
+  if (shmCache || diskCache(metadata, createdNotAfter, createdNotBefore)) {
+    std::map<std::string, std::string> localHeaders;
+    auto* h = headers ? headers : &localHeaders;
+    CCDBShmCache::Blob blob;
+    if (shmCache && CCDBShmCache::instance().find(mUrl, path, timestamp, blob)) {
+      h->insert(blob.headers.begin(), blob.headers.end());
+      logReading(path, timestamp, h, "retrieve from shared memory cache");
+      if (!etag.empty() && blob.headers["ETag"] == etag) {
+        return nullptr; // the object of the caller is still valid
+      }
+      return interpretAsTMemFileAndExtract(const_cast<char*>(blob.data), blob.size, tinfo);
+    }
+    o2::pmr::vector<char> buff;
+    loadFileToMemory(buff, path, metadata, timestamp, h, etag, createdNotAfter, createdNotBefore, false);
+    return buff.empty() ? nullptr : interpretAsTMemFileAndExtract(buff.data(), buff.size(), tinfo);
+  }
+
   CURL* curl_handle = curl_easy_init();
   string fullUrl = getFullUrlForRetrieval(curl_handle, path, metadata, timestamp); // todo check if function still works correctly in case mInSnapshotMode
   // if we are in snapshot mode we can simply open the file; extract the object and return
@@ -1502,9 +1623,42 @@ void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, std::string const& p
     }
   }
 
+  CCDBShmCache::Blob blob;
+  bool shmCache = useShmCache(metadata, createdNotAfter, createdNotBefore);
+  bool fromShmCache = false;
+  CCDBDiskCache::Entry diskEntry;
+  auto disk = diskCache(metadata, createdNotAfter, createdNotBefore);
+  bool fromDiskCache = false;
+  // an object found in the disk cache is used only if its headers and, unless the ETag did not change,
+  // its blob can be read back intact. Otherwise it is downloaded again, which also repairs the cache
+  auto readFromDiskCache = [&diskEntry, &etag, &dest, headers]() {
+    std::map<std::string, std::string> diskHeaders;
+    if (!CCDBDiskCache::readHeaders(diskEntry, diskHeaders)) {
+      return false;
+    }
+    if ((etag.empty() || diskEntry.etag != etag) && !CCDBDiskCache::readBlob(diskEntry, dest)) {
+      dest.clear();
+      return false;
+    }
+    if (headers) {
+      headers->insert(diskHeaders.begin(), diskHeaders.end());
+    }
+    return true;
+  };
   if (mInSnapshotMode) { // file must be there, otherwise a fatal will be produced
     loadFileToMemory(dest, getSnapshotFile(mSnapshotTopPath, path), headers);
     fromSnapshot = 1;
+  } else if (shmCache && CCDBShmCache::instance().find(mUrl, path, timestamp, blob)) {
+    // another process of the node fetched it already. As for a server reply, nothing is loaded if the ETag did not change
+    if (headers) {
+      headers->insert(blob.headers.begin(), blob.headers.end());
+    }
+    if (etag.empty() || blob.headers["ETag"] != etag) {
+      dest.assign(blob.data, blob.data + blob.size);
+    }
+    fromShmCache = true;
+  } else if (disk && disk->lookup(mUrl, path, timestamp, diskEntry) && readFromDiskCache()) {
+    fromDiskCache = true;
   } else if (mPreferSnapshotCache && std::filesystem::exists(snapshotpath = getSnapshotFile(mSnapshotCachePath, path))) {
     // if file is available, use it, otherwise cache it below from the server. Do this only when etag is empty since otherwise the object was already fetched and cached
     if (etag.empty()) {
@@ -1533,7 +1687,23 @@ void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, std::string const& p
     return; // nothing was fetched: either cached value is good or error was produced
   }
   // !considerSnapshot means that the call was made by retrieve for snapshoting reasons
-  logReading(path, timestamp, headers, fmt::format("{}{}", considerSnapshot ? "load to memory" : "retrieve", fromSnapshot ? " from snapshot" : ""));
+  logReading(path, timestamp, headers, fmt::format("{}{}", considerSnapshot ? "load to memory" : "retrieve", fromSnapshot ? " from snapshot" : (fromShmCache ? " from shared memory cache" : (fromDiskCache ? " from disk cache" : ""))));
+
+  // make it available to the other processes of the node
+  bool fromServer = !fromShmCache && !fromDiskCache && !fromSnapshot && headers && headers->count("Error") == 0;
+  if (shmCache && (fromServer || (fromDiskCache && headers))) {
+    CCDBShmCache::instance().store(mUrl, path, dest.data(), dest.size(), *headers);
+  }
+  if (disk && (fromServer || (fromShmCache && headers))) {
+    disk->store(mUrl, path, dest.data(), dest.size(), *headers);
+  }
+  if (disk && fromServer && !DiskCachePrefetcher::isPrefetching()) {
+    auto validUntil = headers->find("Valid-Until");
+    long nextTimestamp = validUntil == headers->end() ? -1 : std::atol(validUntil->second.c_str());
+    if (nextTimestamp > 0 && nextTimestamp <= getCurrentTimestamp() && DiskCachePrefetcher::instance()) {
+      DiskCachePrefetcher::instance()->request(mUrl, path, nextTimestamp);
+    }
+  }
 
   // are we asked to create a snapshot ?
   if (createSnapshot && fromSnapshot != 2 && !(mInSnapshotMode && mSnapshotTopPath == mSnapshotCachePath)) { // store in the snapshot only if the object was not read from the snapshot
@@ -1557,6 +1727,21 @@ void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, std::string const& p
   sem_release();
 }
 
+bool CcdbApi::useShmCache(std::map<std::string, std::string> const& metadata, const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  // queries constrained by metadata or creation time may get a different object for the same path and timestamp
+  return !mInSnapshotMode && metadata.empty() && createdNotAfter.empty() && createdNotBefore.empty() && CCDBShmCache::instance().isActive();
+}
+
+CCDBDiskCache* CcdbApi::diskCache(std::map<std::string, std::string> const& metadata, const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  // same restrictions as for the shared memory cache
+  if (mInSnapshotMode || !metadata.empty() || !createdNotAfter.empty() || !createdNotBefore.empty()) {
+    return nullptr;
+  }
+  return CCDBDiskCache::instance();
+}
+
 // navigate sequence of URLs until TFile content is found; object is extracted and returned
 void CcdbApi::navigateURLsAndLoadFileToMemory(o2::pmr::vector<char>& dest, CURL* curl_handle, std::string const& url, std::map<string, string>* headers) const
 {
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCCDBDiskCache.cxx
+/// \brief  Test the persistent on-disk cache of CCDB objects
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CCDBDiskCache.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+const std::string url = "http://ccdb-test.cern.ch:8080";
+
+std::map<std::string, std::string> makeHeaders(long from, long until, std::string const& etag)
+{
+  return {{"Valid-From", std::to_string(from)}, {"Valid-Until", std::to_string(until)}, {"ETag", etag}, {"Content-Type", "application/octet-stream"}};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(store_and_lookup_test)
+{
+  auto dir = (std::filesystem::temp_directory_path() / ("ccdbDiskCache" + std::to_string(getpid()))).string();
+  std::filesystem::remove_all(dir);
+  {
+    CCDBDiskCache cache(dir);
+    BOOST_CHECK(cache.store(url, "TST/Object", "first", 5, makeHeaders(100, 200, "\"etag-1\"")));
+    BOOST_CHECK(cache.store(url, "TST/Object", "first", 5, makeHeaders(100, 200, "\"etag-1\""))); // already there
+    BOOST_CHECK(cache.store(url, "TST/Object", "second", 6, makeHeaders(150, 300, "\"etag-2\"")));
+    BOOST_CHECK(cache.store(url, "TST/Other", "first", 5, makeHeaders(0, 1000, "\"etag-3\"")));
+    BOOST_CHECK(!cache.store(url, "TST/Object", "third", 5, {{"Valid-From", "0"}})); // incomplete headers
+  }
+
+  // as seen by another job on the node
+  CCDBDiskCache cache(dir);
+  CCDBDiskCache::Entry entry;
+  BOOST_REQUIRE(cache.lookup(url, "TST/Object", 120, entry));
+  BOOST_CHECK_EQUAL(entry.etag, "\"etag-1\"");
+  std::vector<char> blob;
+  BOOST_REQUIRE(CCDBDiskCache::readBlob(entry, blob));
+  BOOST_CHECK_EQUAL(std::string(blob.begin(), blob.end()), "first");
+  std::map<std::string, std::string> headers;
+  BOOST_REQUIRE(CCDBDiskCache::readHeaders(entry, headers));
+  BOOST_CHECK_EQUAL(headers["Valid-Until"], "200");
+  BOOST_CHECK_EQUAL(headers["Content-Type"], "application/octet-stream");
+
+  // the latest stored version wins where validities overlap
+  BOOST_REQUIRE(cache.lookup(url, "TST/Object", 160, entry));
+  BOOST_CHECK_EQUAL(entry.etag, "\"etag-2\"");
+  BOOST_CHECK(!cache.lookup(url, "TST/Object", 300, entry));
+  BOOST_CHECK(!cache.lookup(url, "TST/Missing", 120, entry));
+  // nor are the objects of another server with the same path
+  BOOST_CHECK(!cache.lookup("http://other-ccdb:8080", "TST/Object", 120, entry));
+  BOOST_CHECK(cache.versions("http://other-ccdb:8080", "TST/Object").empty());
+  BOOST_CHECK_EQUAL(cache.versions(url, "TST/Object").size(), 2);
+
+  // identical content is stored once
+  BOOST_REQUIRE(cache.lookup(url, "TST/Other", 500, entry));
+  BOOST_CHECK_EQUAL(entry.blobFile, cache.versions(url, "TST/Object")[0].blobFile);
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(dir + "/index"), 3 * sizeof(CCDBDiskCache::IndexEntry));
+
+  std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_blob_test)
+{
+  auto dir = (std::filesystem::temp_directory_path() / ("ccdbDiskCacheCorrupted" + std::to_string(getpid()))).string();
+  std::filesystem::remove_all(dir);
+  CCDBDiskCache cache(dir);
+  BOOST_REQUIRE(cache.store(url, "TST/Object", "content", 7, makeHeaders(100, 200, "\"etag-1\"")));
+  CCDBDiskCache::Entry entry;
+  BOOST_REQUIRE(cache.lookup(url, "TST/Object", 120, entry));
+  std::vector<char> blob;
+
+  // a truncated blob, e.g. left by a crash, is not served
+  std::filesystem::resize_file(entry.blobFile, 3);
+  BOOST_CHECK(!CCDBDiskCache::readBlob(entry, blob));
+  // nor one with the right size but a different content
+  {
+    std::ofstream out(entry.blobFile, std::ios::binary | std::ios::trunc);
+    out << "CONTENT";
+  }
+  BOOST_CHECK(!CCDBDiskCache::readBlob(entry, blob));
+
+  // storing the object again repairs it without adding a new version
+  BOOST_REQUIRE(cache.store(url, "TST/Object", "content", 7, makeHeaders(100, 200, "\"etag-1\"")));
+  BOOST_REQUIRE(CCDBDiskCache::readBlob(entry, blob));
+  BOOST_CHECK_EQUAL(std::string(blob.begin(), blob.end()), "content");
+  BOOST_CHECK_EQUAL(cache.versions(url, "TST/Object").size(), 1);
+
+  std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_store_test)
+{
+  auto dir = (std::filesystem::temp_directory_path() / ("ccdbDiskCacheConcurrent" + std::to_string(getpid()))).string();
+  std::filesystem::remove_all(dir);
+  CCDBDiskCache cache(dir);
+  // the threads of a job storing the same object write the same files
+  std::atomic<int> nFailed{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&cache, &nFailed]() {
+      for (int j = 0; j < 20; j++) {
+        nFailed += !cache.store(url, "TST/Object", "content", 7, makeHeaders(100, 200, "\"etag-1\""));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(nFailed, 0);
+  BOOST_CHECK_EQUAL(cache.versions(url, "TST/Object").size(), 1);
+  CCDBDiskCache::Entry entry;
+  std::vector<char> blob;
+  BOOST_REQUIRE(cache.lookup(url, "TST/Object", 120, entry));
+  BOOST_CHECK(CCDBDiskCache::readBlob(entry, blob));
+
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCCDBShmCache.cxx
+/// \brief  Test the node level shared memory cache of CCDB objects
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CCDBShmCache.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+// mimics the buffer management of a FlatObject derivative: the buffer
+// holds a pointer into itself, which has to be relocated with it
+struct FlatTest {
+  char* container = nullptr;
+  char* buffer = nullptr;
+  char* text = nullptr; // points into the buffer
+  size_t size = 32;
+  FlatTest()
+  {
+    container = buffer = new char[size];
+    text = buffer + sizeof(char*);
+    std::memcpy(buffer, &text, sizeof(char*));
+    std::strcpy(text, "flat buffer");
+  }
+  ~FlatTest() { delete[] container; }
+  bool isBufferInternal() const { return buffer != nullptr && buffer == container; }
+  char* releaseInternalBuffer()
+  {
+    char* c = container;
+    container = nullptr;
+    return c;
+  }
+  void adoptInternalBuffer(char* buf) { container = buf; }
+  void setFutureBufferAddress(char* future)
+  {
+    text = future + (text - buffer);
+    std::memcpy(buffer, &text, sizeof(char*)); // only the current buffer is written
+    buffer = future;
+    delete[] container;
+    container = nullptr;
+  }
+  const char* getFlatBufferPtr() const { return buffer; }
+  size_t getFlatBufferSize() const { return size; }
+  char* storedPointer() const
+  {
+    char* ptr;
+    std::memcpy(&ptr, buffer, sizeof(char*));
+    return ptr;
+  }
+};
+
+const std::string segmentName = "o2-test-ccdb-shm-cache-" + std::to_string(getpid());
+const std::string url = "http://ccdb-test.cern.ch:8080";
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_blobs)
+{
+  CCDBShmCache::remove(segmentName);
+  {
+    CCDBShmCache cache(segmentName, 16 << 20);
+    BOOST_REQUIRE(cache.isActive());
+    std::map<std::string, std::string> headers{{"Valid-From", "100"}, {"Valid-Until", "200"}, {"ETag", "\"1\""}};
+    BOOST_CHECK(cache.store(url, "Test/Blob", "first", 6, headers));
+    headers = {{"Valid-From", "150"}, {"Valid-Until", "300"}, {"ETag", "\"2\""}};
+    BOOST_CHECK(cache.store(url, "Test/Blob", "second", 7, headers));
+    BOOST_CHECK(!cache.store(url, "Test/Blob", "novalidity", 11, {}));
+  }
+
+  // another process of the node sees what was published
+  pid_t pid = fork();
+  if (pid == 0) {
+    CCDBShmCache cache(segmentName, 16 << 20);
+    CCDBShmCache::Blob blob;
+    bool ok = cache.find(url, "Test/Blob", 120, blob) && std::strcmp(blob.data, "first") == 0 && blob.headers["ETag"] == "\"1\"";
+    ok &= cache.find(url, "Test/Blob", 160, blob) && std::strcmp(blob.data, "second") == 0 && blob.endValidity == 300;
+    ok &= !cache.find(url, "Test/Blob", 300, blob) && !cache.find(url, "Test/Other", 120, blob);
+    // the same path of another server
+    ok &= !cache.find("http://other-ccdb:8080", "Test/Blob", 120, blob);
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  CCDBShmCache::remove(segmentName);
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_objects)
+{
+  static_assert(CCDBShmCache::isShareableFlatObject<FlatTest>::value);
+  static_assert(!CCDBShmCache::isShareableFlatObject<std::string>::value);
+  CCDBShmCache::remove(segmentName);
+  CCDBShmCache cache(segmentName, 16 << 20);
+  FlatTest first, second;
+  BOOST_REQUIRE(cache.shareFlatObject("Test/Flat#1", first));
+  BOOST_CHECK(!first.isBufferInternal());
+  // the published copy was relocated to its shared address
+  const char* shared = first.getFlatBufferPtr();
+  BOOST_CHECK_EQUAL((void*)first.storedPointer(), (void*)(shared + sizeof(char*)));
+  BOOST_CHECK_EQUAL((void*)first.text, (void*)(shared + sizeof(char*)));
+  std::string published(shared, first.getFlatBufferSize());
+
+  // attaching only updates the header of the object, not the shared bytes
+  BOOST_REQUIRE(cache.shareFlatObject("Test/Flat#1", second));
+  BOOST_CHECK_EQUAL((void*)second.getFlatBufferPtr(), (void*)shared);
+  BOOST_CHECK_EQUAL((void*)second.text, (void*)(shared + sizeof(char*)));
+  BOOST_CHECK_EQUAL(std::string(second.text), "flat buffer");
+  BOOST_CHECK(published == std::string(shared, second.getFlatBufferSize()));
+  CCDBShmCache::remove(segmentName);
+}
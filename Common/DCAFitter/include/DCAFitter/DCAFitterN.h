@@ -204,9 +204,14 @@ class DCAFitterN
 
   template <class... Tr>
   int process(const Tr&... args);
+  ///< same as process but with the auxiliary (circle) parameters of the tracks precomputed with the Bz of the fitter,
+  ///  e.g. when the same track enters many combinations
+  template <class... Tr>
+  int processWithAux(const std::array<const TrackAuxPar*, N>& aux, const Tr&... args);
   void print() const;
 
  protected:
+  int processCrossings();
   bool calcPCACoefs();
   bool calcInverseWeight();
   void calcResidDerivatives();
@@ -342,6 +347,29 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
   for (int i = 0; i < N; i++) {
     mTrAux[i].set(*mOrigTrPtr[i], mBz);
   }
+  return processCrossings();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+template <class... Tr>
+int DCAFitterN<N, Args...>::processWithAux(const std::array<const TrackAuxPar*, N>& aux, const Tr&... args)
+{
+  // fit PCA of N tracks with externally provided circle parameters
+  static_assert(sizeof...(args) == N, "incorrect number of input tracks");
+  assign(0, args...);
+  clear();
+  for (int i = 0; i < N; i++) {
+    mTrAux[i] = *aux[i];
+  }
+  return processCrossings();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterN<N, Args...>::processCrossings()
+{
+  // find the crossings of the tracks with already set auxiliary parameters and minimize the chi2 starting from each of them
   if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni)) { // even for N>2 it should be enough to test just 1 loop
     return 0;                                                                              // no crossing
   }
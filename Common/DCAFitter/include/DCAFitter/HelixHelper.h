@@ -19,6 +19,8 @@
 #include "CommonConstants/MathConstants.h"
 #include "MathUtils/Utils.h"
 #include "MathUtils/Primitive2D.h"
+#include <cstdint>
+#include <vector>
 
 namespace o2
 {
@@ -276,6 +278,51 @@ struct CrossInfo {
   ClassDefNV(CrossInfo, 1);
 };
 
+//__________________________________________________________
+//< circle parameters of a set of tracks in SoA layout, for the batched preselection of their crossings with a given track
+struct TrackCirclesSoA {
+  std::vector<float> xC, yC, rC;
+
+  size_t size() const { return rC.size(); }
+  void clear()
+  {
+    xC.clear();
+    yC.clear();
+    rC.clear();
+  }
+  void reserve(size_t n)
+  {
+    xC.reserve(n);
+    yC.reserve(n);
+    rC.reserve(n);
+  }
+  void add(const TrackAuxPar& trax)
+  {
+    xC.push_back(trax.xC);
+    yC.push_back(trax.yC);
+    rC.push_back(trax.rC);
+  }
+
+  ///< flag (ok[i] = 0) the circles first+i, i < n, separated from the circle trax0 by more than maxDistXY, i.e. those
+  ///  for which CrossInfo::set would find no crossing. The loop has no branches and no sqrt so that it can be vectorized.
+  ///  The distances are compared in squares with a small margin keeping the rejection conservative w.r.t. the rounding
+  ///  of the full calculation. The pairs involving straight lines (rC = 0) are never rejected here and are left to CrossInfo.
+  void preselectCrossings(const TrackAuxPar& trax0, size_t first, int n, float maxDistXY, uint8_t* ok) const
+  {
+    constexpr float Margin = 1e-4;
+    const float* xc = xC.data() + first;
+    const float* yc = yC.data() + first;
+    const float* rc = rC.data() + first;
+    const float x0 = trax0.xC, y0 = trax0.yC, r0 = trax0.rC; // local copies, since ok may alias them
+    const uint8_t circle0 = r0 > o2::constants::math::Almost0;
+    for (int i = 0; i < n; i++) {
+      float xDist = xc[i] - x0, yDist = yc[i] - y0, dmax = r0 + rc[i] + maxDistXY;
+      uint8_t far = xDist * xDist + yDist * yDist > dmax * dmax * (1.f + Margin), circle1 = rc[i] > o2::constants::math::Almost0;
+      ok[i] = 1 - (circle0 & circle1 & far);
+    }
+  }
+};
+
 } // namespace track
 } // namespace o2
 
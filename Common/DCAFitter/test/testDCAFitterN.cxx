@@ -467,5 +467,64 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(DCAFitterNBatchedSeeding)
+{
+  // the fit with cached circles must reproduce the standard one, and the batched preselection must not reject any pair
+  // for which the standard fit finds a candidate
+  constexpr int NTest = 2000;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<o2::track::TrackParCov> vctracks, tracksPos, tracksNeg;
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (int iev = 0; iev < NTest; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+    tracksPos.push_back(vctracks[0]);
+    tracksNeg.push_back(vctracks[1]);
+  }
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(bz);
+  ft.setMaxDXYIni(4);
+  std::vector<o2::track::TrackAuxPar> auxNeg;
+  o2::track::TrackCirclesSoA circlesNeg;
+  for (const auto& t : tracksNeg) {
+    circlesNeg.add(auxNeg.emplace_back(t, bz));
+  }
+  constexpr int BatchSize = 32;
+  std::array<uint8_t, BatchSize> mask;
+  int nFitted = 0, nRejected = 0, nMismatch = 0, nLost = 0;
+  for (int ip = 0; ip < 200; ip++) {
+    o2::track::TrackAuxPar auxP(tracksPos[ip], bz);
+    for (int in0 = 0; in0 < NTest; in0 += BatchSize) {
+      int nb = std::min(BatchSize, NTest - in0);
+      circlesNeg.preselectCrossings(auxP, in0, nb, ft.getMaxDXYIni(), mask.data());
+      for (int ib = 0; ib < nb; ib++) {
+        int in = in0 + ib;
+        int nc = ft.process(tracksPos[ip], tracksNeg[in]);
+        std::array<float, 3> pca{};
+        if (nc) {
+          pca = ft.getPCACandidatePos();
+          nFitted++;
+        }
+        if (!mask[ib]) {
+          nRejected++;
+          nLost += nc > 0;
+          continue;
+        }
+        int ncAux = ft.processWithAux({&auxP, &auxNeg[in]}, tracksPos[ip], tracksNeg[in]);
+        nMismatch += ncAux != nc || (nc && ft.getPCACandidatePos() != pca);
+      }
+    }
+  }
+  LOG(info) << "Batched seeding: " << nRejected << " pairs preselected out, " << nFitted << " with candidates, "
+            << nLost << " lost, " << nMismatch << " mismatches";
+  BOOST_CHECK(nRejected > 0);
+  BOOST_CHECK(nLost == 0);
+  BOOST_CHECK(nMismatch == 0);
+}
+
 } // namespace vertexing
 } // namespace o2
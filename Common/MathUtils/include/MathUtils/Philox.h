@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Philox.h
+/// \brief Counter-based random number generator Philox4x32-10
+///
+/// Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11.
+/// The output is a pure function of a 128 bit counter and a 64 bit key, such that the random numbers
+/// attached to an object (e.g. an electron) do not depend on the order or the thread in which it is processed.
+
+#ifndef ALICEO2_MATHUTILS_PHILOX_H_
+#define ALICEO2_MATHUTILS_PHILOX_H_
+
+#include <array>
+#include <cstdint>
+
+namespace o2
+{
+namespace math_utils
+{
+
+class Philox
+{
+ public:
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  /// 128 random bits for a given counter and key
+  /// \param counter counter, e.g. identifier of the object the random numbers are attached to
+  /// \param key key, e.g. seed of the simulation
+  /// \return four random 32 bit words
+  static Counter generate(Counter counter, Key key)
+  {
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += Weyl0;
+        key[1] += Weyl1;
+      }
+      const uint64_t product0 = static_cast<uint64_t>(Multiplier0) * counter[0];
+      const uint64_t product1 = static_cast<uint64_t>(Multiplier1) * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+    }
+    return counter;
+  }
+
+  /// convert a random word to a flat random number in [0, 1)
+  static float toFlat(uint32_t word) { return static_cast<float>(word >> 8) * (1.f / 16777216.f); }
+
+ private:
+  static constexpr uint32_t Multiplier0 = 0xD2511F53;
+  static constexpr uint32_t Multiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t Weyl0 = 0x9E3779B9;
+  static constexpr uint32_t Weyl1 = 0xBB67AE85;
+};
+
+} // namespace math_utils
+} // namespace o2
+
+#endif // ALICEO2_MATHUTILS_PHILOX_H_
@@ -30,9 +30,13 @@
 #define ALICEO2_MATHUTILS_RANDOMRING_H_
 
 #include <array>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "TF1.h"
 #include "TRandom.h"
+#include "MathUtils/Philox.h"
 #include <functional>
 
 
@@ -72,6 +76,17 @@ class RandomRing
   /// @param [in] randomType type of the random generator
   void initialize(std::function<float()> function);
 
+  /// initialisation of the random ring with counter-based random numbers, the content only depends on the key
+  /// @param [in] randomType type of the random generator
+  /// @param [in] key key of the counter-based generator
+  void initialize(const RandomType randomType, const Philox::Key& key);
+
+  /// initialisation of the random ring with counter-based random numbers, the content only depends on the key
+  /// The function is sampled by inversion of its cumulative distribution on GetNpx() points
+  /// @param [in] function TF1 function
+  /// @param [in] key key of the counter-based generator
+  void initialize(TF1& function, const Philox::Key& key);
+
   /// next random value from the ring buffer
   /// This function return a value from the ring buffer
   /// and increases the buffer position
@@ -110,6 +125,15 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// set the position in the ring buffer
+  /// @param [in] position new position, wrapped around the size of the ring
+  void setRingPosition(size_t position) { mRingPosition = position % N; }
+
+  /// random value at a given position, without changing the present position
+  /// @param [in] position position, wrapped around the size of the ring
+  /// @return random value
+  float getValue(size_t position) const { return mRandomNumbers[position % N]; }
+
  private:
   // =========================================================================
   // ===| members |===========================================================
@@ -184,6 +208,63 @@ inline void RandomRing<N>::initialize(std::function<float()> function)
   }
 }
 
+//______________________________________________________________________________
+template <size_t N>
+inline void RandomRing<N>::initialize(const RandomType randomType, const Philox::Key& key)
+{
+  mRandomType = randomType;
+  Philox::Counter counter{};
+  for (size_t i = 0; i < N; i += 2) {
+    counter[0] = i / 2;
+    const auto random = Philox::generate(counter, key);
+    float values[2]{};
+    switch (randomType) {
+      case RandomType::Gaus: { // Box-Muller
+        const float radius = std::sqrt(-2.f * std::log(1.f - Philox::toFlat(random[0])));
+        const float phi = 2.f * static_cast<float>(M_PI) * Philox::toFlat(random[1]);
+        values[0] = radius * std::cos(phi);
+        values[1] = radius * std::sin(phi);
+        break;
+      }
+      case RandomType::Flat: {
+        values[0] = Philox::toFlat(random[0]);
+        values[1] = Philox::toFlat(random[1]);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+    mRandomNumbers[i] = values[0];
+    if (i + 1 < N) {
+      mRandomNumbers[i + 1] = values[1];
+    }
+  }
+}
+
+//______________________________________________________________________________
+template <size_t N>
+inline void RandomRing<N>::initialize(TF1& function, const Philox::Key& key)
+{
+  mRandomType = RandomType::CustomTF1;
+  const int nPoints = function.GetNpx();
+  const double xMin = function.GetXmin();
+  const double dx = (function.GetXmax() - xMin) / nPoints;
+  std::vector<double> cumulative(nPoints + 1, 0.);
+  for (int i = 0; i < nPoints; ++i) {
+    cumulative[i + 1] = cumulative[i] + std::max(0., function.Eval(xMin + (i + 0.5) * dx));
+  }
+
+  Philox::Counter counter{};
+  for (size_t i = 0; i < N; ++i) {
+    counter[0] = i;
+    const double integral = Philox::toFlat(Philox::generate(counter, key)[0]) * cumulative.back();
+    const int bin = std::min<int>(std::upper_bound(cumulative.begin(), cumulative.end(), integral) - cumulative.begin() - 1, nPoints - 1);
+    const double content = cumulative[bin + 1] - cumulative[bin];
+    mRandomNumbers[i] = xMin + dx * (bin + (content > 0. ? (integral - cumulative[bin]) / content : 0.5));
+  }
+}
+
 } // namespace math_utils
 } // namespace o2
 #endif
@@ -0,0 +1,39 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Philox
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MathUtils/Philox.h"
+
+using o2::math_utils::Philox;
+
+BOOST_AUTO_TEST_CASE(Philox_test)
+{
+  // known answers of the Philox4x32-10 reference implementation (Random123)
+  BOOST_CHECK((Philox::generate({0, 0, 0, 0}, {0, 0}) == Philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  BOOST_CHECK((Philox::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}) == Philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  BOOST_CHECK((Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}) == Philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+  // flat random numbers
+  double sum = 0;
+  const int n = 100000;
+  for (uint32_t i = 0; i < n; ++i) {
+    const auto words = Philox::generate({i, 0, 0, 0}, {42, 0});
+    for (auto word : words) {
+      const float flat = Philox::toFlat(word);
+      BOOST_CHECK(flat >= 0.f && flat < 1.f);
+      sum += flat;
+    }
+  }
+  BOOST_CHECK_CLOSE(sum / (4 * n), 0.5, 0.5);
+}
@@ -20,6 +20,8 @@
 #include <cassert>
 #include <type_traits>
 #include <cstddef>
+#include <cmath>
+#include <optional>
 #include <Rtypes.h>
 #include "rANS/rans.h"
 #include "rANS/utils.h"
@@ -107,8 +109,11 @@ struct Metadata {
     EENCODE,                      // entropy encoding applied
     ROOTCompression,              // original data repacked to array with slot-size = streamSize and saved with root compression
     NONE,                         // original data repacked to array with slot-size = streamSize and saved w/o compression
-    NODATA                        // no data was provided
+    NODATA,                       // no data was provided
+    EENCODE_INTERLEAVED,          // entropy encoding applied with nStreams interleaved rANS states
+    AUTO                          // request only: EENCODE with the best probability bits or NONE, whichever is predicted to be smaller
   };
+  static constexpr uint8_t DefaultNStreams = 8; // number of interleaved rANS states used with EENCODE_INTERLEAVED
   size_t messageLength = 0;
   size_t nLiterals = 0;
   uint8_t messageWordSize = 0;
@@ -121,7 +126,9 @@ struct Metadata {
   int nDictWords = 0;
   int nDataWords = 0;
   int nLiteralWords = 0;
+  uint8_t nStreams = 0; // number of interleaved rANS states, 0 for non-interleaved encoding
 
+  bool isEncoded() const { return opt == OptStore::EENCODE || opt == OptStore::EENCODE_INTERLEAVED; }
   size_t getUncompressedSize() const { return messageLength * messageWordSize; }
   size_t getCompressedSize() const { return (nDictWords + nDataWords + nLiteralWords) * streamSize; }
   void clear()
@@ -136,8 +143,9 @@ struct Metadata {
     nDictWords = 0;
     nDataWords = 0;
     nLiteralWords = 0;
+    nStreams = 0;
   }
-  ClassDefNV(Metadata, 2);
+  ClassDefNV(Metadata, 3);
 };
 
 /// registry struct for the buffer start and offsets of writable space
@@ -444,6 +452,17 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, float memfc = 1.f);
 
+  /// encode src to the single-block container created in slotBuffer, independently of other slots (e.g. concurrently)
+  template <typename input_IT, typename buffer_T>
+  static o2::ctf::CTFIOSize encodeSlot(buffer_T& slotBuffer, const input_IT srcBegin, const input_IT srcEnd, uint8_t symbolTablePrecision, Metadata::OptStore opt, const void* encoderExt = nullptr, float memfc = 1.f)
+  {
+    return EncodedBlocks<H, 1, W>::create(slotBuffer)->encode(srcBegin, srcEnd, 0, symbolTablePrecision, opt, &slotBuffer, encoderExt, memfc);
+  }
+
+  /// copy the block prepared by encodeSlot to the provided slot (must be the next one to fill) of the container in the buffer
+  template <typename buffer_T, typename slotBuffer_T>
+  static auto appendSlot(buffer_T& buffer, int slot, const slotBuffer_T& slotBuffer);
+
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
   o2::ctf::CTFIOSize decode(container_T& dest, int slot, const void* decoderExt = nullptr) const;
@@ -782,7 +801,7 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::decode(D_IT dest,
 
   // decode
   if (block.getNStored()) {
-    if (md.opt == Metadata::OptStore::EENCODE) {
+    if (md.isEncoded()) {
       if (!decoderExt && !block.getNDict()) {
         LOG(error) << "Dictionaty is not saved for slot " << slot << " and no external decoder is provided";
         throw std::runtime_error("Dictionary is not saved and no external decoder provided");
@@ -807,11 +826,28 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::decode(D_IT dest,
         // to D-word array
         literals = std::vector<dest_t>{reinterpret_cast<const dest_t*>(block.getLiterals()), reinterpret_cast<const dest_t*>(block.getLiterals()) + md.nLiterals};
       }
-      decoder->process(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      const auto* const inputEnd = block.getData() + block.getNData();
+      if (md.opt == Metadata::OptStore::EENCODE) {
+        decoder->process(inputEnd, dest, md.messageLength, literals);
+      } else {
+        switch (md.nStreams) {
+          case 4:
+            decoder->template processInterleaved<4>(inputEnd, dest, md.messageLength, literals);
+            break;
+          case 8:
+            decoder->template processInterleaved<8>(inputEnd, dest, md.messageLength, literals);
+            break;
+          case 16:
+            decoder->template processInterleaved<16>(inputEnd, dest, md.messageLength, literals);
+            break;
+          default:
+            throw std::runtime_error(fmt::format("unsupported number of interleaved rANS streams {} for slot {}", int(md.nStreams), slot));
+        }
+      }
     } else { // data was stored as is
       using destPtr_t = typename std::iterator_traits<D_IT>::pointer;
       destPtr_t srcBegin = reinterpret_cast<destPtr_t>(block.payload);
-      destPtr_t srcEnd = srcBegin + md.messageLength * sizeof(dest_t);
+      destPtr_t srcEnd = srcBegin + md.messageLength;
       std::copy(srcBegin, srcEnd, dest);
       // std::memcpy(dest, block.payload, md.messageLength * sizeof(dest_t));
     }
@@ -861,6 +897,29 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   auto* thisBlock = &mBlocks[slot];
   auto* thisMetadata = &mMetadata[slot];
 
+  // automatic mode: pick the probability bits and compare the predicted entropy coded size (dictionary + data) to the plain one.
+  // With an external dictionary there is nothing to tune, the message is entropy coded.
+  std::optional<rans::FrequencyTable> autoFrequencyTable;
+  std::optional<RenormedFrequencyTable> autoRenormedFrequencyTable;
+  if (opt == Metadata::OptStore::AUTO) {
+    opt = Metadata::OptStore::EENCODE;
+    if (!encoderExt) {
+      const size_t nPlainWords = calculateNDestTElements<input_t, storageBuffer_t>(messageLength);
+      autoFrequencyTable = rans::makeFrequencyTableFromSamples(srcBegin, srcEnd);
+      size_t nEncodedWords = autoFrequencyTable->size();
+      if (nEncodedWords < nPlainWords) { // otherwise the dictionary alone is larger than the plain data
+        autoRenormedFrequencyTable = rans::renormOptimal(*autoFrequencyTable);
+        const double codeLengthBits = rans::computeExpectedCodeLength(*autoFrequencyTable, *autoRenormedFrequencyTable);
+        nEncodedWords += size_t(std::ceil(codeLengthBits / (8 * sizeof(storageBuffer_t)))) + 2 * sizeof(ransState_t) / sizeof(storageBuffer_t);
+      }
+      if (nPlainWords <= nEncodedWords) {
+        opt = Metadata::OptStore::NONE;
+        autoRenormedFrequencyTable.reset();
+      }
+      LOGP(debug, "Slot {}: auto mode selected {}, predicted {} words vs {} plain", slot, opt == Metadata::OptStore::NONE ? "NONE" : "EENCODE", nEncodedWords, nPlainWords);
+    }
+  }
+
   // resize underlying buffer of block if necessary and update all pointers.
   auto expandStorage = [&](int additionalElements) {
     auto* const blockHead = get(thisBlock->registry->head);                         // extract pointer from the block, as "this" might be invalid
@@ -878,7 +937,7 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   };
 
   // case 3: message where entropy coding should be applied
-  if (opt == Metadata::OptStore::EENCODE) {
+  if (opt == Metadata::OptStore::EENCODE || opt == Metadata::OptStore::EENCODE_INTERLEAVED) {
     // build symbol statistics
     constexpr size_t SizeEstMarginAbs = 10 * 1024;
     const float SizeEstMarginRel = 1.5 * memfc;
@@ -886,6 +945,8 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
     const auto [inplaceEncoder, frequencyTable] = [&]() {
       if (encoderExt) {
         return std::make_tuple(ransEncoder_t{}, rans::FrequencyTable{});
+      } else if (autoRenormedFrequencyTable) {
+        return std::make_tuple(ransEncoder_t{*autoRenormedFrequencyTable}, std::move(*autoFrequencyTable));
       } else {
         rans::FrequencyTable frequencyTable = rans::makeFrequencyTableFromSamples(srcBegin, srcEnd);
         RenormedFrequencyTable renormedFrequencyTable = rans::renorm(frequencyTable, symbolTablePrecision);
@@ -909,7 +970,9 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
     // directly encode source message into block buffer.
     storageBuffer_t* const blockBufferBegin = thisBlock->getCreateData();
     const size_t maxBufferSize = thisBlock->registry->getFreeSize(); // note: "this" might be not valid after expandStorage call!!!
-    const auto encodedMessageEnd = encoder->process(srcBegin, srcEnd, blockBufferBegin, literals);
+    const uint8_t nStreams = opt == Metadata::OptStore::EENCODE_INTERLEAVED ? Metadata::DefaultNStreams : 0;
+    const auto encodedMessageEnd = nStreams ? encoder->template processInterleaved<Metadata::DefaultNStreams>(srcBegin, srcEnd, blockBufferBegin, literals)
+                                            : encoder->process(srcBegin, srcEnd, blockBufferBegin, literals);
     rans::utils::checkBounds(encodedMessageEnd, blockBufferBegin + maxBufferSize / sizeof(W));
     dataSize = encodedMessageEnd - thisBlock->getDataPointer();
     thisBlock->setNData(dataSize);
@@ -946,7 +1009,8 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
                              encoder->getMaxSymbol(),
                              static_cast<int32_t>(frequencyTable.size()),
                              dataSize,
-                             static_cast<int32_t>(nLiteralWords)};
+                             static_cast<int32_t>(nLiteralWords),
+                             nStreams};
   } else { // store original data w/o EEncoding
     // FIXME(milettri): we should be able to do without an intermediate vector;
     //  provided iterator is not necessarily pointer, need to use intermediate vector!!!
@@ -965,6 +1029,26 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
 }
 
+///_____________________________________________________________________________
+/// copy the block prepared by encodeSlot to the provided slot of the container in the buffer, expanding it if needed
+template <typename H, int N, typename W>
+template <typename buffer_T, typename slotBuffer_T>
+auto EncodedBlocks<H, N, W>::appendSlot(buffer_T& buffer, int slot, const slotBuffer_T& slotBuffer)
+{
+  const auto* src = EncodedBlocks<H, 1, W>::get(slotBuffer.data());
+  const auto& srcBlock = src->getBlock(0);
+  auto* dest = get(buffer.data());
+  assert(slot == dest->mRegistry.nFilledBlocks);
+  const size_t sz = estimateBlockSize(srcBlock.getNStored());
+  if (sz > dest->getFreeSize()) {
+    dest = expand(buffer, dest->size() + (sz - dest->getFreeSize()));
+  }
+  dest->mBlocks[slot].store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  dest->mMetadata[slot] = src->getMetadata(0);
+  dest->mRegistry.nFilledBlocks++;
+  return dest;
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
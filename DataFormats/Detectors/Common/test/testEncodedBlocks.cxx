@@ -0,0 +1,182 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EncodedBlocks
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CTFDictHeader.h"
+
+using namespace o2::ctf;
+
+using EB = EncodedBlocks<CTFDictHeader, 3>;
+using OptStore = Metadata::OptStore;
+
+// payloads of different word sizes; the lengths of the last two are not multiples of the number of interleaved streams
+struct Payload {
+  std::vector<int32_t> wide;
+  std::vector<uint16_t> medium;
+  std::vector<int8_t> narrow;
+};
+
+Payload makePayload(size_t nWide, size_t nMedium, size_t nNarrow)
+{
+  std::mt19937 generator(12345);
+  std::binomial_distribution<int> binomial(1000, 0.3);
+  std::geometric_distribution<int> geometric(0.05);
+  Payload payload;
+  for (size_t i = 0; i < nWide; i++) {
+    payload.wide.push_back(binomial(generator) - 300);
+  }
+  for (size_t i = 0; i < nMedium; i++) {
+    payload.medium.push_back(geometric(generator));
+  }
+  for (size_t i = 0; i < nNarrow; i++) {
+    payload.narrow.push_back(int8_t(geometric(generator) % 100 - 10));
+  }
+  return payload;
+}
+
+std::vector<char> encodePayload(const Payload& payload, OptStore opt)
+{
+  std::vector<char> buffer;
+  EB::create(buffer);
+  EB::get(buffer.data())->encode(payload.wide, 0, 16, opt, &buffer);
+  EB::get(buffer.data())->encode(payload.medium, 1, 16, opt, &buffer);
+  EB::get(buffer.data())->encode(payload.narrow, 2, 16, opt, &buffer);
+  return buffer;
+}
+
+// decode from a relocated copy of the flat buffer, as the CTF readers do
+void checkDecoded(const std::vector<char>& buffer, const Payload& payload)
+{
+  const std::vector<char> copy(buffer);
+  const auto image = EB::getImage(copy.data());
+  std::vector<int32_t> wide;
+  std::vector<uint16_t> medium;
+  std::vector<int8_t> narrow;
+  image.decode(wide, 0);
+  image.decode(medium, 1);
+  image.decode(narrow, 2);
+  BOOST_CHECK(wide == payload.wide);
+  BOOST_CHECK(medium == payload.medium);
+  BOOST_CHECK(narrow == payload.narrow);
+}
+
+BOOST_AUTO_TEST_CASE(EncodedBlocksInterleaved_test)
+{
+  for (const auto& lengths : {std::array<size_t, 3>{10000, 1001, 7}, std::array<size_t, 3>{8, 3, 1}}) {
+    const auto payload = makePayload(lengths[0], lengths[1], lengths[2]);
+    const auto buffer = encodePayload(payload, OptStore::EENCODE_INTERLEAVED);
+    const auto* eb = EB::get(buffer.data());
+    for (int slot = 0; slot < EB::getNBlocks(); slot++) {
+      BOOST_CHECK(eb->getMetadata(slot).opt == OptStore::EENCODE_INTERLEAVED);
+      BOOST_CHECK_EQUAL(int(eb->getMetadata(slot).nStreams), int(Metadata::DefaultNStreams));
+      BOOST_CHECK_EQUAL(eb->getMetadata(slot).messageLength, lengths[slot]);
+    }
+    checkDecoded(buffer, payload);
+
+    // the same payload stored with the single stream coder decodes to the same content
+    const auto bufferSingle = encodePayload(payload, OptStore::EENCODE);
+    for (int slot = 0; slot < EB::getNBlocks(); slot++) {
+      BOOST_CHECK(EB::get(bufferSingle.data())->getMetadata(slot).opt == OptStore::EENCODE);
+      BOOST_CHECK_EQUAL(int(EB::get(bufferSingle.data())->getMetadata(slot).nStreams), 0);
+    }
+    checkDecoded(bufferSingle, payload);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EncodedBlocksAppendSlot_test)
+{
+  const auto payload = makePayload(10000, 1001, 7);
+  const auto reference = encodePayload(payload, OptStore::EENCODE);
+
+  // blocks encoded independently, as done by the concurrent CTF encoding
+  std::array<std::vector<BufferType>, EB::getNBlocks()> slotBuffers;
+  EB::encodeSlot(slotBuffers[0], payload.wide.begin(), payload.wide.end(), 16, OptStore::EENCODE);
+  EB::encodeSlot(slotBuffers[1], payload.medium.begin(), payload.medium.end(), 16, OptStore::EENCODE);
+  EB::encodeSlot(slotBuffers[2], payload.narrow.begin(), payload.narrow.end(), 16, OptStore::EENCODE);
+
+  // the container is created without free space, every appended block must expand it
+  std::vector<char> buffer;
+  EB::create(buffer);
+  BOOST_CHECK_EQUAL(EB::get(buffer.data())->getFreeSize(), 0);
+  for (int slot = 0; slot < EB::getNBlocks(); slot++) {
+    const size_t sizeBefore = buffer.size();
+    const auto* eb = EB::appendSlot(buffer, slot, slotBuffers[slot]);
+    BOOST_CHECK(eb == EB::get(buffer.data()));
+    BOOST_CHECK(buffer.size() > sizeBefore);
+    BOOST_CHECK(eb->size() <= buffer.size());
+    BOOST_CHECK(eb->flat());
+
+    const auto* ebRef = EB::get(reference.data());
+    const auto &md = eb->getMetadata(slot), &mdRef = ebRef->getMetadata(slot);
+    BOOST_CHECK_EQUAL(md.messageLength, mdRef.messageLength);
+    BOOST_CHECK_EQUAL(md.nDictWords, mdRef.nDictWords);
+    BOOST_CHECK_EQUAL(md.nDataWords, mdRef.nDataWords);
+    BOOST_CHECK_EQUAL(md.nLiteralWords, mdRef.nLiteralWords);
+    const auto &block = eb->getBlock(slot), &blockRef = ebRef->getBlock(slot);
+    BOOST_REQUIRE_EQUAL(block.getNStored(), blockRef.getNStored());
+    BOOST_CHECK(std::equal(block.payload, block.payload + block.getNStored(), blockRef.payload));
+  }
+  checkDecoded(buffer, payload);
+}
+
+// encode src alone with the given option, return the metadata of the block and its decoded content
+template <typename T>
+Metadata encodeSingle(const std::vector<T>& src, OptStore opt, std::vector<T>& decoded)
+{
+  using EB1 = EncodedBlocks<CTFDictHeader, 1>;
+  std::vector<BufferType> buffer;
+  EB1::create(buffer);
+  EB1::get(buffer.data())->encode(src, 0, 0, opt, &buffer);
+  EB1::get(buffer.data())->decode(decoded, 0);
+  return EB1::get(buffer.data())->getMetadata(0);
+}
+
+BOOST_AUTO_TEST_CASE(EncodedBlocksAuto_test)
+{
+  std::mt19937 generator(1);
+  std::binomial_distribution<int> binomial(1000, 0.3);
+  std::vector<uint16_t> compressible(100000), decodedCompressible;
+  for (auto& v : compressible) {
+    v = binomial(generator);
+  }
+  std::vector<uint32_t> sparse(3000), decodedSparse;
+  for (auto& v : sparse) {
+    v = generator() % (1u << 16);
+  }
+  const std::vector<uint8_t> tiny{1, 2, 3};
+  std::vector<uint8_t> decodedTiny;
+
+  // the compressible data is entropy coded, with fewer probability bits than the maximum and smaller than stored as is
+  const auto mdCompressible = encodeSingle(compressible, OptStore::AUTO, decodedCompressible);
+  BOOST_CHECK(mdCompressible.opt == OptStore::EENCODE);
+  BOOST_CHECK_LT(int(mdCompressible.probabilityBits), int(o2::rans::MaxRenormThreshold));
+  BOOST_CHECK(decodedCompressible == compressible);
+  BOOST_CHECK_LT(mdCompressible.getCompressedSize(), encodeSingle(compressible, OptStore::NONE, decodedCompressible).getCompressedSize());
+
+  // the dictionary alone of the sparse data is larger than the data, which is then stored as is
+  const auto mdSparse = encodeSingle(sparse, OptStore::AUTO, decodedSparse);
+  BOOST_CHECK(mdSparse.opt == OptStore::NONE);
+  BOOST_CHECK(decodedSparse == sparse);
+  BOOST_CHECK_LT(mdSparse.getCompressedSize(), encodeSingle(sparse, OptStore::EENCODE, decodedSparse).getCompressedSize());
+
+  const auto mdTiny = encodeSingle(tiny, OptStore::AUTO, decodedTiny);
+  BOOST_CHECK(mdTiny.opt == OptStore::NONE);
+  BOOST_CHECK(decodedTiny == tiny);
+}
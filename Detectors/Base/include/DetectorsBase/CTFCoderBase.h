@@ -17,6 +17,9 @@
 #define _ALICEO2_CTFCODER_BASE_H_
 
 #include <memory>
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <TFile.h>
 #include <TTree.h>
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -25,6 +28,7 @@
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "rANS/rans.h"
 #include <filesystem>
@@ -103,6 +107,9 @@ class CTFCoderBase
   void setMemMarginFactor(float v) { mMemMarginFactor = v > 1.f ? v : 1.f; }
   float getMemMarginFactor() const { return mMemMarginFactor; }
 
+  void setNThreads(int n) { mNThreads = n > 1 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   void setVerbosity(int v) { mVerbosity = v; }
   int getVerbosity() const { return mVerbosity; }
 
@@ -123,6 +130,57 @@ class CTFCoderBase
 
   void updateTimeDependentParams(o2::framework::ProcessingContext& pc, bool askTree = false);
 
+  /// call f(i) for i in [0, n) on the calling thread and the mNThreads - 1 workers of the coder, indices are picked dynamically
+  void runConcurrently(int n, const std::function<void(int)>& f) const;
+
+  /// Collects the entropy encoding of the CTF blocks. With a single thread every block is encoded immediately to the output
+  /// buffer, otherwise the blocks are encoded concurrently to standalone buffers by run() and then appended in slot order.
+  template <typename CTF, typename BUF>
+  class ConcurrentEncoder
+  {
+   public:
+    ConcurrentEncoder(const CTFCoderBase& coder, BUF& buffer) : mCoder(coder), mBuffer(buffer), mTasks(CTF::getNBlocks()) {}
+
+    template <typename input_IT>
+    void add(input_IT srcBegin, input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt);
+
+    /// version taking ownership of a temporary source vector
+    template <typename T>
+    void add(std::vector<T>&& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt);
+
+    /// encode pending blocks, return IO size of all blocks
+    o2::ctf::CTFIOSize run();
+
+   private:
+    struct Task {
+      size_t size = 0; // used to start with largest blocks
+      std::function<o2::ctf::CTFIOSize(std::vector<BufferType>&)> encode;
+    };
+    const CTFCoderBase& mCoder;
+    BUF& mBuffer;
+    std::vector<Task> mTasks;
+    o2::ctf::CTFIOSize mIOSize;
+  };
+
+  /// Collects the decoding of the CTF blocks to execute them concurrently by run(), see ConcurrentEncoder
+  class ConcurrentDecoder
+  {
+   public:
+    ConcurrentDecoder(const CTFCoderBase& coder) : mCoder(coder) {}
+
+    /// dest is either a container or an iterator, a container must stay alive until run() is called
+    template <typename EC, typename D>
+    void add(const EC& ec, D&& dest, int slot);
+
+    /// decode pending blocks, return IO size of all blocks
+    o2::ctf::CTFIOSize run();
+
+   private:
+    const CTFCoderBase& mCoder;
+    std::vector<std::function<o2::ctf::CTFIOSize()>> mTasks;
+    o2::ctf::CTFIOSize mIOSize;
+  };
+
   o2::utils::IRFrameSelector& getIRFramesSelector() { return mIRFrameSelector; }
   size_t getIRFrameSelMarginBwd() const { return mIRFrameSelMarginBwd; }
   size_t getIRFrameSelMarginFwd() const { return mIRFrameSelMarginFwd; }
@@ -163,6 +221,11 @@ class CTFCoderBase
   size_t mIRFrameSelMarginFwd = 0; // margin in BC to add to the IRFrame upper boundary when selection is requested
   long mIRFrameSelShift = 0;       // Global shift of the IRFrames, to account for e.g. detector latency
   int mVerbosity = 0;
+  int mNThreads = 1; // number of threads for concurrent encoding/decoding of blocks
+
+ private:
+  class WorkerPool;
+  mutable std::shared_ptr<WorkerPool> mWorkerPool; // worker threads of runConcurrently, kept for the lifetime of the coder
 };
 
 ///________________________________
@@ -180,6 +243,77 @@ bool CTFCoderBase::readFromTree(TTree& tree, const std::string brname, T& dest,
   return false;
 }
 
+///________________________________
+template <typename CTF, typename BUF>
+template <typename input_IT>
+void CTFCoderBase::ConcurrentEncoder<CTF, BUF>::add(input_IT srcBegin, input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt)
+{
+  const void* encoder = mCoder.mCoders[slot].get();
+  const float memfc = mCoder.getMemMarginFactor();
+  if (mCoder.getNThreads() < 2) {
+    mIOSize += CTF::get(mBuffer.data())->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &mBuffer, encoder, memfc);
+    return;
+  }
+  mTasks[slot] = Task{size_t(std::distance(srcBegin, srcEnd)), [=](std::vector<BufferType>& slotBuffer) {
+                        return CTF::encodeSlot(slotBuffer, srcBegin, srcEnd, symbolTablePrecision, opt, encoder, memfc);
+                      }};
+}
+
+///________________________________
+template <typename CTF, typename BUF>
+template <typename T>
+void CTFCoderBase::ConcurrentEncoder<CTF, BUF>::add(std::vector<T>&& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt)
+{
+  if (mCoder.getNThreads() < 2) {
+    add(src.begin(), src.end(), slot, symbolTablePrecision, opt);
+    return;
+  }
+  auto owned = std::make_shared<std::vector<T>>(std::move(src));
+  add(owned->cbegin(), owned->cend(), slot, symbolTablePrecision, opt);
+  mTasks[slot].encode = [owned, encode = std::move(mTasks[slot].encode)](std::vector<BufferType>& slotBuffer) { return encode(slotBuffer); };
+}
+
+///________________________________
+template <typename CTF, typename BUF>
+o2::ctf::CTFIOSize CTFCoderBase::ConcurrentEncoder<CTF, BUF>::run()
+{
+  if (mCoder.getNThreads() < 2) {
+    return mIOSize;
+  }
+  const int nSlots = mTasks.size();
+  std::vector<int> order(nSlots);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](int a, int b) { return mTasks[a].size > mTasks[b].size; });
+  std::vector<std::vector<BufferType>> slotBuffers(nSlots);
+  std::vector<o2::ctf::CTFIOSize> slotIOSize(nSlots);
+  mCoder.runConcurrently(nSlots, [&](int i) {
+    const int slot = order[i];
+    if (!mTasks[slot].encode) {
+      throw std::runtime_error(fmt::format("no data provided for CTF slot {}", slot));
+    }
+    slotIOSize[slot] = mTasks[slot].encode(slotBuffers[slot]);
+  });
+  for (int slot = 0; slot < nSlots; slot++) {
+    CTF::appendSlot(mBuffer, slot, slotBuffers[slot]);
+    mIOSize += slotIOSize[slot];
+  }
+  return mIOSize;
+}
+
+///________________________________
+template <typename EC, typename D>
+void CTFCoderBase::ConcurrentDecoder::add(const EC& ec, D&& dest, int slot)
+{
+  const void* decoder = mCoder.mCoders[slot].get();
+  if (mCoder.getNThreads() < 2) {
+    mIOSize += ec.decode(dest, slot, decoder);
+  } else if constexpr (detail::is_iterator_v<std::decay_t<D>>) {
+    mTasks.emplace_back([&ec, dest, slot, decoder]() { return ec.decode(dest, slot, decoder); });
+  } else {
+    mTasks.emplace_back([&ec, &dest, slot, decoder]() { return ec.decode(dest, slot, decoder); });
+  }
+}
+
 ///________________________________
 template <typename CTF>
 void CTFCoderBase::createCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op, bool mayFail)
@@ -263,6 +397,9 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (ic.options().hasOption("mem-factor")) {
     setMemMarginFactor(ic.options().get<float>("mem-factor"));
   }
+  if (ic.options().hasOption("ctf-nthreads")) {
+    setNThreads(ic.options().get<int>("ctf-nthreads"));
+  }
   if (ic.options().hasOption("irframe-margin-bwd")) {
     mIRFrameSelMarginBwd = ic.options().get<uint32_t>("irframe-margin-bwd");
   }
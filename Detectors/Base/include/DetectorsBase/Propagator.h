@@ -119,6 +119,17 @@ class PropagatorImpl
                                    gpu::gpustd::array<value_type, 2>* dca = nullptr, track::TrackLTIntegral* tofInfo = nullptr,
                                    int signCorr = 0, value_type maxD = 999.f) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  // Propagate nTracks tracks (e.g. span.data(), span.size()) to the same X in lock-step: every round does one step
+  // for all tracks still on the way, evaluating first their positions and fields, then the propagation, then the
+  // material budgets in separate passes, with the field source and material source dispatched once per pass.
+  // The result for each track is identical to that of PropagateToXBxByBz (or propagateToX with nominal Bz if bzOnly).
+  // status[i] is set to 1 for the successfully propagated tracks, the number of which is returned.
+  template <typename track_T>
+  int propagateTracksToX(track_T* tracks, int nTracks, value_type x, uint8_t* status, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI,
+                         value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT, int signCorr = 0) const;
+#endif
+
   PropagatorImpl(PropagatorImpl const&) = delete;
   PropagatorImpl(PropagatorImpl&&) = delete;
   PropagatorImpl& operator=(PropagatorImpl const&) = delete;
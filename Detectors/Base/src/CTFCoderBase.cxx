@@ -18,6 +18,11 @@
 #include "Framework/ProcessingContext.h"
 #include "Framework/InputRecord.h"
 #include "Framework/TimingInfo.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace o2::ctf;
 using namespace o2::framework;
@@ -95,3 +100,125 @@ void CTFCoderBase::reportIRFrames()
     repDone = true;
   }
 }
+
+/// Persistent worker threads executing one job of runConcurrently at a time together with the calling thread
+class CTFCoderBase::WorkerPool
+{
+ public:
+  explicit WorkerPool(int nWorkers)
+  {
+    for (int i = 0; i < nWorkers; i++) {
+      mWorkers.emplace_back([this]() { work(); });
+    }
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mJobAvailable.notify_all();
+    for (auto& th : mWorkers) {
+      th.join();
+    }
+  }
+
+  int getNWorkers() const { return mWorkers.size(); }
+
+  void run(int n, const std::function<void(int)>& f)
+  {
+    std::lock_guard<std::mutex> runLock(mRunMutex);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mJob = &f;
+      mJobSize = n;
+      mNext = 0;
+      mNBusy = mWorkers.size();
+      mGeneration++;
+    }
+    mJobAvailable.notify_all();
+    process();
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJobDone.wait(lock, [this]() { return mNBusy == 0; });
+    mJob = nullptr;
+    if (mError) {
+      auto err = mError;
+      mError = nullptr;
+      std::rethrow_exception(err);
+    }
+  }
+
+ private:
+  void process()
+  {
+    try {
+      for (int i = mNext++; i < mJobSize; i = mNext++) {
+        (*mJob)(i);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mError) {
+        mError = std::current_exception();
+      }
+    }
+  }
+
+  void work()
+  {
+    uint64_t generation = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobAvailable.wait(lock, [this, generation]() { return mStop || mGeneration != generation; });
+        if (mStop) {
+          return;
+        }
+        generation = mGeneration;
+      }
+      process();
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mNBusy == 0) {
+        mJobDone.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> mWorkers;
+  std::mutex mRunMutex; // one job at a time
+  std::mutex mMutex;    // protects the job description and the counters below
+  std::condition_variable mJobAvailable;
+  std::condition_variable mJobDone;
+  const std::function<void(int)>* mJob = nullptr;
+  int mJobSize = 0;
+  std::atomic<int> mNext{0};
+  int mNBusy = 0;           // workers which did not finish the current job yet
+  uint64_t mGeneration = 0; // incremented for every job
+  bool mStop = false;
+  std::exception_ptr mError;
+};
+
+void CTFCoderBase::runConcurrently(int n, const std::function<void(int)>& f) const
+{
+  if (std::min(mNThreads, n) < 2) {
+    for (int i = 0; i < n; i++) {
+      f(i);
+    }
+    return;
+  }
+  if (!mWorkerPool || mWorkerPool->getNWorkers() != mNThreads - 1) {
+    mWorkerPool = std::make_shared<WorkerPool>(mNThreads - 1);
+  }
+  mWorkerPool->run(n, f);
+}
+
+CTFIOSize CTFCoderBase::ConcurrentDecoder::run()
+{
+  std::vector<CTFIOSize> sizes(mTasks.size());
+  mCoder.runConcurrently(mTasks.size(), [this, &sizes](int i) { sizes[i] = mTasks[i](); });
+  for (const auto& sz : sizes) {
+    mIOSize += sz;
+  }
+  mTasks.clear();
+  return mIOSize;
+}
@@ -31,6 +31,8 @@ using namespace o2::gpu;
 #include "DetectorsBase/GeometryManager.h"
 #include <FairRunAna.h> // eventually will get rid of it
 #include <TGeoGlobalMagField.h>
+#include <type_traits>
+#include <vector>
 
 template <typename value_T>
 PropagatorImpl<value_T>::PropagatorImpl(bool uninitialized)
@@ -732,6 +734,100 @@ GPUd() void PropagatorImpl<value_T>::getFieldXYZ(const math_utils::Point3D<doubl
   getFieldXYZImpl<double>(xyz, bxyz);
 }
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+//_______________________________________________________________________
+template <typename value_T>
+template <typename track_T>
+int PropagatorImpl<value_T>::propagateTracksToX(track_T* tracks, int nTracks, value_type xToGo, uint8_t* status, bool bzOnly, value_type maxSnp,
+                                                value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Propagates the tracks to the plane X=xToGo (cm) in lock-step,
+  // the steps of every track being exactly those of the single track propagation
+  //
+  //----------------------------------------------------------------
+  constexpr bool withCov = std::is_same_v<track_T, TrackParCov_t>;
+  std::vector<int> active(nTracks), dirs(nTracks);
+  std::vector<math_utils::Point3D<value_type>> xyz0(nTracks);
+  std::vector<gpu::gpustd::array<value_type, 3>> fields(bzOnly ? 0 : nTracks);
+  for (int i = 0; i < nTracks; i++) {
+    dirs[i] = xToGo - tracks[i].getX() > 0.f ? 1 : -1;
+    status[i] = 0;
+    active[i] = i;
+  }
+  bool useLUT = matCorr == MatCorrType::USEMatCorrLUT && mMatLUT;
+  int nDone = 0, nActive = nTracks;
+  while (nActive) {
+    int nKeep = 0;
+    for (int ia = 0; ia < nActive; ia++) { // retire the tracks which reached the destination
+      auto i = active[ia];
+      if (math_utils::detail::abs<value_type>(xToGo - tracks[i].getX()) > Epsilon) {
+        active[nKeep++] = i;
+      } else {
+        tracks[i].setX(xToGo);
+        status[i] = 1;
+        nDone++;
+      }
+    }
+    nActive = nKeep;
+    for (int ia = 0; ia < nActive; ia++) {
+      xyz0[ia] = tracks[active[ia]].getXYZGlo();
+    }
+    if (!bzOnly) {
+      for (int ia = 0; ia < nActive; ia++) {
+        getFieldXYZ(xyz0[ia], &fields[ia][0]);
+      }
+    }
+    nKeep = 0;
+    for (int ia = 0; ia < nActive; ia++) {
+      auto i = active[ia];
+      auto& track = tracks[i];
+      auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(xToGo - track.getX()), maxStep);
+      if (dirs[i] < 0) {
+        step = -step;
+      }
+      auto x = track.getX() + step;
+      bool ok;
+      if constexpr (withCov) {
+        ok = bzOnly ? track.propagateTo(x, mBz) : track.propagateTo(x, fields[ia]);
+      } else {
+        ok = bzOnly ? track.propagateParamTo(x, mBz) : track.propagateParamTo(x, fields[ia]);
+      }
+      if (!ok || (maxSnp > 0 && math_utils::detail::abs<value_type>(track.getSnp()) >= maxSnp)) {
+        continue;
+      }
+      xyz0[nKeep] = xyz0[ia];
+      active[nKeep++] = i;
+    }
+    nActive = nKeep;
+    if (matCorr == MatCorrType::USEMatCorrNONE) {
+      continue;
+    }
+    nKeep = 0;
+    for (int ia = 0; ia < nActive; ia++) {
+      auto i = active[ia];
+      auto& track = tracks[i];
+      auto xyz1 = track.getXYZGlo();
+      auto mb = useLUT ? mMatLUT->getMatBudget(xyz0[ia].X(), xyz0[ia].Y(), xyz0[ia].Z(), xyz1.X(), xyz1.Y(), xyz1.Z()) : getMatBudget(matCorr, xyz0[ia], xyz1);
+      int sign = signCorr ? signCorr : -dirs[i]; // sign of eloss correction is not imposed
+      bool ok;
+      if constexpr (withCov) {
+        ok = track.correctForMaterial(mb.meanX2X0, mb.getXRho(sign));
+      } else {
+        ok = track.correctForELoss(((sign < 0) ? -mb.length : mb.length) * mb.meanRho);
+      }
+      if (ok) {
+        active[nKeep++] = i;
+      }
+    }
+    nActive = nKeep;
+  }
+  return nDone;
+}
+#endif
+
+//_______________________________________________________________________
 namespace o2::base
 {
 template class PropagatorImpl<float>;
@@ -746,4 +842,10 @@ template bool PropagatorImpl<double>::propagateToAlphaX<PropagatorImpl<double>::
 template bool PropagatorImpl<double>::propagateToAlphaX<PropagatorImpl<double>::TrackParCov_t>(PropagatorImpl<double>::TrackParCov_t&, double, double, bool, double, double, int, PropagatorImpl<double>::MatCorrType matCorr, track::TrackLTIntegral*, int) const;
 #endif
 #endif
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+template int PropagatorImpl<float>::propagateTracksToX<PropagatorImpl<float>::TrackPar_t>(PropagatorImpl<float>::TrackPar_t*, int, float, uint8_t*, bool, float, float, PropagatorImpl<float>::MatCorrType, int) const;
+template int PropagatorImpl<float>::propagateTracksToX<PropagatorImpl<float>::TrackParCov_t>(PropagatorImpl<float>::TrackParCov_t*, int, float, uint8_t*, bool, float, float, PropagatorImpl<float>::MatCorrType, int) const;
+template int PropagatorImpl<double>::propagateTracksToX<PropagatorImpl<double>::TrackPar_t>(PropagatorImpl<double>::TrackPar_t*, int, double, uint8_t*, bool, double, double, PropagatorImpl<double>::MatCorrType, int) const;
+template int PropagatorImpl<double>::propagateTracksToX<PropagatorImpl<double>::TrackParCov_t>(PropagatorImpl<double>::TrackParCov_t*, int, double, uint8_t*, bool, double, double, PropagatorImpl<double>::MatCorrType, int) const;
+#endif
 } // namespace o2::base
@@ -0,0 +1,139 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PropagatorBatch
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TGeoManager.h>
+#include <TGeoGlobalMagField.h>
+#include <TRandom.h>
+#include <TString.h>
+#include <array>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "Field/MagneticField.h"
+#include "ReconstructionDataFormats/Track.h"
+
+namespace o2
+{
+namespace base
+{
+
+using MatCorrType = Propagator::MatCorrType;
+constexpr float Tolerance = 1e-5;
+
+bool isClose(float a, float b)
+{
+  return std::abs(a - b) <= Tolerance * std::max(std::abs(a), std::abs(b)) + 1e-12f;
+}
+
+// field map and a few silicon shells in vacuum, enough to make the material corrections matter
+void setup()
+{
+  if (!TGeoGlobalMagField::Instance()->GetField()) {
+    auto fld = new o2::field::MagneticField("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+    TGeoGlobalMagField::Instance()->SetField(fld);
+    TGeoGlobalMagField::Instance()->Lock();
+  }
+  if (!gGeoManager) {
+    auto geom = new TGeoManager("propagatorBatch", "propagator batch test geometry");
+    auto vacuum = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+    auto silicon = new TGeoMedium("Si", 2, new TGeoMaterial("Si", 28.09, 14, 2.33));
+    auto top = geom->MakeBox("TOP", vacuum, 300, 300, 300);
+    geom->SetTopVolume(top);
+    for (int i = 0; i < 5; i++) {
+      float r = 10.f + 15.f * i;
+      top->AddNode(geom->MakeTube(Form("SHELL%d", i), silicon, r, r + 0.5, 150), 1);
+    }
+    geom->CloseGeometry();
+  }
+  Propagator::Instance();
+}
+
+template <typename track_T>
+std::vector<track_T> generateTracks(int nTracks)
+{
+  std::vector<track_T> tracks;
+  gRandom->SetSeed(1234);
+  for (int i = 0; i < nTracks; i++) {
+    float alpha = gRandom->Uniform(-M_PI, M_PI), q2pt = gRandom->Uniform(0.2, 5.) * (gRandom->Rndm() > 0.5 ? 1 : -1);
+    std::array<float, o2::track::kNParams> par{gRandom->Uniform(-1, 1), gRandom->Uniform(-5, 5), gRandom->Uniform(-0.3, 0.3), gRandom->Uniform(-0.8, 0.8), q2pt};
+    if constexpr (std::is_same_v<track_T, o2::track::TrackParCov>) {
+      std::array<float, o2::track::kCovMatSize> cov{1e-4, 0, 1e-4, 0, 0, 1e-4, 0, 0, 0, 1e-4, 0, 0, 0, 0, 1e-2};
+      tracks.emplace_back(2.f, alpha, par, cov);
+    } else {
+      tracks.emplace_back(2.f, alpha, par);
+    }
+  }
+  return tracks;
+}
+
+template <typename track_T>
+void compareBatchWithSingle(float x, bool bzOnly, MatCorrType matCorr)
+{
+  const int nTracks = 200;
+  auto prop = Propagator::Instance();
+  auto batch = generateTracks<track_T>(nTracks), single = batch;
+  std::vector<uint8_t> status(nTracks);
+  int nOK = prop->propagateTracksToX(batch.data(), nTracks, x, status.data(), bzOnly, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr);
+  int nOKSingle = 0;
+  for (int i = 0; i < nTracks; i++) {
+    bool ok = prop->propagateTo(single[i], x, bzOnly, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr);
+    nOKSingle += ok;
+    BOOST_CHECK_EQUAL(bool(status[i]), ok);
+    if (!ok) {
+      continue;
+    }
+    BOOST_CHECK(isClose(batch[i].getX(), single[i].getX()));
+    for (int ip = 0; ip < o2::track::kNParams; ip++) {
+      BOOST_CHECK(isClose(batch[i].getParam(ip), single[i].getParam(ip)));
+    }
+    if constexpr (std::is_same_v<track_T, o2::track::TrackParCov>) {
+      for (int ic = 0; ic < o2::track::kCovMatSize; ic++) {
+        BOOST_CHECK(isClose(batch[i].getCov()[ic], single[i].getCov()[ic]));
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(nOK, nOKSingle);
+  BOOST_CHECK(nOK > 0);
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatch_test)
+{
+  setup();
+  for (auto matCorr : {MatCorrType::USEMatCorrNONE, MatCorrType::USEMatCorrTGeo}) {
+    for (bool bzOnly : {false, true}) {
+      compareBatchWithSingle<o2::track::TrackPar>(80.f, bzOnly, matCorr);
+      compareBatchWithSingle<o2::track::TrackParCov>(80.f, bzOnly, matCorr);
+      compareBatchWithSingle<o2::track::TrackParCov>(1.f, bzOnly, matCorr); // inward
+    }
+  }
+
+  // material from the LUT rather than from the geometry
+  MatLayerCylSet lut;
+  lut.addLayer(5., 80., 150., 5., 5.);
+  lut.populateFromTGeo(2);
+  lut.optimizePhiSlices();
+  lut.flatten();
+  Propagator::Instance()->setMatLUT(&lut);
+  for (bool bzOnly : {false, true}) {
+    compareBatchWithSingle<o2::track::TrackPar>(80.f, bzOnly, MatCorrType::USEMatCorrLUT);
+    compareBatchWithSingle<o2::track::TrackParCov>(80.f, bzOnly, MatCorrType::USEMatCorrLUT);
+  }
+  Propagator::Instance()->setMatLUT(nullptr);
+}
+
+} // namespace base
+} // namespace o2
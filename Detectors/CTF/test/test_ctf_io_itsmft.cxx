@@ -23,10 +23,28 @@
 #include <TFile.h>
 #include <TRandom.h>
 #include <TStopwatch.h>
+#include <algorithm>
 #include <cstring>
 
 using namespace o2::itsmft;
 
+// CTFs encoded with one and several threads must have the same blocks, their buffers may differ by the allocation margins
+void checkSameCTF(const CTF::base& ctf, const CTF::base& ctfRef)
+{
+  for (int slot = 0; slot < CTF::getNBlocks(); slot++) {
+    const auto &md = ctf.getMetadata(slot), &mdRef = ctfRef.getMetadata(slot);
+    BOOST_CHECK_EQUAL(md.messageLength, mdRef.messageLength);
+    BOOST_CHECK_EQUAL(md.nLiterals, mdRef.nLiterals);
+    BOOST_CHECK(md.opt == mdRef.opt);
+    BOOST_CHECK_EQUAL(md.nDictWords, mdRef.nDictWords);
+    BOOST_CHECK_EQUAL(md.nDataWords, mdRef.nDataWords);
+    BOOST_CHECK_EQUAL(md.nLiteralWords, mdRef.nLiteralWords);
+    const auto &block = ctf.getBlock(slot), &blockRef = ctfRef.getBlock(slot);
+    BOOST_REQUIRE_EQUAL(block.getNStored(), blockRef.getNStored());
+    BOOST_CHECK(std::equal(block.payload, block.payload + block.getNStored(), blockRef.payload));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(CompressedClustersTest)
 {
 
@@ -78,6 +96,15 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
   sw.Stop();
   LOG(info) << "Compressed in " << sw.CpuTime() << " s";
 
+  // the same with the blocks encoded concurrently
+  {
+    std::vector<o2::ctf::BufferType> vecMT;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder, o2::detectors::DetID::ITS);
+    coder.setNThreads(4);
+    coder.encode(vecMT, rofRecVec, cclusVec, pattVec, pattIdConverter, 0);
+    checkSameCTF(*o2::itsmft::CTF::get(vecMT.data()), *o2::itsmft::CTF::get(vec.data()));
+  }
+
   // writing
   {
     sw.Start();
@@ -116,6 +143,30 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
   sw.Stop();
   LOG(info) << "Decompressed in " << sw.CpuTime() << " s";
 
+  // the same with the blocks decoded concurrently
+  {
+    std::vector<ROFRecord> rofRecVecMT;
+    std::vector<CompClusterExt> cclusVecMT;
+    std::vector<unsigned char> pattVecMT;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder, o2::detectors::DetID::ITS);
+    coder.setNThreads(4);
+    coder.decode(ctfImage, rofRecVecMT, cclusVecMT, pattVecMT, nullptr, clPattLookup);
+    BOOST_REQUIRE_EQUAL(rofRecVecMT.size(), rofRecVecD.size());
+    for (size_t i = 0; i < rofRecVecD.size(); i++) {
+      BOOST_CHECK(rofRecVecMT[i].getBCData() == rofRecVecD[i].getBCData());
+      BOOST_CHECK_EQUAL(rofRecVecMT[i].getFirstEntry(), rofRecVecD[i].getFirstEntry());
+      BOOST_CHECK_EQUAL(rofRecVecMT[i].getNEntries(), rofRecVecD[i].getNEntries());
+    }
+    BOOST_REQUIRE_EQUAL(cclusVecMT.size(), cclusVecD.size());
+    for (size_t i = 0; i < cclusVecD.size(); i++) {
+      BOOST_CHECK_EQUAL(cclusVecMT[i].getChipID(), cclusVecD[i].getChipID());
+      BOOST_CHECK_EQUAL(cclusVecMT[i].getRow(), cclusVecD[i].getRow());
+      BOOST_CHECK_EQUAL(cclusVecMT[i].getCol(), cclusVecD[i].getCol());
+      BOOST_CHECK_EQUAL(cclusVecMT[i].getPatternID(), cclusVecD[i].getPatternID());
+    }
+    BOOST_CHECK(pattVecMT == pattVecD);
+  }
+
   //
   // check
   BOOST_CHECK(rofRecVecD.size() == rofRecVec.size());
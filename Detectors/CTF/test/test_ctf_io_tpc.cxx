@@ -21,10 +21,28 @@
 #include <TFile.h>
 #include <TRandom.h>
 #include <TStopwatch.h>
+#include <algorithm>
 #include <cstring>
 
 using namespace o2::tpc;
 
+// CTFs encoded with one and several threads must have the same blocks, their buffers may differ by the allocation margins
+void checkSameCTF(const CTF::base& ctf, const CTF::base& ctfRef)
+{
+  for (int slot = 0; slot < CTF::getNBlocks(); slot++) {
+    const auto &md = ctf.getMetadata(slot), &mdRef = ctfRef.getMetadata(slot);
+    BOOST_CHECK_EQUAL(md.messageLength, mdRef.messageLength);
+    BOOST_CHECK_EQUAL(md.nLiterals, mdRef.nLiterals);
+    BOOST_CHECK(md.opt == mdRef.opt);
+    BOOST_CHECK_EQUAL(md.nDictWords, mdRef.nDictWords);
+    BOOST_CHECK_EQUAL(md.nDataWords, mdRef.nDataWords);
+    BOOST_CHECK_EQUAL(md.nLiteralWords, mdRef.nLiteralWords);
+    const auto &block = ctf.getBlock(slot), &blockRef = ctfRef.getBlock(slot);
+    BOOST_REQUIRE_EQUAL(block.getNStored(), blockRef.getNStored());
+    BOOST_CHECK(std::equal(block.payload, block.payload + block.getNStored(), blockRef.payload));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(CTFTest)
 {
   CompressedClusters c;
@@ -93,6 +111,16 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   sw.Stop();
   LOG(info) << "Compressed in " << sw.CpuTime() << " s";
 
+  // the same with the blocks encoded concurrently
+  {
+    std::vector<o2::ctf::BufferType> vecMT;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.setCombineColumns(true);
+    coder.setNThreads(4);
+    coder.encode(vecMT, c, c);
+    checkSameCTF(*o2::tpc::CTF::get(vecMT.data()), *o2::tpc::CTF::get(vecIO.data()));
+  }
+
   // writing
   {
     sw.Start();
@@ -128,6 +156,17 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   }
   sw.Stop();
   LOG(info) << "Decompressed in " << sw.CpuTime() << " s";
+
+  // the same with the blocks decoded concurrently
+  {
+    std::vector<char> vecInMT;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+    coder.setCombineColumns(true);
+    coder.setNThreads(4);
+    coder.decode(ctfImage, vecInMT);
+    BOOST_REQUIRE_EQUAL(vecInMT.size(), vecIn.size());
+    BOOST_CHECK(memcmp(vecInMT.data(), vecIn.data(), vecIn.size()) == 0);
+  }
   //
   // compare with original flat clusters
   BOOST_CHECK(vecIn.size() == bVec.size());
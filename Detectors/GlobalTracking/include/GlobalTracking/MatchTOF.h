@@ -201,6 +201,10 @@ class MatchTOF
 
   void storeMatchable(bool val = true) { mStoreMatchable = val; }
 
+  ///< set the number of threads matching the sectors concurrently
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
  private:
   bool prepareFITData();
   int prepareInteractionTimes();
@@ -266,6 +270,7 @@ class MatchTOF
   bool mIsITSTPCTRDused = false;
   bool mSetHighPurity = false;
   bool mStoreMatchable = false;
+  int mNThreads = 1; ///< number of OMP threads for the per-sector matching
 
   unsigned long mTimestamp = 0; ///< in ms
 
@@ -311,6 +316,8 @@ class MatchTOF
   ///<array of track-TOFCluster pairs from the matching
   std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairs;
   std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairsSec[o2::constants::math::NSectors];
+  ///<pairs found per track type and sector, filled concurrently and merged in the sector order
+  std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairsWork[trkType::SIZE][o2::constants::math::NSectors];
 
   ///<array of TOFChannel calibration info
   std::vector<o2::dataformats::CalibInfoTOF> mCalibInfoTOF;
@@ -46,6 +46,10 @@
 #include "DataFormatsGlobalTracking/RecoContainerCreateTracksVariadic.h"
 #include "TOFBase/Utils.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::globaltracking;
 using evGIdx = o2::dataformats::EvIndex<int, o2::dataformats::GlobalTrackID>;
 using trkType = o2::dataformats::MatchInfoTOFReco::TrackType;
@@ -122,19 +126,46 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
 
   mTimerTot.Start();
   std::array<uint32_t, 18> nMatches = {0};
-  for (int sec = o2::constants::math::NSectors; sec--;) {
-    mMatchedTracksPairs.clear(); // new sector
-    LOG(debug) << "Doing matching for sector " << sec << "...";
-    if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
-      mTimerMatchITSTPC.Start(sec == o2::constants::math::NSectors - 1);
-      doMatching(sec);
-      mTimerMatchITSTPC.Stop();
+  // the sectors and track types are independent until the selection of the best matches: match them concurrently
+  for (int it = 0; it < trkType::SIZE; it++) {
+    for (int sec = o2::constants::math::NSectors; sec--;) {
+      mMatchedTracksPairsWork[it][sec].clear();
     }
-    if (mIsTPCused) {
-      mTimerMatchTPC.Start(sec == o2::constants::math::NSectors - 1);
+  }
+  Geo::Init(); // the lazy initialization on first use is not thread safe
+  bool doConstr = mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int itask = 0; itask < trkType::SIZE * o2::constants::math::NSectors; itask++) {
+    int sec = o2::constants::math::NSectors - 1 - itask / trkType::SIZE; // start from the last sector as the sequential loop used to
+    if (itask % trkType::SIZE == trkType::CONSTR) {
+      if (doConstr) {
+        LOG(debug) << "Doing matching of constrained tracks for sector " << sec << "...";
+        if (mNThreads == 1) {
+          mTimerMatchITSTPC.Start(false);
+        }
+        doMatching(sec);
+        if (mNThreads == 1) {
+          mTimerMatchITSTPC.Stop();
+        }
+      }
+    } else if (mIsTPCused) {
+      LOG(debug) << "Doing matching of TPC tracks for sector " << sec << "...";
+      if (mNThreads == 1) {
+        mTimerMatchTPC.Start(false);
+      }
       doMatchingForTPC(sec);
-      mTimerMatchTPC.Stop();
+      if (mNThreads == 1) {
+        mTimerMatchTPC.Stop();
+      }
     }
+  }
+
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    mMatchedTracksPairs.clear(); // new sector
+    mMatchedTracksPairs.insert(mMatchedTracksPairs.end(), mMatchedTracksPairsWork[trkType::CONSTR][sec].begin(), mMatchedTracksPairsWork[trkType::CONSTR][sec].end());
+    mMatchedTracksPairs.insert(mMatchedTracksPairs.end(), mMatchedTracksPairsWork[trkType::UNCONS][sec].begin(), mMatchedTracksPairsWork[trkType::UNCONS][sec].end());
 
     if (mStoreMatchable) {
       // fill per sector
@@ -185,6 +216,17 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
   LOGF(info, "Timing Do Matching TPC        : Cpu: %.3e s Real: %.3e s in %d slots", mTimerMatchTPC.CpuTime(), mTimerMatchTPC.RealTime(), mTimerMatchTPC.Counter() - 1);
 }
 
+//______________________________________________
+void MatchTOF::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(warning) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+
 //______________________________________________
 void MatchTOF::setTPCVDrift(const o2::tpc::VDriftCorrFact& v)
 {
@@ -845,7 +887,7 @@ void MatchTOF::doMatching(int sec)
           foundCluster = true;
           // set event indexes (to be checked)
           int eventIndexTOFCluster = mTOFClusSectIndexCache[indices[0]][itof];
-          mMatchedTracksPairs.emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], mTrackGid[type][cacheTrk[itrk]], type, (trefTOF.getTime() - (minTrkTime + maxTrkTime - 100E3) * 0.5) * 1E-6, 0., resX, resZ); // subracting 100 ns to max track which was artificially added
+          mMatchedTracksPairsWork[type][sec].emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], mTrackGid[type][cacheTrk[itrk]], type, (trefTOF.getTime() - (minTrkTime + maxTrkTime - 100E3) * 0.5) * 1E-6, 0., resX, resZ); // subracting 100 ns to max track which was artificially added
         }
       }
     }
@@ -1174,7 +1216,7 @@ void MatchTOF::doMatchingForTPC(int sec)
             foundCluster = true;
             // set event indexes (to be checked)
             int eventIndexTOFCluster = mTOFClusSectIndexCache[indices[0]][itof];
-            mMatchedTracksPairs.emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], mTrackGid[trkType::UNCONS][cacheTrk[itrk]], trkType::UNCONS, resZ / mTPCVDrift * side, trefTOF.getZ(), resX, resZ); // TODO: check if this is correct!
+            mMatchedTracksPairsWork[trkType::UNCONS][sec].emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], mTrackGid[trkType::UNCONS][cacheTrk[itrk]], trkType::UNCONS, resZ / mTPCVDrift * side, trefTOF.getZ(), resX, resZ); // TODO: check if this is correct!
           }
         }
       }
@@ -91,6 +91,7 @@ void TOFMatcherSpec::init(InitContext& ic)
   }
   mTPCCorrMapsLoader.init(ic);
   mMatcher.storeMatchable(mPushMatchable);
+  mMatcher.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
   mMatcher.setExtraTimeToleranceTRD(mExtraTolTRD);
 }
 
@@ -261,6 +262,7 @@ DataProcessorSpec getTOFMatcherSpec(GID::mask_t src, bool useMC, bool useFIT, bo
                                                               true);
   o2::tpc::VDriftHelper::requestCCDBInputs(dataRequest->inputs);
   o2::tpc::CorrectionMapsLoader::requestCCDBInputs(dataRequest->inputs, opts, src[GID::CTP]);
+  opts.push_back(ConfigParamSpec{"nthreads", VariantType::Int, 1, {"Number of threads matching the TOF sectors concurrently"}});
   std::vector<OutputSpec> outputs;
   if (GID::includesSource(GID::TPC, src)) {
     outputs.emplace_back(o2::header::gDataOriginTOF, "MTC_TPC", ss, Lifetime::Timeframe);
@@ -115,6 +115,9 @@ struct VertexingParameters {
   int phiSpan = -1;
   int zSpan = -1;
 
+  bool useHistogramSeeding = false; // seed the vertices from the peaks of the histogram of the line z at the beam axis
+  float histZBinWidth = 0.05f;      // bin width of this histogram
+
   int nThreads = 1;
 };
 
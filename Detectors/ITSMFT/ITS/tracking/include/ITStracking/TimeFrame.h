@@ -152,7 +152,9 @@ class TimeFrame
   int getClusterROF(int iLayer, int iCluster);
   std::vector<std::vector<Cell>>& getCells();
   std::vector<std::vector<int>>& getCellsLookupTable();
-  std::vector<std::vector<std::vector<int>>>& getCellsNeighbours();
+  std::vector<std::vector<int>>& getCellsNeighbours();
+  std::vector<std::vector<int>>& getCellsNeighboursLUT();
+  gsl::span<const int> getCellNeighbours(int layer, int cell) const;
   std::vector<Road<5>>& getRoads();
   std::vector<TrackITSExt>& getTracks(int rof) { return mTracks[rof]; }
   std::vector<MCCompLabel>& getTracksLabel(const int rof) { return mTracksLabel[rof]; }
@@ -248,7 +250,8 @@ class TimeFrame
   std::vector<std::vector<MCCompLabel>> mCellLabels;
   std::vector<std::vector<Cell>> mCells;
   std::vector<std::vector<int>> mCellsLookupTable;
-  std::vector<std::vector<std::vector<int>>> mCellsNeighbours;
+  std::vector<std::vector<int>> mCellsNeighbours;    /// neighbours of the cells of layer + 1, in the cells of layer
+  std::vector<std::vector<int>> mCellsNeighboursLUT; /// first neighbour of each cell of layer + 1 in mCellsNeighbours
   std::vector<Road<5>> mRoads;
   std::vector<std::vector<MCCompLabel>> mTracksLabel;
   std::vector<std::vector<TrackITSExt>> mTracks;
@@ -535,11 +538,25 @@ inline std::vector<std::vector<int>>& TimeFrame::getCellsLookupTable()
   return mCellsLookupTable;
 }
 
-inline std::vector<std::vector<std::vector<int>>>& TimeFrame::getCellsNeighbours()
+inline std::vector<std::vector<int>>& TimeFrame::getCellsNeighbours()
 {
   return mCellsNeighbours;
 }
 
+inline std::vector<std::vector<int>>& TimeFrame::getCellsNeighboursLUT()
+{
+  return mCellsNeighboursLUT;
+}
+
+inline gsl::span<const int> TimeFrame::getCellNeighbours(int layer, int cell) const
+{
+  if (layer < 0 || cell + 1 >= (int)mCellsNeighboursLUT[layer].size()) {
+    return gsl::span<const int>();
+  }
+  const int startIdx{mCellsNeighboursLUT[layer][cell]};
+  return {mCellsNeighbours[layer].data() + startIdx, static_cast<gsl::span<const int>::size_type>(mCellsNeighboursLUT[layer][cell + 1] - startIdx)};
+}
+
 inline std::vector<Road<5>>& TimeFrame::getRoads() { return mRoads; }
 
 inline gsl::span<Tracklet> TimeFrame::getFoundTracklets(int rofId, int combId)
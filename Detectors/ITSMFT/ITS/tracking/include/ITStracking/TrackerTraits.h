@@ -96,7 +96,7 @@ class TrackerTraits
   float mBz = 5.f;
 
  private:
-  void traverseCellsTree(const int, const int);
+  void traverseCellsTree(const int, const int, std::vector<Road<5>>&);
   track::TrackParCov buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster3, const TrackingFrameInfo& tf3);
   bool fitTrack(TrackITSExt& track, int start, int end, int step, const float chi2clcut = o2::constants::math::VeryBig, const float chi2ndfcut = o2::constants::math::VeryBig, const float maxQoverPt = o2::constants::math::VeryBig);
 
@@ -45,6 +45,10 @@ struct VertexerParamConfig : public o2::conf::ConfigurableParamHelper<VertexerPa
   int ZBins = 1;
   int PhiBins = 128;
 
+  // Seeding from the histogram of the line z at the beam axis, linear in the number of lines
+  bool useHistogramSeeding = false;
+  float histZBinWidth = 0.05f;
+
   int nThreads = 1;
 
   O2ParamDef(VertexerParamConfig, "ITSVertexerParam");
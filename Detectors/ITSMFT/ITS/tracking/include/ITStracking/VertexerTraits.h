@@ -93,6 +93,8 @@ class VertexerTraits
   int getNThreads() const { return mNThreads; }
 
  protected:
+  void seedClustersFromHistogram(const int rofId, std::vector<bool>& usedLines);
+
   unsigned char mIsGPU;
   int mNThreads = 1;
 
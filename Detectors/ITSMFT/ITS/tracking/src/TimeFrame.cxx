@@ -243,9 +243,16 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     if (maxLayers < trkParam.NLayers) {
       resetRofPV();
     }
-    mTracks.clear();
-    mTracksLabel.clear();
-    mLinesLabels.clear();
+    /// The per-ROF containers are cleared rather than destroyed, to reuse their memory in the next TF
+    for (auto& tracks : mTracks) {
+      tracks.clear();
+    }
+    for (auto& labels : mTracksLabel) {
+      labels.clear();
+    }
+    for (auto& labels : mLinesLabels) {
+      labels.clear();
+    }
     mVerticesLabels.clear();
     mTracks.resize(mNrof);
     mTracksLabel.resize(mNrof);
@@ -253,6 +260,7 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
     mCellsNeighbours.resize(trkParam.CellsPerRoad() - 1);
+    mCellsNeighboursLUT.resize(trkParam.CellsPerRoad() - 1);
     mCellLabels.resize(trkParam.CellsPerRoad());
     mTracklets.resize(std::min(trkParam.TrackletsPerRoad(), maxLayers - 1));
     mTrackletLabels.resize(trkParam.TrackletsPerRoad());
@@ -260,8 +268,12 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     mIndexTableUtils.setTrackingParameters(trkParam);
     mPositionResolution.resize(trkParam.NLayers);
     mBogusClusters.resize(trkParam.NLayers, 0);
-    mLines.clear();
-    mTrackletClusters.clear();
+    for (auto& lines : mLines) {
+      lines.clear();
+    }
+    for (auto& clusters : mTrackletClusters) {
+      clusters.clear();
+    }
     for (unsigned int iLayer{0}; iLayer < std::min((int)mClusters.size(), maxLayers); ++iLayer) {
       mClusters[iLayer].clear();
       mClusters[iLayer].resize(mUnsortedClusters[iLayer].size());
@@ -269,8 +281,10 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
       mUsedClusters[iLayer].resize(mUnsortedClusters[iLayer].size(), false);
       mPositionResolution[iLayer] = std::sqrt(0.5 * (trkParam.SystErrorZ2[iLayer] + trkParam.SystErrorY2[iLayer]) + trkParam.LayerResolution[iLayer] * trkParam.LayerResolution[iLayer]);
     }
-    mIndexTables.clear();
-    mIndexTables.resize(mClusters.size(), std::vector<int>(mNrof * (trkParam.ZBins * trkParam.PhiBins + 1), 0));
+    mIndexTables.resize(mClusters.size());
+    for (auto& table : mIndexTables) {
+      table.assign(mNrof * (trkParam.ZBins * trkParam.PhiBins + 1), 0);
+    }
     mLines.resize(mNrof);
     mTrackletClusters.resize(mNrof);
     mNTrackletsPerROf.resize(2);
@@ -280,6 +294,7 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
 
     std::vector<ClusterHelper> cHelper;
     std::vector<int> clsPerBin(trkParam.PhiBins * trkParam.ZBins, 0);
+    std::vector<int> lutPerBin(clsPerBin.size());
 
     for (int iLayer{0}; iLayer < trkParam.NLayers; ++iLayer) {
       if (trkParam.SystErrorY2[iLayer] > 0.f || trkParam.SystErrorZ2[iLayer] > 0.f) {
@@ -327,7 +342,6 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
           h.bin = bin;
           h.ind = clsPerBin[bin]++;
         }
-        std::vector<int> lutPerBin(clsPerBin.size());
         lutPerBin[0] = 0;
         for (unsigned int iB{1}; iB < lutPerBin.size(); ++iB) {
           lutPerBin[iB] = lutPerBin[iB - 1] + clsPerBin[iB - 1];
@@ -337,7 +351,8 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
         for (int iCluster{0}; iCluster < clustersNum; ++iCluster) {
           const ClusterHelper& h = cHelper[iCluster];
 
-          Cluster& c = clusters2beSorted[lutPerBin[h.bin] + h.ind];
+          const int sortedIndex{lutPerBin[h.bin] + h.ind};
+          Cluster& c = clusters2beSorted[sortedIndex];
           c = unsortedClusters[iCluster];
           c.phi = h.phi;
           c.radius = h.r;
@@ -391,6 +406,7 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     if (iLayer < (int)mCells.size() - 1) {
       mCellsLookupTable[iLayer].clear();
       mCellsNeighbours[iLayer].clear();
+      mCellsNeighboursLUT[iLayer].clear();
     }
   }
 }
@@ -405,9 +421,10 @@ unsigned long TimeFrame::getArtefactsMemory()
     size += sizeof(Cell) * cells.size();
   }
   for (auto& cellsN : mCellsNeighbours) {
-    for (auto& vec : cellsN) {
-      size += sizeof(int) * vec.size();
-    }
+    size += sizeof(int) * cellsN.size();
+  }
+  for (auto& lut : mCellsNeighboursLUT) {
+    size += sizeof(int) * lut.size();
   }
   return size + sizeof(Road<5>) * mRoads.size();
 }
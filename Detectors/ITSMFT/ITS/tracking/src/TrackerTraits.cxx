@@ -41,6 +41,18 @@ float Sq(float q)
 {
   return q * q;
 }
+
+/// Items are processed in parallel by contiguous chunks, several per thread for load balancing.
+/// The outputs of the chunks are merged in chunk order, which reproduces the serial ordering.
+int getNChunks(int nItems, int nThreads)
+{
+  return nThreads > 1 ? std::min(nItems, nThreads * 8) : std::min(nItems, 1);
+}
+
+int getChunkBegin(int iChunk, int nChunks, int nItems)
+{
+  return static_cast<int>(static_cast<long>(iChunk) * nItems / nChunks);
+}
 } // namespace
 
 namespace o2
@@ -61,7 +73,18 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
 
   const Vertex diamondVert({mTrkParams[iteration].Diamond[0], mTrkParams[iteration].Diamond[1], mTrkParams[iteration].Diamond[2]}, {25.e-6f, 0.f, 0.f, 25.e-6f, 0.f, 36.f}, 1, 1.f);
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
-  for (int rof0{0}; rof0 < tf->getNrof(); ++rof0) {
+  std::vector<std::vector<std::vector<Tracklet>>> threadTracklets(mNThreads, std::vector<std::vector<Tracklet>>(mTrkParams[iteration].TrackletsPerRoad()));
+
+  /// ROFs are independent: each cluster of rof0 owns its lookup table entry, the tracklets go to per-thread buffers
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+  for (int rof0 = 0; rof0 < tf->getNrof(); ++rof0) {
+#ifdef WITH_OPENMP
+    auto& tracklets = threadTracklets[omp_get_thread_num()];
+#else
+    auto& tracklets = threadTracklets[0];
+#endif
+    std::vector<unsigned char> compatible;
+    std::vector<float> nextPhi, nextZ, nextRadius;
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     int minRof = (rof0 >= mTrkParams[iteration].DeltaROF) ? rof0 - mTrkParams[iteration].DeltaROF : 0;
     int maxRof = (rof0 == tf->getNrof() - mTrkParams[iteration].DeltaROF) ? rof0 : rof0 + mTrkParams[iteration].DeltaROF;
@@ -71,6 +94,8 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
         continue;
       }
       float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+      const float nSigmaCut{mTrkParams[iteration].NSigmaCut};
+      const float phiCut{tf->getPhiCut(iLayer)};
 
       const int currentLayerClustersNum{static_cast<int>(layer0.size())};
       for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
@@ -126,23 +151,43 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
                 }
               }
               const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
+              const int maxRowClusterIndex = std::min(tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex], static_cast<int>(layer1.size()));
+              if (firstRowClusterIndex >= maxRowClusterIndex) {
+                continue;
+              }
 
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+              /// Window compatibility of all the clusters of the row. Their coordinates are gathered in scratch
+              /// arrays, reused along the rows, such that the computation vectorises.
+              const int rowSize{maxRowClusterIndex - firstRowClusterIndex};
+              nextPhi.resize(rowSize);
+              nextZ.resize(rowSize);
+              nextRadius.resize(rowSize);
+              for (int iRow{0}; iRow < rowSize; ++iRow) {
+                const Cluster& rowCluster{layer1[firstRowClusterIndex + iRow]};
+                nextPhi[iRow] = rowCluster.phi;
+                nextZ[iRow] = rowCluster.zCoordinate;
+                nextRadius[iRow] = rowCluster.radius;
+              }
+              compatible.resize(rowSize);
+              for (int iRow{0}; iRow < rowSize; ++iRow) {
+                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextPhi[iRow])};
+                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextRadius[iRow] - currentCluster.radius) +
+                                                           currentCluster.zCoordinate - nextZ[iRow])};
+                compatible[iRow] = (deltaZ / sigmaZ < nSigmaCut) & ((deltaPhi < phiCut) | (gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < phiCut));
+              }
 
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
+              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+#ifndef OPTIMISATION_OUTPUT
+                if (!compatible[iNextCluster - firstRowClusterIndex]) {
+                  continue;
                 }
+#endif
 
                 const Cluster& nextCluster{layer1[iNextCluster]};
                 if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
                   continue;
                 }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
-
 #ifdef OPTIMISATION_OUTPUT
                 MCCompLabel label;
                 int currentId{currentCluster.clusterId};
@@ -158,46 +203,63 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
                     break;
                   }
                 }
+#pragma omp critical
                 off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
+                if (!compatible[iNextCluster - firstRowClusterIndex]) {
+                  continue;
+                }
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
-                  if (iLayer > 0) {
-                    tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
-                  }
-                  const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
-                                                                currentCluster.xCoordinate - nextCluster.xCoordinate)};
-                  const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
-                                   (currentCluster.radius - nextCluster.radius)};
-                  tf->getTracklets()[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
                 }
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                tracklets[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
               }
             }
           }
         }
       }
-      if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
-        return;
-      }
     }
   }
 
-  for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-    /// Sort tracklets
-    auto& trkl{tf->getTracklets()[iLayer + 1]};
+  /// Merge the per-thread tracklets, their order does not matter since they are sorted below
+  for (int iLayer{0}; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
+    auto& trkl{tf->getTracklets()[iLayer]};
+    size_t nTracklets{trkl.size()};
+    for (auto& tracklets : threadTracklets) {
+      nTracklets += tracklets[iLayer].size();
+    }
+    trkl.reserve(nTracklets);
+    for (auto& tracklets : threadTracklets) {
+      trkl.insert(trkl.end(), tracklets[iLayer].begin(), tracklets[iLayer].end());
+      std::vector<Tracklet>().swap(tracklets[iLayer]);
+    }
+  }
+  if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
+    return;
+  }
+
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+  for (int iLayer = 0; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
+    /// Sort tracklets, duplicates are identical so that the result does not depend on the filling order
+    auto& trkl{tf->getTracklets()[iLayer]};
     std::sort(trkl.begin(), trkl.end(), [](const Tracklet& a, const Tracklet& b) {
       return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
     });
-    /// Remove duplicates
-    auto& lut{tf->getTrackletsLookupTable()[iLayer]};
+    /// Remove duplicates, there is no LUT for the layer 0
+    auto* lut{iLayer > 0 ? &tf->getTrackletsLookupTable()[iLayer - 1] : nullptr};
     int id0{-1}, id1{-1};
     std::vector<Tracklet> newTrk;
     newTrk.reserve(trkl.size());
     for (auto& trk : trkl) {
       if (trk.firstClusterIndex == id0 && trk.secondClusterIndex == id1) {
-        lut[id0]--;
+        if (lut) {
+          (*lut)[id0]--;
+        }
       } else {
         id0 = trk.firstClusterIndex;
         id1 = trk.secondClusterIndex;
@@ -207,29 +269,21 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
     trkl.swap(newTrk);
 
     /// Compute LUT
-    std::exclusive_scan(lut.begin(), lut.end(), lut.begin(), 0);
-    lut.push_back(trkl.size());
-  }
-  /// Layer 0 is done outside the loop
-  std::sort(tf->getTracklets()[0].begin(), tf->getTracklets()[0].end(), [](const Tracklet& a, const Tracklet& b) {
-    return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
-  });
-  int id0{-1}, id1{-1};
-  std::vector<Tracklet> newTrk;
-  newTrk.reserve(tf->getTracklets()[0].size());
-  for (auto& trk : tf->getTracklets()[0]) {
-    if (trk.firstClusterIndex != id0 || trk.secondClusterIndex != id1) {
-      id0 = trk.firstClusterIndex;
-      id1 = trk.secondClusterIndex;
-      newTrk.push_back(trk);
+    if (lut) {
+      std::exclusive_scan(lut->begin(), lut->end(), lut->begin(), 0);
+      lut->push_back(trkl.size());
     }
   }
-  tf->getTracklets()[0].swap(newTrk);
 
   /// Create tracklets labels
   if (tf->hasMCinformation()) {
     for (int iLayer{0}; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
-      for (auto& trk : tf->getTracklets()[iLayer]) {
+      auto& trkl{tf->getTracklets()[iLayer]};
+      auto& labels{tf->getTrackletsLabel(iLayer)};
+      labels.resize(trkl.size());
+#pragma omp parallel for num_threads(mNThreads)
+      for (size_t iTracklet = 0; iTracklet < trkl.size(); ++iTracklet) {
+        auto& trk{trkl[iTracklet]};
         MCCompLabel label;
         int currentId{tf->getClusters()[iLayer][trk.firstClusterIndex].clusterId};
         int nextId{tf->getClusters()[iLayer + 1][trk.secondClusterIndex].clusterId};
@@ -244,7 +298,7 @@ void TrackerTraits::computeLayerTracklets(const int iteration)
             break;
           }
         }
-        tf->getTrackletsLabel(iLayer).emplace_back(label);
+        labels[iTracklet] = label;
       }
     }
   }
@@ -271,48 +325,65 @@ void TrackerTraits::computeLayerCells(const int iteration)
     resolution = resolution > 1.e-12 ? resolution : 1.f;
 #endif
     const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
-
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
-
-      const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
-      const int nextLayerLastTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
-
-      if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
-        continue;
-      }
-
-      for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
-        if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
-          break;
+    const int nChunks{getNChunks(currentLayerTrackletsNum, mNThreads)};
+    std::vector<std::vector<Cell>> chunkCells(nChunks);
+    std::vector<int> cellsPerTracklet(currentLayerTrackletsNum + 1, 0);
+
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+    for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+      auto& cells{chunkCells[iChunk]};
+      const int lastTracklet{getChunkBegin(iChunk + 1, nChunks, currentLayerTrackletsNum)};
+      for (int iTracklet{getChunkBegin(iChunk, nChunks, currentLayerTrackletsNum)}; iTracklet < lastTracklet; ++iTracklet) {
+
+        const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
+        const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+        const int nextLayerFirstTrackletIndex{
+          tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+        const int nextLayerLastTrackletIndex{
+          tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+
+        if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
+          continue;
         }
-        const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
-        const float tanLambda{(currentTracklet.tanLambda + nextTracklet.tanLambda) * 0.5f};
+
+        for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
+          if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
+            break;
+          }
+          const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
+          const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+          const float tanLambda{(currentTracklet.tanLambda + nextTracklet.tanLambda) * 0.5f};
 
 #ifdef OPTIMISATION_OUTPUT
-        bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
-        float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
-        off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
+          bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
+          float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
+#pragma omp critical
+          off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
 #endif
 
-        if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
-
-          if (iLayer > 0 && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
-            tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, tf->getCells()[iLayer].size());
+          if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
+            cells.emplace_back(
+              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+              iTracklet, iNextTracklet, tanLambda);
+            cellsPerTracklet[iTracklet]++;
           }
-
-          tf->getCells()[iLayer].emplace_back(
-            currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-            iTracklet, iNextTracklet, tanLambda);
         }
       }
     }
+
+    auto& layerCells{tf->getCells()[iLayer]};
+    size_t nCells{layerCells.size()};
+    for (auto& cells : chunkCells) {
+      nCells += cells.size();
+    }
+    layerCells.reserve(nCells);
+    for (auto& cells : chunkCells) {
+      layerCells.insert(layerCells.end(), cells.begin(), cells.end());
+    }
     if (iLayer > 0) {
-      tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, tf->getCells()[iLayer].size());
+      /// Index of the first cell of each tracklet, the last entry is the total
+      std::exclusive_scan(cellsPerTracklet.begin(), cellsPerTracklet.end(), cellsPerTracklet.begin(), 0);
+      tf->getCellsLookupTable()[iLayer - 1].swap(cellsPerTracklet);
     }
     if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
       return;
@@ -322,10 +393,14 @@ void TrackerTraits::computeLayerCells(const int iteration)
   /// Create cells labels
   if (tf->hasMCinformation()) {
     for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-      for (auto& cell : tf->getCells()[iLayer]) {
-        MCCompLabel currentLab{tf->getTrackletsLabel(iLayer)[cell.getFirstTrackletIndex()]};
-        MCCompLabel nextLab{tf->getTrackletsLabel(iLayer + 1)[cell.getSecondTrackletIndex()]};
-        tf->getCellsLabel(iLayer).emplace_back(currentLab == nextLab ? currentLab : MCCompLabel());
+      auto& cells{tf->getCells()[iLayer]};
+      auto& labels{tf->getCellsLabel(iLayer)};
+      labels.resize(cells.size());
+#pragma omp parallel for num_threads(mNThreads)
+      for (size_t iCell = 0; iCell < cells.size(); ++iCell) {
+        MCCompLabel currentLab{tf->getTrackletsLabel(iLayer)[cells[iCell].getFirstTrackletIndex()]};
+        MCCompLabel nextLab{tf->getTrackletsLabel(iLayer + 1)[cells[iCell].getSecondTrackletIndex()]};
+        labels[iCell] = currentLab == nextLab ? currentLab : MCCompLabel();
       }
     }
   }
@@ -351,29 +426,61 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
 
     int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
     const int nextLayerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer + 1].size())};
-    mTimeFrame->getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
-
-    for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
-
-      const Cell& currentCell{mTimeFrame->getCells()[iLayer][iCell]};
-      const int nextLayerTrackletIndex{currentCell.getSecondTrackletIndex()};
-      const int nextLayerFirstCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex]};
-      const int nextLayerLastCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex + 1]};
-      for (int iNextCell{nextLayerFirstCellIndex}; iNextCell < nextLayerLastCellIndex; ++iNextCell) {
-
-        Cell& nextCell{mTimeFrame->getCells()[iLayer + 1][iNextCell]};
-        if (nextCell.getFirstTrackletIndex() != nextLayerTrackletIndex) {
-          break;
-        }
+    auto& neighbours{mTimeFrame->getCellsNeighbours()[iLayer]};
+    auto& neighboursLUT{mTimeFrame->getCellsNeighboursLUT()[iLayer]};
+    neighboursLUT.assign(nextLayerCellsNum + 1, 0);
+
+    /// Pairs of (next layer cell, current layer cell)
+    const int nChunks{getNChunks(layerCellsNum, mNThreads)};
+    std::vector<std::vector<std::pair<int, int>>> chunkNeighbours(nChunks);
+
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+    for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+      const int lastCell{getChunkBegin(iChunk + 1, nChunks, layerCellsNum)};
+      for (int iCell{getChunkBegin(iChunk, nChunks, layerCellsNum)}; iCell < lastCell; ++iCell) {
+
+        const Cell& currentCell{mTimeFrame->getCells()[iLayer][iCell]};
+        const int nextLayerTrackletIndex{currentCell.getSecondTrackletIndex()};
+        const int nextLayerFirstCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex]};
+        const int nextLayerLastCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex + 1]};
+        for (int iNextCell{nextLayerFirstCellIndex}; iNextCell < nextLayerLastCellIndex; ++iNextCell) {
+
+          const Cell& nextCell{mTimeFrame->getCells()[iLayer + 1][iNextCell]};
+          if (nextCell.getFirstTrackletIndex() != nextLayerTrackletIndex) {
+            break;
+          }
 
 #ifdef OPTIMISATION_OUTPUT
-        bool good{mTimeFrame->getCellsLabel(iLayer)[iCell] == mTimeFrame->getCellsLabel(iLayer + 1)[iNextCell]};
-        float signedDelta{currentCell.getTanLambda() - nextCell.getTanLambda()};
-        off << fmt::format("{}\t{:d}\t{}\t{}", iLayer, good, signedDelta, signedDelta / mTrkParams[iteration].CellDeltaTanLambdaSigma) << std::endl;
+          bool good{mTimeFrame->getCellsLabel(iLayer)[iCell] == mTimeFrame->getCellsLabel(iLayer + 1)[iNextCell]};
+          float signedDelta{currentCell.getTanLambda() - nextCell.getTanLambda()};
+#pragma omp critical
+          off << fmt::format("{}\t{:d}\t{}\t{}", iLayer, good, signedDelta, signedDelta / mTrkParams[iteration].CellDeltaTanLambdaSigma) << std::endl;
 #endif
-        mTimeFrame->getCellsNeighbours()[iLayer][iNextCell].push_back(iCell);
+          chunkNeighbours[iChunk].emplace_back(iNextCell, iCell);
+        }
+      }
+    }
+
+    /// Compressed rows of neighbours: the chunks are in increasing current cell order, as the neighbours of each cell
+    for (auto& pairs : chunkNeighbours) {
+      for (auto& pair : pairs) {
+        neighboursLUT[pair.first]++;
+      }
+    }
+    std::exclusive_scan(neighboursLUT.begin(), neighboursLUT.end(), neighboursLUT.begin(), 0);
+    neighbours.resize(neighboursLUT.back());
+    std::vector<int> fill(neighboursLUT.begin(), neighboursLUT.end() - 1);
+    for (auto& pairs : chunkNeighbours) {
+      for (auto& [iNextCell, iCell] : pairs) {
+        neighbours[fill[iNextCell]++] = iCell;
+      }
+    }
 
-        const int currentCellLevel{currentCell.getLevel()};
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iNextCell = 0; iNextCell < nextLayerCellsNum; ++iNextCell) {
+      Cell& nextCell{mTimeFrame->getCells()[iLayer + 1][iNextCell]};
+      for (int iCell : mTimeFrame->getCellNeighbours(iLayer, iNextCell)) {
+        const int currentCellLevel{mTimeFrame->getCells()[iLayer][iCell].getLevel()};
 
         if (currentCellLevel >= nextCell.getLevel()) {
           nextCell.setLevel(currentCellLevel + 1);
@@ -392,50 +499,58 @@ void TrackerTraits::findRoads(const int iteration)
     for (int iLayer{mTrkParams[iteration].CellsPerRoad() - 1}; iLayer >= minimumLevel; --iLayer) {
 
       const int levelCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
+      const int nChunks{getNChunks(levelCellsNum, mNThreads)};
+      std::vector<std::vector<Road<5>>> chunkRoads(nChunks);
 
-      for (int iCell{0}; iCell < levelCellsNum; ++iCell) {
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+      for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+        auto& roads{chunkRoads[iChunk]};
+        const int lastCell{getChunkBegin(iChunk + 1, nChunks, levelCellsNum)};
+        for (int iCell{getChunkBegin(iChunk, nChunks, levelCellsNum)}; iCell < lastCell; ++iCell) {
 
-        Cell& currentCell{mTimeFrame->getCells()[iLayer][iCell]};
+          const Cell& currentCell{mTimeFrame->getCells()[iLayer][iCell]};
 
-        if (currentCell.getLevel() != iLevel) {
-          continue;
-        }
+          if (currentCell.getLevel() != iLevel) {
+            continue;
+          }
 
-        mTimeFrame->getRoads().emplace_back(iLayer, iCell);
+          roads.emplace_back(iLayer, iCell);
 
-        /// For 3 clusters roads (useful for cascades and hypertriton) we just store the single cell
-        /// and we do not do the candidate tree traversal
-        if (iLevel == 1) {
-          continue;
-        }
+          /// For 3 clusters roads (useful for cascades and hypertriton) we just store the single cell
+          /// and we do not do the candidate tree traversal
+          if (iLevel == 1) {
+            continue;
+          }
 
-        const int cellNeighboursNum{static_cast<int>(
-          mTimeFrame->getCellsNeighbours()[iLayer - 1][iCell].size())};
-        bool isFirstValidNeighbour = true;
+          bool isFirstValidNeighbour = true;
 
-        for (int iNeighbourCell{0}; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+          for (const int neighbourCellId : mTimeFrame->getCellNeighbours(iLayer - 1, iCell)) {
 
-          const int neighbourCellId = mTimeFrame->getCellsNeighbours()[iLayer - 1][iCell][iNeighbourCell];
-          const Cell& neighbourCell = mTimeFrame->getCells()[iLayer - 1][neighbourCellId];
+            const Cell& neighbourCell = mTimeFrame->getCells()[iLayer - 1][neighbourCellId];
 
-          if (iLevel - 1 != neighbourCell.getLevel()) {
-            continue;
-          }
+            if (iLevel - 1 != neighbourCell.getLevel()) {
+              continue;
+            }
 
-          if (isFirstValidNeighbour) {
+            if (isFirstValidNeighbour) {
 
-            isFirstValidNeighbour = false;
+              isFirstValidNeighbour = false;
 
-          } else {
+            } else {
 
-            mTimeFrame->getRoads().emplace_back(iLayer, iCell);
+              roads.emplace_back(iLayer, iCell);
+            }
+
+            traverseCellsTree(neighbourCellId, iLayer - 1, roads);
           }
 
-          traverseCellsTree(neighbourCellId, iLayer - 1);
+          // TODO: crosscheck for short track iterations
+          // currentCell.setLevel(0);
         }
+      }
 
-        // TODO: crosscheck for short track iterations
-        // currentCell.setLevel(0);
+      for (auto& roads : chunkRoads) {
+        mTimeFrame->getRoads().insert(mTimeFrame->getRoads().end(), roads.begin(), roads.end());
       }
     }
 #ifdef CA_DEBUG
@@ -933,22 +1048,18 @@ track::TrackParCov TrackerTraits::buildTrackSeed(const Cluster& cluster1, const
                              0.f, 0.f, 0.f, 0.f, track::kC1Pt2max});
 }
 
-void TrackerTraits::traverseCellsTree(const int currentCellId, const int currentLayerId)
+void TrackerTraits::traverseCellsTree(const int currentCellId, const int currentLayerId, std::vector<Road<5>>& roads)
 {
-  Cell& currentCell{mTimeFrame->getCells()[currentLayerId][currentCellId]};
+  const Cell& currentCell{mTimeFrame->getCells()[currentLayerId][currentCellId]};
   const int currentCellLevel = currentCell.getLevel();
 
-  mTimeFrame->getRoads().back().addCell(currentLayerId, currentCellId);
+  roads.back().addCell(currentLayerId, currentCellId);
 
   if (currentLayerId > 0 && currentCellLevel > 1) {
-    const int cellNeighboursNum{static_cast<int>(
-      mTimeFrame->getCellsNeighbours()[currentLayerId - 1][currentCellId].size())};
     bool isFirstValidNeighbour = true;
 
-    for (int iNeighbourCell{0}; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+    for (const int neighbourCellId : mTimeFrame->getCellNeighbours(currentLayerId - 1, currentCellId)) {
 
-      const int neighbourCellId =
-        mTimeFrame->getCellsNeighbours()[currentLayerId - 1][currentCellId][iNeighbourCell];
       const Cell& neighbourCell = mTimeFrame->getCells()[currentLayerId - 1][neighbourCellId];
 
       if (currentCellLevel - 1 != neighbourCell.getLevel()) {
@@ -958,10 +1069,10 @@ void TrackerTraits::traverseCellsTree(const int currentCellId, const int current
       if (isFirstValidNeighbour) {
         isFirstValidNeighbour = false;
       } else {
-        mTimeFrame->getRoads().push_back(mTimeFrame->getRoads().back());
+        roads.push_back(roads.back());
       }
 
-      traverseCellsTree(neighbourCellId, currentLayerId - 1);
+      traverseCellsTree(neighbourCellId, currentLayerId - 1, roads);
     }
   }
 
@@ -67,6 +67,8 @@ void Vertexer::getGlobalConfiguration()
   verPar.pairCut = vc.pairCut;
   verPar.clusterCut = vc.clusterCut;
   verPar.histPairCut = vc.histPairCut;
+  verPar.useHistogramSeeding = vc.useHistogramSeeding;
+  verPar.histZBinWidth = vc.histZBinWidth;
   verPar.tanLambdaCut = vc.tanLambdaCut;
   verPar.lowMultBeamDistCut = vc.lowMultBeamDistCut;
   verPar.vertNsigmaCut = vc.vertNsigmaCut;
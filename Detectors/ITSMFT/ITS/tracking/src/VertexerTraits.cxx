@@ -233,7 +233,12 @@ void VertexerTraits::computeTracklets()
 
   /// Create tracklets labels for L0-L1, information is as flat as in tracklets vector (no rofId)
   if (mTimeFrame->hasMCinformation()) {
-    for (auto& trk : mTimeFrame->getTracklets()[0]) {
+    auto& tracklets{mTimeFrame->getTracklets()[0]};
+    auto& labels{mTimeFrame->getTrackletsLabel(0)};
+    labels.resize(tracklets.size());
+#pragma omp parallel for num_threads(mNThreads)
+    for (size_t iTracklet = 0; iTracklet < tracklets.size(); ++iTracklet) {
+      auto& trk{tracklets[iTracklet]};
       MCCompLabel label;
       int sortedId0{mTimeFrame->getSortedIndex(trk.rof[0], 0, trk.firstClusterIndex)};
       int sortedId1{mTimeFrame->getSortedIndex(trk.rof[0], 1, trk.secondClusterIndex)};
@@ -248,7 +253,7 @@ void VertexerTraits::computeTracklets()
           break;
         }
       }
-      mTimeFrame->getTrackletsLabel(0).emplace_back(label);
+      labels[iTracklet] = label;
     }
   }
 
@@ -348,39 +353,44 @@ void VertexerTraits::computeVertices()
   std::vector<std::vector<ClusterLines>> dbg_clusLines(mTimeFrame->getNrof());
 #endif
   std::vector<int> noClustersVec(mTimeFrame->getNrof(), 0);
-  for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+  for (int rofId = 0; rofId < mTimeFrame->getNrof(); ++rofId) {
     const int numTracklets{static_cast<int>(mTimeFrame->getLines(rofId).size())};
 
     std::vector<bool> usedTracklets(numTracklets, false);
-    for (int line1{0}; line1 < numTracklets; ++line1) {
-      if (usedTracklets[line1]) {
-        continue;
-      }
-      for (int line2{line1 + 1}; line2 < numTracklets; ++line2) {
-        if (usedTracklets[line2]) {
+    if (mVrtParams.useHistogramSeeding) {
+      seedClustersFromHistogram(rofId, usedTracklets);
+    } else {
+      for (int line1{0}; line1 < numTracklets; ++line1) {
+        if (usedTracklets[line1]) {
           continue;
         }
-        auto dca{Line::getDCA(mTimeFrame->getLines(rofId)[line1], mTimeFrame->getLines(rofId)[line2])};
-        if (dca < mVrtParams.pairCut) {
-          mTimeFrame->getTrackletClusters(rofId).emplace_back(line1, mTimeFrame->getLines(rofId)[line1], line2, mTimeFrame->getLines(rofId)[line2]);
-          std::array<float, 3> tmpVertex{mTimeFrame->getTrackletClusters(rofId).back().getVertex()};
-          if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
-            mTimeFrame->getTrackletClusters(rofId).pop_back();
-            break;
+        for (int line2{line1 + 1}; line2 < numTracklets; ++line2) {
+          if (usedTracklets[line2]) {
+            continue;
           }
-          usedTracklets[line1] = true;
-          usedTracklets[line2] = true;
-          for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
-            if (usedTracklets[tracklet3]) {
-              continue;
+          auto dca{Line::getDCA(mTimeFrame->getLines(rofId)[line1], mTimeFrame->getLines(rofId)[line2])};
+          if (dca < mVrtParams.pairCut) {
+            mTimeFrame->getTrackletClusters(rofId).emplace_back(line1, mTimeFrame->getLines(rofId)[line1], line2, mTimeFrame->getLines(rofId)[line2]);
+            std::array<float, 3> tmpVertex{mTimeFrame->getTrackletClusters(rofId).back().getVertex()};
+            if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
+              mTimeFrame->getTrackletClusters(rofId).pop_back();
+              break;
             }
-            if (Line::getDistanceFromPoint(mTimeFrame->getLines(rofId)[tracklet3], tmpVertex) < mVrtParams.pairCut) {
-              mTimeFrame->getTrackletClusters(rofId).back().add(tracklet3, mTimeFrame->getLines(rofId)[tracklet3]);
-              usedTracklets[tracklet3] = true;
-              tmpVertex = mTimeFrame->getTrackletClusters(rofId).back().getVertex();
+            usedTracklets[line1] = true;
+            usedTracklets[line2] = true;
+            for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
+              if (usedTracklets[tracklet3]) {
+                continue;
+              }
+              if (Line::getDistanceFromPoint(mTimeFrame->getLines(rofId)[tracklet3], tmpVertex) < mVrtParams.pairCut) {
+                mTimeFrame->getTrackletClusters(rofId).back().add(tracklet3, mTimeFrame->getLines(rofId)[tracklet3]);
+                usedTracklets[tracklet3] = true;
+                tmpVertex = mTimeFrame->getTrackletClusters(rofId).back().getVertex();
+              }
             }
+            break;
           }
-          break;
         }
       }
     }
@@ -490,6 +500,127 @@ void VertexerTraits::computeVertices()
 #endif
 }
 
+/// Alternative to the pairing of all the lines of a ROF: the z at the point of closest approach of
+/// each line to the beam axis is histogrammed, and the vertices are seeded from the most populated
+/// windows of 3 bins. Lines are then only compared to the seeds of nearby z, which keeps the cost
+/// linear in the number of lines.
+void VertexerTraits::seedClustersFromHistogram(const int rofId, std::vector<bool>& usedLines)
+{
+  auto& lines{mTimeFrame->getLines(rofId)};
+  auto& clusters{mTimeFrame->getTrackletClusters(rofId)};
+  const int numLines{static_cast<int>(lines.size())};
+  const float zMax{mVrtParams.maxZPositionAllowed};
+  const int nBins{std::max(1, static_cast<int>(2.f * zMax / mVrtParams.histZBinWidth))};
+  const float inverseBinWidth{nBins / (2.f * zMax)};
+  const float beamX{mTimeFrame->getBeamX()}, beamY{mTimeFrame->getBeamY()};
+
+  std::vector<float> lineZ(numLines);
+  for (int iLine{0}; iLine < numLines; ++iLine) {
+    const float* origin{lines[iLine].originPoint};
+    const float* director{lines[iLine].cosinesDirector};
+    const float transverse2{director[0] * director[0] + director[1] * director[1]};
+    const float t{transverse2 > 0.f ? -((origin[0] - beamX) * director[0] + (origin[1] - beamY) * director[1]) / transverse2 : 0.f};
+    lineZ[iLine] = origin[2] + t * director[2];
+  }
+  std::vector<int> lineBin(numLines);
+  for (int iLine{0}; iLine < numLines; ++iLine) {
+    const float bin{(lineZ[iLine] + zMax) * inverseBinWidth};
+    lineBin[iLine] = bin >= 0.f && bin < nBins ? static_cast<int>(bin) : -1;
+  }
+  auto getBin = [&](float z) {
+    return static_cast<int>(std::clamp((z + zMax) * inverseBinWidth, 0.f, static_cast<float>(nBins - 1)));
+  };
+
+  /// Lines grouped by bin, the histogram counts those which are not yet attached to a seed
+  std::vector<int> histogram(nBins + 1, 0);
+  for (int iLine{0}; iLine < numLines; ++iLine) {
+    if (lineBin[iLine] >= 0) {
+      histogram[lineBin[iLine]]++;
+    }
+  }
+  std::vector<int> binOffsets(nBins + 1);
+  std::exclusive_scan(histogram.begin(), histogram.end(), binOffsets.begin(), 0);
+  std::vector<int> binLines(binOffsets.back());
+  std::vector<int> fill(binOffsets.begin(), binOffsets.end() - 1);
+  for (int iLine{0}; iLine < numLines; ++iLine) {
+    if (lineBin[iLine] >= 0) {
+      binLines[fill[lineBin[iLine]]++] = iLine;
+    }
+  }
+  std::vector<bool> inHistogram(numLines);
+  for (int iLine{0}; iLine < numLines; ++iLine) {
+    inHistogram[iLine] = lineBin[iLine] >= 0;
+  }
+  auto removeFromHistogram = [&](int iLine) {
+    if (inHistogram[iLine]) {
+      histogram[lineBin[iLine]]--;
+      inHistogram[iLine] = false;
+    }
+  };
+
+  std::vector<int> window;
+  while (true) {
+    int peak{-1}, peakCount{1};
+    for (int iBin{0}; iBin < nBins; ++iBin) {
+      const int count{histogram[iBin] + (iBin > 0 ? histogram[iBin - 1] : 0) + histogram[iBin + 1]};
+      if (count > peakCount) {
+        peak = iBin;
+        peakCount = count;
+      }
+    }
+    if (peak < 0) {
+      break;
+    }
+
+    /// Whatever happens, the lines of the window are not considered again as seeds
+    window.clear();
+    for (int iLine{binOffsets[std::max(peak - 1, 0)]}; iLine < binOffsets[std::min(peak + 2, nBins)]; ++iLine) {
+      if (inHistogram[binLines[iLine]]) {
+        window.push_back(binLines[iLine]);
+        removeFromHistogram(binLines[iLine]);
+      }
+    }
+
+    int line1{-1}, line2{-1};
+    for (size_t i{0}; i < window.size() && line1 < 0; ++i) {
+      for (size_t j{i + 1}; j < window.size(); ++j) {
+        if (Line::getDCA(lines[window[i]], lines[window[j]]) < mVrtParams.pairCut) {
+          line1 = window[i];
+          line2 = window[j];
+          break;
+        }
+      }
+    }
+    if (line1 < 0) {
+      continue;
+    }
+    clusters.emplace_back(line1, lines[line1], line2, lines[line2]);
+    std::array<float, 3> tmpVertex{clusters.back().getVertex()};
+    if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
+      clusters.pop_back();
+      continue;
+    }
+    usedLines[line1] = true;
+    usedLines[line2] = true;
+
+    /// Refinement with the lines of compatible z, as done with the pairing of all the lines
+    const int firstBin{getBin(tmpVertex[2] - mVrtParams.clusterCut)};
+    const int lastBin{getBin(tmpVertex[2] + mVrtParams.clusterCut)};
+    for (int iLine{binOffsets[firstBin]}; iLine < binOffsets[lastBin + 1]; ++iLine) {
+      const int line3{binLines[iLine]};
+      if (usedLines[line3]) {
+        continue;
+      }
+      if (Line::getDistanceFromPoint(lines[line3], tmpVertex) < mVrtParams.pairCut) {
+        clusters.back().add(line3, lines[line3]);
+        usedLines[line3] = true;
+        removeFromHistogram(line3);
+        tmpVertex = clusters.back().getVertex();
+      }
+    }
+  }
+}
+
 void VertexerTraits::setNThreads(int n)
 {
 #ifdef WITH_OPENMP
@@ -135,6 +135,7 @@ void ClustererDPL::updateTimeDependentParams(ProcessingContext& pc)
       nROFsToSquash = 2 + int(clParams.maxSOTMUS / (rofBC * o2::constants::lhc::LHCBunchSpacingMUS)); // use squashing
     }
     mClusterer->setMaxROFDepthToSquash(clParams.maxBCDiffToSquashBias > 0 ? nROFsToSquash : 0);
+    mClusterer->setColumnBitmaskKernel(clParams.columnBitmaskKernel);
     mClusterer->print();
   }
   // we may have other params which need to be queried regularly
@@ -49,6 +49,7 @@ class Road
   Cell& addCellInLayer(Int_t layer, T&&... args);
 
   std::vector<Cell>& getCellsInLayer(Int_t);
+  const std::vector<Cell>& getCellsInLayer(Int_t) const;
 
   void addLeftNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
   void addRightNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
@@ -117,6 +118,11 @@ inline std::vector<Cell>& Road::getCellsInLayer(Int_t layer)
   return mCell[layer];
 }
 
+inline const std::vector<Cell>& Road::getCellsInLayer(Int_t layer) const
+{
+  return mCell[layer];
+}
+
 inline void Road::addLeftNeighbourToCell(const Int_t layer, const Int_t cellId, const Int_t layerL, const Int_t cellIdL)
 {
   mCell[layer][cellId].addLeftNeighbour(layerL, cellIdL);
@@ -41,6 +41,19 @@ typedef std::function<bool(const ROFRecord&)> ROFFilter;
 
 class T;
 
+/// Working space of the track finders for one ROF. The tracker itself only
+/// holds the configuration, such that several threads can run the finders of
+/// a single tracker on different ROFs, each with its own scratch.
+struct TrackerScratch {
+  TrackerScratch() { road.initialize(); }
+
+  /// range of the sorted clusters of each layer in each R-Phi bin
+  std::array<std::array<std::pair<Int_t, Int_t>, constants::index_table::MaxRPhiBins>, constants::mft::LayersNumber> clusterBinIndexRange{};
+  /// current road for CA algorithm
+  Road road;
+  Int_t maxCellLevel = 0;
+};
+
 template <typename T>
 class Tracker : public TrackerConfig
 {
@@ -62,19 +75,22 @@ class Tracker : public TrackerConfig
     mTrackLabels.clear();
   }
 
-  void findTracks(ROframe<T>& rofData)
+  void findTracks(ROframe<T>& rofData) { findTracks(rofData, mScratch); }
+
+  /// Re-entrant version of findTracks, to be called concurrently for different ROFs with one scratch per thread
+  void findTracks(ROframe<T>& rofData, TrackerScratch& scratch) const
   {
     if (!mFullClusterScan) {
-      clearSorting();
-      sortClusters(rofData);
+      clearSorting(scratch);
+      sortClusters(rofData, scratch);
     }
-    findLTFTracks(rofData);
-    findCATracks(rofData);
+    findLTFTracks(rofData, scratch);
+    findCATracks(rofData, scratch);
   };
 
-  void findLTFTracks(ROframe<T>&);
-  void findCATracks(ROframe<T>&);
-  bool fitTracks(ROframe<T>&);
+  void findLTFTracks(ROframe<T>&, TrackerScratch&) const;
+  void findCATracks(ROframe<T>&, TrackerScratch&) const;
+  bool fitTracks(ROframe<T>&) const;
   void computeTracksMClabels(const std::vector<T>&);
 
   void configure(const MFTTrackingParam& trkParam, int trackerID);
@@ -82,16 +98,16 @@ class Tracker : public TrackerConfig
   int getTrackerID() const { return mTrackerID; }
 
  private:
-  void findTracksLTF(ROframe<T>&);
-  void findTracksCA(ROframe<T>&);
-  void findTracksLTFfcs(ROframe<T>&);
-  void findTracksCAfcs(ROframe<T>&);
-  void computeCellsInRoad(ROframe<T>&);
-  void runForwardInRoad();
-  void runBackwardInRoad(ROframe<T>&);
-  void updateCellStatusInRoad();
-
-  void sortClusters(ROframe<T>& rof)
+  void findTracksLTF(ROframe<T>&, const TrackerScratch&) const;
+  void findTracksCA(ROframe<T>&, TrackerScratch&) const;
+  void findTracksLTFfcs(ROframe<T>&) const;
+  void findTracksCAfcs(ROframe<T>&, TrackerScratch&) const;
+  void computeCellsInRoad(ROframe<T>&, TrackerScratch&) const;
+  void runForwardInRoad(TrackerScratch&) const;
+  void runBackwardInRoad(ROframe<T>&, TrackerScratch&) const;
+  void updateCellStatusInRoad(TrackerScratch&) const;
+
+  void sortClusters(ROframe<T>& rof, TrackerScratch& scratch) const
   {
     Int_t nClsInLayer, binPrevIndex, clsMinIndex, clsMaxIndex, jClsLayer;
     // sort the clusters in R-Phi
@@ -114,7 +130,7 @@ class Tracker : public TrackerConfig
 
         clsMaxIndex = jClsLayer - 1;
 
-        mClusterBinIndexRange[iLayer][binPrevIndex] = std::pair<Int_t, Int_t>(clsMinIndex, clsMaxIndex);
+        scratch.clusterBinIndexRange[iLayer][binPrevIndex] = std::pair<Int_t, Int_t>(clsMinIndex, clsMaxIndex);
 
         binPrevIndex = rof.getClustersInLayer(iLayer).at(jClsLayer).indexTableBin;
         clsMinIndex = jClsLayer;
@@ -123,34 +139,32 @@ class Tracker : public TrackerConfig
       // last cluster
       clsMaxIndex = jClsLayer - 1;
 
-      mClusterBinIndexRange[iLayer][binPrevIndex] = std::pair<Int_t, Int_t>(clsMinIndex, clsMaxIndex);
+      scratch.clusterBinIndexRange[iLayer][binPrevIndex] = std::pair<Int_t, Int_t>(clsMinIndex, clsMaxIndex);
     } // layers
   }
 
-  void clearSorting()
+  void clearSorting(TrackerScratch& scratch) const
   {
     for (Int_t iLayer = 0; iLayer < constants::mft::LayersNumber; ++iLayer) {
       for (Int_t iBin = 0; iBin <= mRPhiBins + 1; ++iBin) {
-        mClusterBinIndexRange[iLayer][iBin] = std::pair<Int_t, Int_t>(0, -1);
+        scratch.clusterBinIndexRange[iLayer][iBin] = std::pair<Int_t, Int_t>(0, -1);
       }
     }
   }
 
   const Int_t isDiskFace(Int_t layer) const { return (layer % 2); }
   const Float_t getDistanceToSeed(const Cluster&, const Cluster&, const Cluster&) const;
-  void getBinClusterRange(const ROframe<T>&, const Int_t, const Int_t, Int_t&, Int_t&) const;
+  void getBinClusterRange(const TrackerScratch&, const Int_t, const Int_t, Int_t&, Int_t&) const;
   const Float_t getCellDeviation(const Cell&, const Cell&) const;
   const Bool_t getCellsConnect(const Cell&, const Cell&) const;
-  void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe<T>&);
-  void addCellToCurrentRoad(ROframe<T>&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&);
+  void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe<T>&, const Road&) const;
+  void addCellToCurrentRoad(ROframe<T>&, Road&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&) const;
 
   int mTrackerID = 0;
   Float_t mBz;
   std::vector<MCCompLabel> mTrackLabels;
   std::unique_ptr<o2::mft::TrackFitter<T>> mTrackFitter = nullptr;
 
-  Int_t mMaxCellLevel = 0;
-
   bool mUseMC = false;
 
   /// helper to store points of a track candidate
@@ -165,8 +179,8 @@ class Tracker : public TrackerConfig
     Int_t idInLayer;
   };
 
-  /// current road for CA algorithm
-  Road mRoad;
+  /// scratch of the non re-entrant findTracks
+  TrackerScratch mScratch;
 };
 
 //_________________________________________________________________________________________________
@@ -189,9 +203,9 @@ inline const Float_t Tracker<T>::getDistanceToSeed(const Cluster& cluster1, cons
 
 //_________________________________________________________________________________________________
 template <typename T>
-inline void Tracker<T>::getBinClusterRange(const ROframe<T>& event, const Int_t layer, const Int_t bin, Int_t& clsMinIndex, Int_t& clsMaxIndex) const
+inline void Tracker<T>::getBinClusterRange(const TrackerScratch& scratch, const Int_t layer, const Int_t bin, Int_t& clsMinIndex, Int_t& clsMaxIndex) const
 {
-  const auto& pair = getClusterBinIndexRange(layer, bin);
+  const auto& pair = scratch.clusterBinIndexRange[layer][bin];
   clsMinIndex = pair.first;
   clsMaxIndex = pair.second;
 }
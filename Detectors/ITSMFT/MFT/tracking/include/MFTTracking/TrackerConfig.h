@@ -45,8 +45,6 @@ class TrackerConfig
 
   static void initBinContainers();
 
-  const std::pair<Int_t, Int_t>& getClusterBinIndexRange(Int_t layerId, Int_t bin) const { return mClusterBinIndexRange[layerId][bin]; }
-
  protected:
   // tracking configuration parameters
   Int_t mMinTrackPointsLTF{};
@@ -80,9 +78,8 @@ class TrackerConfig
 
   static std::unique_ptr<BinContainer> mBins;
   static std::unique_ptr<BinContainer> mBinsS;
-  std::array<std::array<std::pair<Int_t, Int_t>, constants::index_table::MaxRPhiBins>, constants::mft::LayersNumber> mClusterBinIndexRange{};
 
-  ClassDefNV(TrackerConfig, 3);
+  ClassDefNV(TrackerConfig, 4);
 };
 
 inline Float_t TrackerConfig::mPhiBinSize;
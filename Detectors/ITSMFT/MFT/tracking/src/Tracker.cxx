@@ -105,7 +105,6 @@ void Tracker<T>::configure(const MFTTrackingParam& trkParam, int trackerID)
     }
     initializeFinder();
   }
-  mRoad.initialize();
 }
 
 //_________________________________________________________________________________________________
@@ -237,10 +236,10 @@ void Tracker<T>::initializeFinder()
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findLTFTracks(ROframe<T>& event)
+void Tracker<T>::findLTFTracks(ROframe<T>& event, TrackerScratch& scratch) const
 {
   if (!mFullClusterScan) {
-    findTracksLTF(event);
+    findTracksLTF(event, scratch);
   } else {
     findTracksLTFfcs(event);
   }
@@ -248,18 +247,18 @@ void Tracker<T>::findLTFTracks(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findCATracks(ROframe<T>& event)
+void Tracker<T>::findCATracks(ROframe<T>& event, TrackerScratch& scratch) const
 {
   if (!mFullClusterScan) {
-    findTracksCA(event);
+    findTracksCA(event, scratch);
   } else {
-    findTracksCAfcs(event);
+    findTracksCAfcs(event, scratch);
   }
 }
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findTracksLTF(ROframe<T>& event)
+void Tracker<T>::findTracksLTF(ROframe<T>& event, const TrackerScratch& scratch) const
 {
   // find (high momentum) tracks by the Linear Track Finder (LTF) method
 
@@ -304,7 +303,7 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
       // loop over the bins in the search window
       for (const auto& binS : (*mBinsS.get())[layer1][layer2 - 1][cluster1.indexTableBin]) {
 
-        getBinClusterRange(event, layer2, binS, clsMinIndexS, clsMaxIndexS);
+        getBinClusterRange(scratch, layer2, binS, clsMinIndexS, clsMaxIndexS);
 
         for (std::vector<Cluster>::iterator it2 = (event.getClustersInLayer(layer2).begin() + clsMinIndexS); it2 != (event.getClustersInLayer(layer2).begin() + clsMaxIndexS + 1); ++it2) {
           Cluster& cluster2 = *it2;
@@ -334,7 +333,7 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
             dR2min = mLTFConeRadius ? dR2cut * dRCone * dRCone : dR2cut;
             for (const auto& bin : (*mBins.get())[layer1][layer - 1][cluster1.indexTableBin]) {
 
-              getBinClusterRange(event, layer, bin, clsMinIndex, clsMaxIndex);
+              getBinClusterRange(scratch, layer, bin, clsMinIndex, clsMaxIndex);
 
               for (std::vector<Cluster>::iterator it = (event.getClustersInLayer(layer).begin() + clsMinIndex); it != (event.getClustersInLayer(layer).begin() + clsMaxIndex + 1); ++it) {
                 Cluster& cluster = *it;
@@ -408,7 +407,7 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findTracksLTFfcs(ROframe<T>& event)
+void Tracker<T>::findTracksLTFfcs(ROframe<T>& event) const
 {
   // find (high momentum) tracks by the Linear Track Finder (LTF) method
   // with full scan of the clusters in the target plane
@@ -542,7 +541,7 @@ void Tracker<T>::findTracksLTFfcs(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findTracksCA(ROframe<T>& event)
+void Tracker<T>::findTracksCA(ROframe<T>& event, TrackerScratch& scratch) const
 {
   // layers: 0, 1, 2, ..., 9
   // rules for combining first/last plane in a road:
@@ -583,7 +582,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
         // loop over the bins in the search window
         for (const auto& binS : (*mBinsS.get())[layer1][layer2 - 1][cluster1.indexTableBin]) {
 
-          getBinClusterRange(event, layer2, binS, clsMinIndexS, clsMaxIndexS);
+          getBinClusterRange(scratch, layer2, binS, clsMinIndexS, clsMaxIndexS);
 
           for (std::vector<Cluster>::iterator it2 = (event.getClustersInLayer(layer2).begin() + clsMinIndexS); it2 != (event.getClustersInLayer(layer2).begin() + clsMaxIndexS + 1); ++it2) {
             Cluster& cluster2 = *it2;
@@ -609,7 +608,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
               // loop over the bins in the search window
               for (const auto& bin : (*mBins.get())[layer1][layer - 1][cluster1.indexTableBin]) {
 
-                getBinClusterRange(event, layer, bin, clsMinIndex, clsMaxIndex);
+                getBinClusterRange(scratch, layer, bin, clsMinIndex, clsMaxIndex);
 
                 for (std::vector<Cluster>::iterator it = (event.getClustersInLayer(layer).begin() + clsMinIndex); it != (event.getClustersInLayer(layer).begin() + clsMaxIndex + 1); ++it) {
                   Cluster& cluster = *it;
@@ -655,18 +654,19 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
               continue;
             }
 
-            mRoad.reset();
+            scratch.road.reset();
+            scratch.maxCellLevel = 0;
             for (Int_t point = 0; point < nPoints; ++point) {
               auto layer = roadPoints[point].layer;
               auto clsInLayer = roadPoints[point].idInLayer;
-              mRoad.setPoint(layer, clsInLayer);
+              scratch.road.setPoint(layer, clsInLayer);
             }
-            mRoad.setRoadId(roadId);
+            scratch.road.setRoadId(roadId);
             ++roadId;
 
-            computeCellsInRoad(event);
-            runForwardInRoad();
-            runBackwardInRoad(event);
+            computeCellsInRoad(event, scratch);
+            runForwardInRoad(scratch);
+            runBackwardInRoad(event, scratch);
 
           } // end clusters in layer2
         }   // end binRPhi
@@ -677,7 +677,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
+void Tracker<T>::findTracksCAfcs(ROframe<T>& event, TrackerScratch& scratch) const
 {
   // layers: 0, 1, 2, ..., 9
   // rules for combining first/last plane in a road:
@@ -772,18 +772,19 @@ void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
             continue;
           }
 
-          mRoad.reset();
+          scratch.road.reset();
+          scratch.maxCellLevel = 0;
           for (Int_t point = 0; point < nPoints; ++point) {
             auto layer = roadPoints[point].layer;
             auto clsInLayer = roadPoints[point].idInLayer;
-            mRoad.setPoint(layer, clsInLayer);
+            scratch.road.setPoint(layer, clsInLayer);
           }
-          mRoad.setRoadId(roadId);
+          scratch.road.setRoadId(roadId);
           ++roadId;
 
-          computeCellsInRoad(event);
-          runForwardInRoad();
-          runBackwardInRoad(event);
+          computeCellsInRoad(event, scratch);
+          runForwardInRoad(scratch);
+          runBackwardInRoad(event, scratch);
 
         } // end clusters in layer2
       }   // end clusters in layer1
@@ -793,7 +794,7 @@ void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::computeCellsInRoad(ROframe<T>& event)
+void Tracker<T>::computeCellsInRoad(ROframe<T>& event, TrackerScratch& scratch) const
 {
   Int_t layer1, layer1min, layer1max, layer2, layer2min, layer2max;
   Int_t nPtsInLayer1, nPtsInLayer2;
@@ -801,7 +802,7 @@ void Tracker<T>::computeCellsInRoad(ROframe<T>& event)
   Int_t cellId;
   Bool_t noCell;
 
-  mRoad.getLength(layer1min, layer1max);
+  scratch.road.getLength(layer1min, layer1max);
   --layer1max;
 
   for (layer1 = layer1min; layer1 <= layer1max; ++layer1) {
@@ -811,30 +812,30 @@ void Tracker<T>::computeCellsInRoad(ROframe<T>& event)
     layer2min = layer1 + 1;
     layer2max = std::min(layer1 + (constants::mft::DisksNumber - isDiskFace(layer1)), constants::mft::LayersNumber - 1);
 
-    nPtsInLayer1 = mRoad.getNPointsInLayer(layer1);
+    nPtsInLayer1 = scratch.road.getNPointsInLayer(layer1);
 
     for (Int_t point1 = 0; point1 < nPtsInLayer1; ++point1) {
 
-      clsInLayer1 = mRoad.getClustersIdInLayer(layer1)[point1];
+      clsInLayer1 = scratch.road.getClustersIdInLayer(layer1)[point1];
 
       layer2 = layer2min;
 
       noCell = kTRUE;
       while (noCell && (layer2 <= layer2max)) {
 
-        nPtsInLayer2 = mRoad.getNPointsInLayer(layer2);
+        nPtsInLayer2 = scratch.road.getNPointsInLayer(layer2);
         /*
         if (nPtsInLayer2 > 1) {
-          LOG(info) << "BV===== more than one point in road " << mRoad.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
+          LOG(info) << "BV===== more than one point in road " << scratch.road.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
         }
   */
         for (Int_t point2 = 0; point2 < nPtsInLayer2; ++point2) {
 
-          clsInLayer2 = mRoad.getClustersIdInLayer(layer2)[point2];
+          clsInLayer2 = scratch.road.getClustersIdInLayer(layer2)[point2];
 
           noCell = kFALSE;
           // create a cell
-          addCellToCurrentRoad(event, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+          addCellToCurrentRoad(event, scratch.road, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
         } // end points in layer2
         ++layer2;
 
@@ -845,7 +846,7 @@ void Tracker<T>::computeCellsInRoad(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::runForwardInRoad()
+void Tracker<T>::runForwardInRoad(TrackerScratch& scratch) const
 {
   Int_t layerR, layerL, icellR, icellL;
   Int_t iter = 0;
@@ -859,9 +860,9 @@ void Tracker<T>::runForwardInRoad()
     // R = right, L = left
     for (layerL = 0; layerL < (constants::mft::LayersNumber - 2); ++layerL) {
 
-      for (icellL = 0; icellL < mRoad.getCellsInLayer(layerL).size(); ++icellL) {
+      for (icellL = 0; icellL < scratch.road.getCellsInLayer(layerL).size(); ++icellL) {
 
-        Cell& cellL = mRoad.getCellsInLayer(layerL)[icellL];
+        Cell& cellL = scratch.road.getCellsInLayer(layerL)[icellL];
 
         layerR = cellL.getSecondLayerId();
 
@@ -869,16 +870,16 @@ void Tracker<T>::runForwardInRoad()
           continue;
         }
 
-        for (icellR = 0; icellR < mRoad.getCellsInLayer(layerR).size(); ++icellR) {
+        for (icellR = 0; icellR < scratch.road.getCellsInLayer(layerR).size(); ++icellR) {
 
-          Cell& cellR = mRoad.getCellsInLayer(layerR)[icellR];
+          Cell& cellR = scratch.road.getCellsInLayer(layerR)[icellR];
 
           if ((cellL.getLevel() == cellR.getLevel()) && getCellsConnect(cellL, cellR)) {
             if (iter == 1) {
-              mRoad.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
-              mRoad.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
+              scratch.road.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
+              scratch.road.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
             }
-            mRoad.incrementCellLevel(layerR, icellR);
+            scratch.road.incrementCellLevel(layerR, icellR);
             levelChange = kTRUE;
 
           } // end matching cells
@@ -886,16 +887,16 @@ void Tracker<T>::runForwardInRoad()
       }     // end loop cellL
     }       // end loop layer
 
-    updateCellStatusInRoad();
+    updateCellStatusInRoad(scratch);
 
   } // end while (levelChange)
 }
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
+void Tracker<T>::runBackwardInRoad(ROframe<T>& event, TrackerScratch& scratch) const
 {
-  if (mMaxCellLevel == 1) {
+  if (scratch.maxCellLevel == 1) {
     return; // we have only isolated cells
   }
 
@@ -914,9 +915,9 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
 
   for (Int_t layer = maxLayer; layer >= minLayer; --layer) {
 
-    for (cellId = 0; cellId < mRoad.getCellsInLayer(layer).size(); ++cellId) {
+    for (cellId = 0; cellId < scratch.road.getCellsInLayer(layer).size(); ++cellId) {
 
-      if (mRoad.isCellUsed(layer, cellId) || (mRoad.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
+      if (scratch.road.isCellUsed(layer, cellId) || (scratch.road.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
         continue;
       }
 
@@ -934,7 +935,7 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
         layerRC = trackCells[nCells - 1].layer;
         cellIdRC = trackCells[nCells - 1].idInLayer;
 
-        const Cell& cellRC = mRoad.getCellsInLayer(layerRC)[cellIdRC];
+        const Cell& cellRC = scratch.road.getCellsInLayer(layerRC)[cellIdRC];
 
         addCellToNewTrack = kFALSE;
 
@@ -947,9 +948,9 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
           layerL = leftNeighbour.first;
           cellIdL = leftNeighbour.second;
 
-          const Cell& cellL = mRoad.getCellsInLayer(layerL)[cellIdL];
+          const Cell& cellL = scratch.road.getCellsInLayer(layerL)[cellIdL];
 
-          if (mRoad.isCellUsed(layerL, cellIdL) || (mRoad.getCellLevel(layerL, cellIdL) != (mRoad.getCellLevel(layerRC, cellIdRC) - 1))) {
+          if (scratch.road.isCellUsed(layerL, cellIdL) || (scratch.road.getCellLevel(layerL, cellIdL) != (scratch.road.getCellLevel(layerRC, cellIdRC) - 1))) {
             continue;
           }
 
@@ -981,7 +982,7 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
 
       layerC = trackCells[0].layer;
       cellIdC = trackCells[0].idInLayer;
-      const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+      const Cell& cellC = scratch.road.getCellsInLayer(layerC)[cellIdC];
       hasDisk[cellC.getSecondLayerId() / 2] = kTRUE;
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
@@ -1005,10 +1006,10 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
         cellIdC = trackCells[icell].idInLayer;
-        addCellToCurrentTrackCA(layerC, cellIdC, event);
-        mRoad.setCellUsed(layerC, cellIdC, kTRUE);
+        addCellToCurrentTrackCA(layerC, cellIdC, event, scratch.road);
+        scratch.road.setCellUsed(layerC, cellIdC, kTRUE);
         // marked the used clusters
-        const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+        const Cell& cellC = scratch.road.getCellsInLayer(layerC)[cellIdC];
         event.getClustersInLayer(cellC.getFirstLayerId())[cellC.getFirstClusterIndex()].setUsed(true);
         event.getClustersInLayer(cellC.getSecondLayerId())[cellC.getSecondClusterIndex()].setUsed(true);
       }
@@ -1019,23 +1020,23 @@ void Tracker<T>::runBackwardInRoad(ROframe<T>& event)
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::updateCellStatusInRoad()
+void Tracker<T>::updateCellStatusInRoad(TrackerScratch& scratch) const
 {
   Int_t layerMin, layerMax;
-  mRoad.getLength(layerMin, layerMax);
+  scratch.road.getLength(layerMin, layerMax);
   for (Int_t layer = layerMin; layer < layerMax; ++layer) {
-    for (Int_t icell = 0; icell < mRoad.getCellsInLayer(layer).size(); ++icell) {
-      mRoad.updateCellLevel(layer, icell);
-      mMaxCellLevel = std::max(mMaxCellLevel, mRoad.getCellLevel(layer, icell));
+    for (Int_t icell = 0; icell < scratch.road.getCellsInLayer(layer).size(); ++icell) {
+      scratch.road.updateCellLevel(layer, icell);
+      scratch.maxCellLevel = std::max(scratch.maxCellLevel, scratch.road.getCellLevel(layer, icell));
     }
   }
 }
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::addCellToCurrentRoad(ROframe<T>& event, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId)
+void Tracker<T>::addCellToCurrentRoad(ROframe<T>& event, Road& road, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId) const
 {
-  Cell& cell = mRoad.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+  Cell& cell = road.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
 
   Cluster& cluster1 = event.getClustersInLayer(layer1)[clsInLayer1];
   Cluster& cluster2 = event.getClustersInLayer(layer2)[clsInLayer2];
@@ -1054,10 +1055,10 @@ void Tracker<T>::addCellToCurrentRoad(ROframe<T>& event, const Int_t layer1, con
 
 //_________________________________________________________________________________________________
 template <typename T>
-void Tracker<T>::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe<T>& event)
+void Tracker<T>::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe<T>& event, const Road& road) const
 {
   auto& trackCA = event.getCurrentTrack();
-  const Cell& cell = mRoad.getCellsInLayer(layer1)[cellId];
+  const Cell& cell = road.getCellsInLayer(layer1)[cellId];
   const Int_t layer2 = cell.getSecondLayerId();
   const Int_t clsInLayer1 = cell.getFirstClusterIndex();
   const Int_t clsInLayer2 = cell.getSecondClusterIndex();
@@ -1081,7 +1082,7 @@ void Tracker<T>::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId,
 
 //_________________________________________________________________________________________________
 template <typename T>
-bool Tracker<T>::fitTracks(ROframe<T>& event)
+bool Tracker<T>::fitTracks(ROframe<T>& event) const
 {
   for (auto& track : event.getTracks()) {
     T outParam = track;
@@ -60,8 +60,9 @@ class TrackerDPL : public o2::framework::Task
   std::shared_ptr<o2::base::GRPGeomRequest> mGGCCDBRequest;
   const o2::itsmft::TopologyDictionary* mDict = nullptr;
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
-  std::vector<std::unique_ptr<o2::mft::Tracker<TrackLTF>>> mTrackerVec;
-  std::vector<std::unique_ptr<o2::mft::Tracker<TrackLTFL>>> mTrackerLVec;
+  std::unique_ptr<o2::mft::Tracker<TrackLTF>> mTracker;
+  std::unique_ptr<o2::mft::Tracker<TrackLTFL>> mTrackerL;
+  std::vector<std::unique_ptr<o2::mft::TrackerScratch>> mScratch; ///< track finder working space, one per thread
 
   enum TimerIDs { SWTot,
                   SWLoadData,
@@ -136,6 +136,7 @@ void ClustererDPL::updateTimeDependentParams(ProcessingContext& pc)
       nROFsToSquash = 2 + int(clParams.maxSOTMUS / (rofBC * o2::constants::lhc::LHCBunchSpacingMUS)); // use squashing
     }
     mClusterer->setMaxROFDepthToSquash(nROFsToSquash);
+    mClusterer->setColumnBitmaskKernel(clParams.columnBitmaskKernel);
     mClusterer->print();
   }
   // we may have other params which need to be queried regularly
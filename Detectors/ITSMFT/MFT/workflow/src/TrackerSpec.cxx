@@ -19,6 +19,7 @@
 #include "MFTTracking/TrackCA.h"
 #include "MFTBase/GeometryTGeo.h"
 
+#include <atomic>
 #include <vector>
 #include <future>
 
@@ -44,7 +45,6 @@ namespace o2
 {
 namespace mft
 {
-//#define _TIMING_
 
 void TrackerDPL::init(InitContext& ic)
 {
@@ -56,6 +56,11 @@ void TrackerDPL::init(InitContext& ic)
 
   // tracking configuration parameters
   auto& trackingParam = MFTTrackingParam::Instance(); // to avoid loading interpreter during the run
+
+  mNThreads = std::max(1, ic.options().get<int>("nThreads"));
+  for (int i = 0; i < mNThreads; i++) {
+    mScratch.emplace_back(std::make_unique<o2::mft::TrackerScratch>());
+  }
 }
 
 void TrackerDPL::run(ProcessingContext& pc)
@@ -111,84 +116,43 @@ void TrackerDPL::run(ProcessingContext& pc)
   std::vector<o2::mft::TrackLTFL> tracksL;
   auto& allTracksMFT = pc.outputs().make<std::vector<o2::mft::TrackMFT>>(Output{"MFT", "TRACKS", 0, Lifetime::Timeframe});
 
-  std::uint32_t roFrameId = 0;
   int nROFs = rofs.size();
-  auto rofsPerWorker = std::max(1, nROFs / mNThreads);
-  LOG(debug) << "nROFs = " << nROFs << " rofsPerWorker = " << rofsPerWorker;
+  LOG(debug) << "nROFs = " << nROFs << " on " << mNThreads << " threads";
 
-  auto loadData = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    auto& tracker = trackerVec[0]; // Use first tracker to load the data: serial operation
+  auto loadData = [&, this](auto& tracker, auto& roFrameData) {
     gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
 
     auto iROF = 0;
 
     for (const auto& rof : rofs) {
-      int worker = std::min(int(iROF / rofsPerWorker), mNThreads - 1);
-      auto& roFrameData = roFrameDataVec[worker].emplace_back();
-      int nclUsed = ioutils::loadROFrameData(rof, roFrameData, compClusters, pattIt, mDict, labels, tracker.get(), filter);
-      LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed << " on worker " << worker;
+      auto& rofData = roFrameData.emplace_back();
+      int nclUsed = ioutils::loadROFrameData(rof, rofData, compClusters, pattIt, mDict, labels, tracker.get(), filter);
+      LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed;
       iROF++;
     }
   };
 
-  auto launchTrackFinder = [](auto* tracker, auto* workerROFs) {
-#ifdef _TIMING_
-    long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count(), tStartROF = tStart, tEnd = tStart;
-    size_t rofCNT = 0;
-#endif
-    for (auto& rofData : *workerROFs) {
-      tracker->findTracks(rofData);
-#ifdef _TIMING_
-      long tEndROF = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-      LOGP(info, "launchTrackFinder| tracker:{} did {}-th ROF in {} mus: {} clusters -> {} tracks", tracker->getTrackerID(), ++rofCNT, tEndROF - tStartROF, rofData.getTotalClusters(), rofData.getTracks().size());
-      tStartROF = tEnd = tEndROF;
-#endif
-    }
-#ifdef _TIMING_
-    LOGP(info, "launchTrackFinder| done: tracker:{} processed {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
-#endif
-  };
-
-  auto launchFitter = [](auto* tracker, auto* workerROFs) {
-#ifdef _TIMING_
-    long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-#endif
-    for (auto& rofData : *workerROFs) {
-      tracker->fitTracks(rofData);
-    }
-#ifdef _TIMING_
-    long tEnd = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-    LOGP(info, "launchTrackFitter| done: tracker:{} fitted  {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
-#endif
-  };
-
-  auto runMFTTrackFinder = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    std::vector<std::future<void>> finder;
-    for (int i = 0; i < mNThreads; i++) {
-      auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchTrackFinder, tracker.get(), &workerData);
-      finder.push_back(std::move(f));
+  // The ROFs are handed out one by one to the workers, such that a few busy ROFs do not
+  // hold back a whole block of them. Each ROF keeps its slot, so the output stays in ROF order.
+  auto runOnROFs = [this](auto& tracker, auto& roFrameData, auto&& process) {
+    std::atomic<int> nextROF{0};
+    auto worker = [&](int iThread) {
+      for (int iROF = nextROF++; iROF < int(roFrameData.size()); iROF = nextROF++) {
+        process(*tracker, roFrameData[iROF], *mScratch[iThread]);
+      }
+    };
+    std::vector<std::future<void>> workers;
+    for (int i = 1; i < mNThreads; i++) {
+      workers.push_back(std::async(std::launch::async, worker, i));
     }
-
-    for (int i = 0; i < mNThreads; i++) {
-      finder[i].wait();
+    worker(0);
+    for (auto& w : workers) {
+      w.wait();
     }
   };
 
-  auto runTrackFitter = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    std::vector<std::future<void>> fitter;
-    for (int i = 0; i < mNThreads; i++) {
-      auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchFitter, tracker.get(), &workerData);
-      fitter.push_back(std::move(f));
-    }
-
-    for (int i = 0; i < mNThreads; i++) {
-      fitter[i].wait();
-    }
-  };
+  auto findTracks = [](auto& tracker, auto& rofData, auto& scratch) { tracker.findTracks(rofData, scratch); };
+  auto fitTracks = [](auto& tracker, auto& rofData, auto&) { tracker.fitTracks(rofData); };
 
   // snippet to convert found tracks to final output tracks with separate cluster indices
   auto copyTracks = [](auto& new_tracks, auto& allTracks, auto& allClusIdx) {
@@ -205,119 +169,97 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   if (mFieldOn) {
 
-    std::vector<std::vector<o2::mft::ROframe<TrackLTF>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    std::vector<o2::mft::ROframe<TrackLTF>> roFrameData;
+    roFrameData.reserve(nROFs);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
-    loadData(mTrackerVec, roFrameVec);
+    loadData(mTracker, roFrameData);
     mTimer[SWLoadData].Stop();
 
     LOG(debug) << "Running MFT Track finder.";
 
     mTimer[SWFindMFTTracks].Start(false);
-    runMFTTrackFinder(mTrackerVec, roFrameVec);
+    runOnROFs(mTracker, roFrameData, findTracks);
     mTimer[SWFindMFTTracks].Stop();
 
     LOG(debug) << "Runnig track fitter.";
 
     mTimer[SWFitTracks].Start(false);
-    runTrackFitter(mTrackerVec, roFrameVec);
+    runOnROFs(mTracker, roFrameData, fitTracks);
     mTimer[SWFitTracks].Stop();
 
     if (mUseMC) {
       LOG(debug) << "Computing MC Labels.";
 
       mTimer[SWComputeLabels].Start(false);
-      auto& tracker = mTrackerVec[0];
-
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
+      for (auto& rofData : roFrameData) {
+        mTracker->computeTracksMClabels(rofData.getTracks());
+        trackLabels.swap(mTracker->getTrackLabels());
+        std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+        trackLabels.clear();
       }
       mTimer[SWComputeLabels].Stop();
     }
 
     auto rof = rofs.begin();
 
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracks.swap(rofData.getTracks());
-        ntracksROF = tracks.size();
-        copyTracks(tracks, allTracksMFT, allClusIdx);
-
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
+    for (auto& rofData : roFrameData) {
+      int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
+      tracks.swap(rofData.getTracks());
+      ntracksROF = tracks.size();
+      copyTracks(tracks, allTracksMFT, allClusIdx);
+
+      rof->setFirstEntry(firstROFTrackEntry);
+      rof->setNEntries(ntracksROF);
+      *rof++;
     }
 
   } else {
     LOG(debug) << "Field is off! ";
-    std::vector<std::vector<o2::mft::ROframe<TrackLTFL>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    std::vector<o2::mft::ROframe<TrackLTFL>> roFrameData;
+    roFrameData.reserve(nROFs);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
-    loadData(mTrackerLVec, roFrameVec);
+    loadData(mTrackerL, roFrameData);
     mTimer[SWLoadData].Stop();
 
     LOG(debug) << "Running MFT Track finder.";
 
     mTimer[SWFindMFTTracks].Start(false);
-    runMFTTrackFinder(mTrackerLVec, roFrameVec);
+    runOnROFs(mTrackerL, roFrameData, findTracks);
     mTimer[SWFindMFTTracks].Stop();
 
     LOG(debug) << "Runnig track fitter.";
 
     mTimer[SWFitTracks].Start(false);
-    runTrackFitter(mTrackerLVec, roFrameVec);
+    runOnROFs(mTrackerL, roFrameData, fitTracks);
     mTimer[SWFitTracks].Stop();
 
     if (mUseMC) {
       LOG(debug) << "Computing MC Labels.";
 
       mTimer[SWComputeLabels].Start(false);
-      auto& tracker = mTrackerLVec[0];
-
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
+      for (auto& rofData : roFrameData) {
+        mTrackerL->computeTracksMClabels(rofData.getTracks());
+        trackLabels.swap(mTrackerL->getTrackLabels());
+        std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+        trackLabels.clear();
       }
       mTimer[SWComputeLabels].Stop();
     }
 
     auto rof = rofs.begin();
 
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracksL.swap(rofData.getTracks());
-        ntracksROF = tracksL.size();
-        copyTracks(tracksL, allTracksMFT, allClusIdx);
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
+    for (auto& rofData : roFrameData) {
+      int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
+      tracksL.swap(rofData.getTracks());
+      ntracksROF = tracksL.size();
+      copyTracks(tracksL, allTracksMFT, allClusIdx);
+      rof->setFirstEntry(firstROFTrackEntry);
+      rof->setNEntries(ntracksROF);
+      *rof++;
     }
   }
 
@@ -367,20 +309,16 @@ void TrackerDPL::updateTimeDependentParams(ProcessingContext& pc)
       LOG(info) << "Starting MFT Linear tracker: Field is off!";
       LOG(info) << "  MFT tracker running with " << mNThreads << " threads";
       mFieldOn = false;
-      for (auto i = 0; i < mNThreads; i++) {
-        auto& tracker = mTrackerLVec.emplace_back(std::make_unique<o2::mft::Tracker<TrackLTFL>>(mUseMC));
-        tracker->setBz(0);
-        tracker->configure(trackingParam, i);
-      }
+      mTrackerL = std::make_unique<o2::mft::Tracker<TrackLTFL>>(mUseMC);
+      mTrackerL->setBz(0);
+      mTrackerL->configure(trackingParam, 0);
     } else {
       LOG(info) << "Starting MFT tracker: Field is on! Bz = " << Bz;
       LOG(info) << "  MFT tracker running with " << mNThreads << " threads";
       mFieldOn = true;
-      for (auto i = 0; i < mNThreads; i++) {
-        auto& tracker = mTrackerVec.emplace_back(std::make_unique<o2::mft::Tracker<TrackLTF>>(mUseMC));
-        tracker->setBz(Bz);
-        tracker->configure(trackingParam, i);
-      }
+      mTracker = std::make_unique<o2::mft::Tracker<TrackLTF>>(mUseMC);
+      mTracker->setBz(Bz);
+      mTracker->configure(trackingParam, 0);
     }
   }
 }
@@ -452,7 +390,7 @@ DataProcessorSpec getTrackerSpec(bool useMC, int nThreads)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<TrackerDPL>(ggRequest, useMC, nThreads)},
-    Options{}};
+    Options{{"nThreads", VariantType::Int, nThreads, {"Number of threads processing the ROFs concurrently"}}}};
 }
 
 } // namespace mft
@@ -14,6 +14,7 @@
 #include <Rtypes.h>
 #include <cstdio>
 #include <cstdint>
+#include <array>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -107,6 +108,9 @@ class AlpideCoder
   static bool isData(uint16_t v) { return (v & (0x1 << 15)) == 0; }
   static bool isData(uint8_t v) { return (v & (0x1 << 7)) == 0; }
 
+  /// expectation flags which can be satisfied by a given byte, to classify the chip data bytes with a single lookup
+  static const std::array<uint8_t, 256> ByteExpectations;
+
   static constexpr int Error = -1;     // flag for decoding error
   static constexpr int EOFFlag = -100; // flag for EOF in reading
 
@@ -154,11 +158,12 @@ class AlpideCoder
     while (buffer.next(dataC)) {
       //
       LOGP(debug, "dataC: {:#x} expect {:#b}", int(dataC), int(expectInp));
-      // ---------- chip info ?
+      // ---------- classify the byte against what is expected
+      uint32_t match = ByteExpectations[dataC] & expectInp;
       uint8_t dataCM = dataC & (~MaskChipID);
       //
-      if ((expectInp & ExpectChipEmpty) && dataCM == CHIPEMPTY) { // empty chip was expected
-        chipData.setChipID(cidGetter(dataC & MaskChipID));        // here we set the global chip ID
+      if (match & ExpectChipEmpty) {                       // empty chip was expected
+        chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
         if (!buffer.next(timestamp)) {
 #ifdef ALPIDE_DECODING_STAT
           chipData.setError(ChipStat::TruncatedChipEmpty);
@@ -170,8 +175,8 @@ class AlpideCoder
         continue;
       }
 
-      if ((expectInp & ExpectChipHeader) && dataCM == CHIPHEADER) { // chip header was expected
-        chipData.setChipID(cidGetter(dataC & MaskChipID));          // here we set the global chip ID
+      if (match & ExpectChipHeader) {                      // chip header was expected
+        chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
         if (!buffer.next(timestamp)) {
 #ifdef ALPIDE_DECODING_STAT
           chipData.setError(ChipStat::TruncatedChipHeader);
@@ -183,13 +188,13 @@ class AlpideCoder
       }
 
       // region info ?
-      if ((expectInp & ExpectRegion) && (dataC & REGION) == REGION) { // chip header was seen, or hit data read
+      if (match & ExpectRegion) { // chip header was seen, or hit data read
         region = dataC & MaskRegion;
         expectInp = ExpectData;
         continue;
       }
 
-      if ((expectInp & ExpectChipTrailer) && dataCM == CHIPTRAILER) { // chip trailer was expected
+      if (match & ExpectChipTrailer) { // chip trailer was expected
         chipData.setROFlags(dataC & MaskROFlags);
 #ifdef ALPIDE_DECODING_STAT
         uint8_t roErr = dataC & MaskROFlags;
@@ -216,8 +221,8 @@ class AlpideCoder
 
       // hit info ?
       if ((expectInp & ExpectData)) {
-        if (isData(dataC)) { // region header was seen, expect data
-                             // note that here we are checking on the byte rather than the short, need complete to ushort
+        if (match & ExpectData) { // region header was seen, expect data
+                                  // note that here we are checking on the byte rather than the short, need complete to ushort
           dataS = dataC << 8;
           if (!buffer.next(dataC)) {
 #ifdef ALPIDE_DECODING_STAT
@@ -145,6 +145,21 @@ class Clusterer
     PatternCont patterns;
     MCTruth labels;
     std::vector<ThreadStat> stats; // statistics for each thread results, used at merging
+    //
+    /// transient data of the column bitmask kernel: the fired rows of a column are kept as bits,
+    /// the runs of consecutive fired rows are extracted with word-wide operations and the runs
+    /// touching each other in adjacent columns are merged by union-find
+    static constexpr int NColumnWords = SegmentationAlpide::NRows / 64;
+    struct PixelRun {
+      uint16_t rowStart = 0;
+      uint16_t rowEnd = 0;
+      int firstPixel = 0; // entry of the 1st pixel of the run in runPixels
+      int nPixels = 0;
+      int parent = 0;      // union-find parent, the root is the 1st run of the cluster in the scan order
+      int nextInClus = -1; // next run of the same cluster
+    };
+    std::vector<PixelRun> runs;
+    std::vector<uint32_t> runPixels; // entries of the pixels of the runs in the ChipPixelData
     ///
     ///< reset column buffer, for the performance reasons we use memset
     void resetColumn(int* buff) { std::memset(buff, -1, sizeof(int) * SegmentationAlpide::NRows); }
@@ -172,11 +187,23 @@ class Clusterer
       curr[row] = lastIndex; // store index of the new precluster in the current column buffer
     }
 
+    int findRunRoot(int run)
+    {
+      while (runs[run].parent != run) {
+        run = runs[run].parent = runs[runs[run].parent].parent;
+      }
+      return run;
+    }
+
     void fetchMCLabels(int digID, const ConstMCTruth* labelsDig, int& nfilled);
+    void fetchPixelMCLabels(const ChipPixelData* curChipData, uint32_t ip, const ConstMCTruth* labelsDig, int& nfilled);
     void initChip(const ChipPixelData* curChipData, uint32_t first);
     void updateChip(const ChipPixelData* curChipData, uint32_t ip);
     void finishChip(ChipPixelData* curChipData, CompClusCont* compClus, PatternCont* patterns,
                     const ConstMCTruth* labelsDig, MCTruth* labelsClus);
+    void finishCluster(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr);
+    void processChipBitmask(ChipPixelData* curChipData, uint32_t first, CompClusCont* compClusPtr, PatternCont* patternsPtr,
+                            const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPtr);
     void finishChipSingleHitFast(uint32_t hit, ChipPixelData* curChipData, CompClusCont* compClusPtr,
                                  PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPTr);
     void process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
@@ -217,6 +244,9 @@ class Clusterer
   int getMaxBCSeparationToSquash() const { return mMaxBCSeparationToSquash; }
   void setMaxBCSeparationToSquash(int n) { mMaxBCSeparationToSquash = n; }
 
+  bool isColumnBitmaskKernel() const { return mColumnBitmaskKernel; }
+  void setColumnBitmaskKernel(bool v) { mColumnBitmaskKernel = v; }
+
   void print() const;
   void clear();
   void reset();
@@ -249,6 +279,8 @@ class Clusterer
   int mSquashingDepth = 0; ///< squashing is applied to next N rofs
   int mMaxBCSeparationToSquash = 6000. / o2::constants::lhc::LHCBunchSpacingNS + 10;
 
+  bool mColumnBitmaskKernel = false; ///< find the clusters with the column bitmask kernel
+
   std::vector<std::unique_ptr<ClustererThread>> mThreads; // buffers for threads
   std::vector<ChipPixelData> mChips;                      // currently processed ROF's chips data
   std::vector<ChipPixelData> mChipsOld;                   // previously processed ROF's chips data (for masking)
@@ -244,6 +244,8 @@ struct GBTLinkDecodingStat {
   // Note: packet here is meant as a group of CRU pages belonging to the same trigger
   uint32_t nPackets = 0;                                                        // total number of packets (RDH pages)
   uint32_t nTriggers = 0;                                                       // total number of triggers (ROFs)
+  uint64_t nBytes = 0;                                                          // total raw data size (incl. RDHs)
+  double decodingTime = 0.;                                                     // wall time (s) spent collecting and decoding the link data
   std::array<uint32_t, NErrorsDefined> errorCounts = {};                        // error counters
   std::array<uint32_t, GBTDataTrailer::MaxStateCombinations> packetStates = {}; // packet status from the trailer
 
@@ -251,13 +253,18 @@ struct GBTLinkDecodingStat {
   {
     nPackets = 0;
     nTriggers = 0;
+    nBytes = 0;
+    decodingTime = 0.;
     errorCounts.fill(0);
     packetStates.fill(0);
   }
 
+  /// decoding throughput in MB/s
+  double getThroughput() const { return decodingTime > 0. ? nBytes / decodingTime * 1e-6 : 0.; }
+
   void print(bool skipNoErr = true) const;
 
-  ClassDefNV(GBTLinkDecodingStat, 3);
+  ClassDefNV(GBTLinkDecodingStat, 4);
 };
 
 } // namespace itsmft
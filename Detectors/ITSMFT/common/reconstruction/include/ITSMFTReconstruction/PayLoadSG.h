@@ -120,6 +120,9 @@ class PayLoadSG
     // move to the next piece
     mCurrentEntryInPiece = 0;
     mCurrentPieceID++;
+    if (mCurrentPieceID + 1 < mBuffer.size()) { // the pieces are scattered over the DPL input buffers, fetch the head of the following one in advance
+      __builtin_prefetch(mBuffer[mCurrentPieceID + 1].data);
+    }
     return currentPiece();
   }
 
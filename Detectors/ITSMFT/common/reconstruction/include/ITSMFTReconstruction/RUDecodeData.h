@@ -15,6 +15,7 @@
 #define ALICEO2_ITSMFT_RUDECODEDATA_H_
 
 #include <array>
+#include <chrono>
 #include <memory>
 #include "ITSMFTReconstruction/PixelData.h"
 #include "ITSMFTReconstruction/PayLoadCont.h"
@@ -48,6 +49,7 @@ struct RUDecodeData {
   int nLinks = 0;          // number of links seen for this TF
   int nLinksDone = 0;      // number of links finished for this TF
   int verbosity = 0;       // verbosity level, for -1,0 print only summary data, for 1: print once every error
+  bool measureTime = false; // measure the decoding time of the cables, for the per link throughput report
   GBTCalibData calibData{}; // calibration info from GBT calibration word
   std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> chipErrorsTF{}; // vector of chip decoding errors seen in the given TF
   const RUInfo* ruInfo = nullptr;
@@ -58,6 +60,7 @@ struct RUDecodeData {
   }
   void clear();
   void setROFInfo(ChipPixelData* chipData, const GBTLink* lnk);
+  void addDecodingTime(int icab, double t);
   template <class Mapping>
   int decodeROF(const Mapping& mp, const o2::InteractionRecord ir);
   void fillChipStatistics(int icab, const ChipPixelData* chipData);
@@ -93,6 +96,10 @@ int RUDecodeData::decodeROF(const Mapping& mp, const o2::InteractionRecord ir)
     };
     int ret = 0;
     // dumpcabledata(icab);
+    std::chrono::steady_clock::time_point tStart;
+    if (measureTime) {
+      tStart = std::chrono::steady_clock::now();
+    }
 
     while ((ret = AlpideCoder::decodeChip(*chipData, cableData[icab], chIdGetter)) || chipData->isErrorSet()) { // we register only chips with hits or errors flags set
       setROFInfo(chipData, cableLinkPtr[icab]);
@@ -126,6 +133,9 @@ int RUDecodeData::decodeROF(const Mapping& mp, const o2::InteractionRecord ir)
       }
     }
     cableData[icab].clear();
+    if (measureTime) {
+      addDecodingTime(icab, std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count());
+    }
   }
 
   return ntot;
@@ -88,6 +88,9 @@ class RawPixelDecoder final : public PixelReader
   void setVerbosity(int v);
   int getVerbosity() const { return mVerbosity; }
 
+  void setMeasureLinkTime(bool v);
+  bool getMeasureLinkTime() const { return mMeasureLinkTime; }
+
   void printReport(bool decstat = true, bool skipNoErr = true) const;
   void produceRawDataDumps(int dump, const o2::framework::TimingInfo& tinfo);
 
@@ -150,6 +153,7 @@ class RawPixelDecoder final : public PixelReader
   std::unordered_map<o2::InteractionRecord, int> mIRPoll;                             // poll for links IR used for synchronization
   bool mFillCalibData = false;                                                        // request to fill calib data from GBT
   bool mAlloEmptyROFs = false;                                                        // do not skip empty ROFs
+  bool mMeasureLinkTime = false;                                                      // measure the decoding time of each link, for the throughput report
   int mVerbosity = 0;
   int mNThreads = 1; // number of decoding threads
   // statistics
@@ -18,6 +18,29 @@ using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
 
+const std::array<uint8_t, 256> AlpideCoder::ByteExpectations = []() {
+  std::array<uint8_t, 256> expectations{};
+  for (int i = 0; i < 256; i++) {
+    uint8_t dataC = i, dataCM = dataC & (~MaskChipID);
+    if (isData(dataC)) {
+      expectations[i] |= ExpectData;
+    }
+    if (dataCM == CHIPEMPTY) {
+      expectations[i] |= ExpectChipEmpty;
+    }
+    if (dataCM == CHIPHEADER) {
+      expectations[i] |= ExpectChipHeader;
+    }
+    if ((dataC & REGION) == REGION) {
+      expectations[i] |= ExpectRegion;
+    }
+    if (dataCM == CHIPTRAILER) {
+      expectations[i] |= ExpectChipTrailer;
+    }
+  }
+  return expectations;
+}();
+
 //_____________________________________
 void AlpideCoder::print() const
 {
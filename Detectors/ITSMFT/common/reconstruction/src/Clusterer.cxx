@@ -180,6 +180,8 @@ void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClu
       auto valp = validPixID++;
       if (validPixID == npix) { // special case of a single pixel fired on the chip
         finishChipSingleHitFast(valp, curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
+      } else if (parent->mColumnBitmaskKernel) {
+        processChipBitmask(curChipData, valp, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
       } else {
         initChip(curChipData, valp);
         for (; validPixID < npix; validPixID++) {
@@ -220,11 +222,7 @@ void Clusterer::ClustererThread::finishChip(ChipPixelData* curChipData, CompClus
       pixArrBuff.push_back(pix); // needed for cluster topology
       bbox.adjust(pix.getRowDirect(), pix.getCol());
       if (labelsClusPtr) {
-        if (parent->mSquashingDepth) { // the MCtruth for this pixel is stored in chip data: due to squashing we lose contiguity
-          fetchMCLabels(curChipData->getOrderedPixId(pixEntry.second), labelsDigPtr, nlab);
-        } else { // the MCtruth for this pixel is at curChipData->startID+pixEntry.second
-          fetchMCLabels(pixEntry.second + curChipData->getStartID(), labelsDigPtr, nlab);
-        }
+        fetchPixelMCLabels(curChipData, pixEntry.second, labelsDigPtr, nlab);
       }
       next = pixEntry.first;
     }
@@ -240,51 +238,171 @@ void Clusterer::ClustererThread::finishChip(ChipPixelData* curChipData, CompClus
         pixArrBuff.push_back(pix);                 // needed for cluster topology
         bbox.adjust(pix.getRowDirect(), pix.getCol());
         if (labelsClusPtr) {
-          if (parent->mSquashingDepth) { // the MCtruth for this pixel is stored in chip data: due to squashing we lose contiguity
-            fetchMCLabels(curChipData->getOrderedPixId(pixEntry.second), labelsDigPtr, nlab);
-          } else { // the MCtruth for this pixel is at curChipData->startID+pixEntry.second
-            fetchMCLabels(pixEntry.second + curChipData->getStartID(), labelsDigPtr, nlab);
-          }
+          fetchPixelMCLabels(curChipData, pixEntry.second, labelsDigPtr, nlab);
         }
         next = pixEntry.first;
       }
       preClusterIndices[i2] = -1;
     }
-    if (bbox.isAcceptableSize()) {
-      parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
-    } else {
-      auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
-      if (warnLeft > 0) {
-        LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
-             warnLeft == 1 ? " (Further warnings will be muted)" : "");
+    finishCluster(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::finishCluster(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr)
+{
+  // stream the cluster made of the pixels in pixArrBuff, splitting it if it does not fit the pattern
+  if (bbox.isAcceptableSize()) {
+    parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
+  } else {
+    auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
+    if (warnLeft > 0) {
+      LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
+           warnLeft == 1 ? " (Further warnings will be muted)" : "");
 #ifdef WITH_OPENMP
 #pragma omp critical
 #endif
-        {
-          parent->mNHugeClus++;
-        }
+      {
+        parent->mNHugeClus++;
       }
-      BBox bboxT(bbox); // truncated box
-      std::vector<PixelData> pixbuf;
-      do {
-        bboxT.rowMin = bbox.rowMin;
-        bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
-        do { // Select a subset of pixels fitting the reduced bounding box
-          bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
-          for (const auto& pix : pixArrBuff) {
-            if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
-              pixbuf.push_back(pix);
-            }
+    }
+    BBox bboxT(bbox); // truncated box
+    std::vector<PixelData> pixbuf;
+    do {
+      bboxT.rowMin = bbox.rowMin;
+      bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
+      do { // Select a subset of pixels fitting the reduced bounding box
+        bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
+        for (const auto& pix : pixArrBuff) {
+          if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
+            pixbuf.push_back(pix);
           }
-          if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
-            parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
-            pixbuf.clear();
+        }
+        if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
+          parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
+          pixbuf.clear();
+        }
+        bboxT.rowMin = bboxT.rowMax + 1;
+      } while (bboxT.rowMin < bbox.rowMax);
+      bboxT.colMin = bboxT.colMax + 1;
+    } while (bboxT.colMin < bbox.colMax);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::processChipBitmask(ChipPixelData* curChipData, uint32_t first, CompClusCont* compClusPtr, PatternCont* patternsPtr,
+                                                    const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPtr)
+{
+  // cluster the unmasked pixels of the chip starting from the entry "first" in the chip data, column by column
+#ifdef _ALLOW_DIAGONAL_ALPIDE_CLUSTERS_
+  constexpr int MaxRowGap = 1; // runs in adjacent columns touch if their rows overlap or are adjacent
+#else
+  constexpr int MaxRowGap = 0; // runs in adjacent columns touch if their rows overlap
+#endif
+  const auto& pixData = curChipData->getData();
+  uint32_t npix = pixData.size();
+  runs.clear();
+  runPixels.clear();
+  int prevRunsBegin = 0, prevRunsEnd = 0, prevCol = -2;
+  uint32_t ip = first;
+  while (ip < npix) {
+    // bitmask of the fired rows of the column
+    uint64_t mask[NColumnWords] = {};
+    uint16_t col = pixData[ip].getCol();
+    uint32_t colFirst = ip;
+    for (; ip < npix && pixData[ip].getCol() == col; ip++) {
+      if (!pixData[ip].isMasked()) {
+        auto row = pixData[ip].getRowDirect();
+        mask[row >> 6] |= uint64_t(1) << (row & 63);
+      }
+    }
+    // a run starts at a fired row with the row below not fired and ends at a fired row with the row above not fired
+    int colRunsBegin = runs.size(), runToEnd = colRunsBegin;
+    uint64_t carry = 0; // fired state of the last row of the previous word
+    for (int iw = 0; iw < NColumnWords; iw++) {
+      uint64_t word = mask[iw];
+      uint64_t above = iw + 1 < NColumnWords ? (mask[iw + 1] & 0x1) << 63 : 0;
+      uint64_t starts = word & ~((word << 1) | carry);
+      uint64_t ends = word & ~((word >> 1) | above);
+      carry = word >> 63;
+      for (; starts; starts &= starts - 1) {
+        auto& run = runs.emplace_back();
+        run.rowStart = iw * 64 + __builtin_ctzll(starts);
+        run.parent = runs.size() - 1;
+      }
+      for (; ends; ends &= ends - 1) {
+        runs[runToEnd++].rowEnd = iw * 64 + __builtin_ctzll(ends);
+      }
+    }
+    if (colRunsBegin == int(runs.size())) {
+      continue; // all pixels of the column are masked
+    }
+    // the pixels are sorted in row, hence the pixels of each run are consecutive
+    for (int ir = colRunsBegin; colFirst < ip; colFirst++) {
+      if (pixData[colFirst].isMasked()) {
+        continue;
+      }
+      auto row = pixData[colFirst].getRowDirect();
+      while (runs[ir].rowEnd < row) {
+        ir++;
+      }
+      if (!runs[ir].nPixels++) {
+        runs[ir].firstPixel = runPixels.size();
+      }
+      runPixels.push_back(colFirst);
+    }
+    // merge with the touching runs of the previous column, both lists of runs being sorted in row
+    int colRunsEnd = runs.size();
+    if (col == prevCol + 1) {
+      int jr = prevRunsBegin;
+      for (int ir = colRunsBegin; ir < colRunsEnd; ir++) {
+        while (jr < prevRunsEnd && runs[jr].rowEnd + MaxRowGap < runs[ir].rowStart) {
+          jr++;
+        }
+        for (int kr = jr; kr < prevRunsEnd && runs[kr].rowStart <= runs[ir].rowEnd + MaxRowGap; kr++) {
+          int root0 = findRunRoot(kr), root1 = findRunRoot(ir);
+          if (root0 != root1) {
+            runs[std::max(root0, root1)].parent = std::min(root0, root1);
           }
-          bboxT.rowMin = bboxT.rowMax + 1;
-        } while (bboxT.rowMin < bbox.rowMax);
-        bboxT.colMin = bboxT.colMax + 1;
-      } while (bboxT.colMin < bbox.colMax);
+        }
+      }
+    }
+    prevRunsBegin = colRunsBegin;
+    prevRunsEnd = colRunsEnd;
+    prevCol = col;
+  }
+
+  // chain the runs of each cluster behind its root, which comes first, and stream the clusters in the order of their 1st pixel
+  int nRuns = runs.size();
+  std::vector<int>& lastInClus = preClusterIndices; // reuse the buffer of the default kernel
+  lastInClus.resize(nRuns);
+  for (int ir = 0; ir < nRuns; ir++) {
+    int root = findRunRoot(ir);
+    lastInClus[ir] = ir;
+    if (root != ir) {
+      runs[lastInClus[root]].nextInClus = ir;
+      lastInClus[root] = ir;
+    }
+  }
+  for (int ir = 0; ir < nRuns; ir++) {
+    if (runs[ir].parent != ir) {
+      continue;
     }
+    BBox bbox(curChipData->getChipID());
+    int nlab = 0;
+    pixArrBuff.clear();
+    for (int jr = ir; jr >= 0; jr = runs[jr].nextInClus) {
+      const auto& run = runs[jr];
+      for (int i = run.firstPixel; i < run.firstPixel + run.nPixels; i++) {
+        const auto pix = pixData[runPixels[i]];
+        pixArrBuff.push_back(pix);
+        bbox.adjust(pix.getRowDirect(), pix.getCol());
+        if (labelsClusPtr) {
+          fetchPixelMCLabels(curChipData, runPixels[i], labelsDigPtr, nlab);
+        }
+      }
+    }
+    finishCluster(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
   }
 }
 
@@ -425,6 +543,16 @@ void Clusterer::ClustererThread::fetchMCLabels(int digID, const ConstMCTruth* la
   //
 }
 
+//__________________________________________________
+void Clusterer::ClustererThread::fetchPixelMCLabels(const ChipPixelData* curChipData, uint32_t ip, const ConstMCTruth* labelsDig, int& nfilled)
+{
+  if (parent->mSquashingDepth) { // the MCtruth for this pixel is stored in chip data: due to squashing we lose contiguity
+    fetchMCLabels(curChipData->getOrderedPixId(ip), labelsDig, nfilled);
+  } else { // the MCtruth for this pixel is at curChipData->startID+ip
+    fetchMCLabels(ip + curChipData->getStartID(), labelsDig, nfilled);
+  }
+}
+
 //__________________________________________________
 void Clusterer::clear()
 {
@@ -444,6 +572,9 @@ void Clusterer::print() const
   LOGP(info, "Clusterizer squashes overflow pixels separated by {} BC and <= {} in row/col seeking down to {} neighbour ROFs", mMaxBCSeparationToSquash, mMaxRowColDiffToMask, mSquashingDepth);
   LOG(info) << "Clusterizer masks overflow pixels separated by < " << mMaxBCSeparationToMask << " BC and <= "
             << mMaxRowColDiffToMask << " in row/col";
+  if (mColumnBitmaskKernel) {
+    LOG(info) << "Clusterizer uses the column bitmask kernel";
+  }
 
 #ifdef _PERFORM_TIMING_
   auto& tmr = const_cast<TStopwatch&>(mTimer); // ugly but this is what root does internally
@@ -100,7 +100,8 @@ void GBTLinkDecodingStat::print(bool skipNoErr) const
     nErr += errorCounts[i];
   }
   if (!skipNoErr || nErr) {
-    std::string rep = fmt::format("FEEID#{:#04x} Packet States Statistics (total packets: {}, triggers: {})", feeID, nPackets, nTriggers);
+    std::string rep = fmt::format("FEEID#{:#04x} Packet States Statistics (total packets: {}, triggers: {}, {:.3f} MB decoded in {:.3e} s: {:.1f} MB/s)",
+                                  feeID, nPackets, nTriggers, nBytes * 1e-6, decodingTime, getThroughput());
     bool countsSeen = false;
     for (int i = 0; i < GBTDataTrailer::MaxStateCombinations; i++) {
       if (packetStates[i]) {
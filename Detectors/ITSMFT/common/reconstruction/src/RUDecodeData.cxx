@@ -50,6 +50,13 @@ void RUDecodeData::setROFInfo(ChipPixelData* chipData, const GBTLink* lnk)
   chipData->setInteractionRecord(lnk->ir);
 }
 
+///_________________________________________________________________
+/// account the time spent on decoding the cable data in the statistics of the link transmitting it
+void RUDecodeData::addDecodingTime(int icab, double t)
+{
+  cableLinkPtr[icab]->statistics.decodingTime += t;
+}
+
 ///_________________________________________________________________
 /// fill chip decoding statistics
 void RUDecodeData::fillChipStatistics(int icab, const ChipPixelData* chipData)
@@ -20,6 +20,7 @@
 #include "Framework/DataRefUtils.h"
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/VerbosityConfig.h"
+#include <chrono>
 #include <filesystem>
 
 #ifdef WITH_OPENMP
@@ -64,6 +65,20 @@ void RawPixelDecoder<Mapping>::printReport(bool decstat, bool skipNoErr) const
        mDecodeNextAuto ? "AutoDecode" : "ExternalCall");
 
   LOGP(info, "{} decoded {} hits in {} non-empty chips in {} ROFs with {} threads, {} external triggers", mSelfName, mNPixelsFired, mNChipsFired, mROFCounter, mNThreads, mNExtTriggers);
+  uint64_t nBytes = 0;
+  double decTime = 0.;
+  const GBTLink* slowestLink = nullptr;
+  for (auto& lnk : mGBTLinks) {
+    nBytes += lnk.statistics.nBytes;
+    decTime += lnk.statistics.decodingTime;
+    if (lnk.statistics.decodingTime > 0. && (!slowestLink || lnk.statistics.getThroughput() < slowestLink->statistics.getThroughput())) {
+      slowestLink = &lnk;
+    }
+  }
+  if (slowestLink) {
+    LOGP(info, "{} decoded {:.3f} MB of raw data at {:.1f} MB/s per link on average, slowest link FEEID#{:#04x} at {:.1f} MB/s", mSelfName, nBytes * 1e-6,
+         nBytes / decTime * 1e-6, slowestLink->feeID, slowestLink->statistics.getThroughput());
+  }
   if (decstat) {
     LOG(info) << "GBT Links decoding statistics" << (skipNoErr ? " (only links with errors are reported)" : "");
     for (auto& lnk : mGBTLinks) {
@@ -158,7 +173,14 @@ void RawPixelDecoder<Mapping>::collectROFCableData(int iru)
   for (int il = 0; il < RUDecodeData::MaxLinksPerRU; il++) {
     auto* link = getGBTLink(ru.links[il]);
     if (link && link->statusInTF == GBTLink::DataSeen) {
+      std::chrono::steady_clock::time_point tStart;
+      if (mMeasureLinkTime) {
+        tStart = std::chrono::steady_clock::now();
+      }
       auto res = link->collectROFCableData(mMAP);
+      if (mMeasureLinkTime) {
+        link->statistics.decodingTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+      }
       if (res == GBTLink::DataSeen || res == GBTLink::CachedDataExist) { // at the moment process only DataSeen
         ru.nNonEmptyLinks++;
       } else if (res == GBTLink::StoppedOnEndOfData || res == GBTLink::AbortedOnError) { // this link has exhausted its data or it has to be discarded due to the error
@@ -287,7 +309,8 @@ void RawPixelDecoder<Mapping>::setupLinks(InputRecord& inputs)
       }
     }
     linksSeen++;
-    link.cacheData(it.raw(), RDHUtils::getMemorySize(rdh));
+    link.statistics.nBytes += RDHUtils::getMemorySize(rdh);
+    link.cacheData(it.raw(), RDHUtils::getMemorySize(rdh)); // the page is referred in place, not copied
   }
 
   if (linksAdded) { // new links were added, update link<->RU mapping, usually is done for 1st TF only
@@ -337,6 +360,7 @@ RUDecodeData& RawPixelDecoder<Mapping>::getCreateRUDecode(int ruSW)
     ru.ruInfo = mMAP.getRUInfoSW(ruSW); // info on the stave/RU
     ru.chipsData.resize(mMAP.getNChipsOnRUType(ru.ruInfo->ruType));
     ru.verbosity = mVerbosity;
+    ru.measureTime = mMeasureLinkTime;
     if (mVerbosity >= GBTLink::Verbosity::VerboseHeaders) {
       LOG(info) << mSelfName << " Defining container for RU " << ruSW << " at slot " << mRUEntry[ruSW];
     }
@@ -463,6 +487,16 @@ void RawPixelDecoder<Mapping>::setVerbosity(int v)
   }
 }
 
+///______________________________________________________________________
+template <class Mapping>
+void RawPixelDecoder<Mapping>::setMeasureLinkTime(bool v)
+{
+  mMeasureLinkTime = v;
+  for (auto& ru : mRUDecodeVec) {
+    ru.measureTime = v;
+  }
+}
+
 ///______________________________________________________________________
 template <class Mapping>
 void RawPixelDecoder<Mapping>::setNThreads(int n)
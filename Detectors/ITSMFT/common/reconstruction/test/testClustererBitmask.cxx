@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testClustererBitmask.cxx
+/// \brief Compare the clusters of the column bitmask kernel with those of the default kernel
+
+#define BOOST_TEST_MODULE Test ITSMFT ClustererBitmask
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/Digit.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "ITSMFTBase/SegmentationAlpide.h"
+#include "ITSMFTReconstruction/ChipMappingITS.h"
+#include "ITSMFTReconstruction/Clusterer.h"
+#include "ITSMFTReconstruction/DigitPixelReader.h"
+#include "SimulationDataFormat/ConstMCTruthContainer.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+using namespace o2::itsmft;
+using MCTruth = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+
+namespace
+{
+constexpr int NROFs = 10;
+constexpr int NChipsPerROF = 40;
+constexpr int ROFLengthBC = 198; // close enough for the pixels fired in the previous ROF to be masked
+
+struct Input {
+  std::vector<Digit> digits;
+  std::vector<ROFRecord> rofs;
+  MCTruth labels;
+};
+
+struct Output {
+  std::vector<CompClusterExt> clusters;
+  std::vector<unsigned char> patterns;
+  std::vector<ROFRecord> rofs;
+  MCTruth labels;
+};
+
+/// Blobs of a few pixels, some overlapping (pixels with 2 labels), noise, a dense patch, huge clusters
+/// to be split and a hot pixel firing in every ROF, which gets masked
+Input makeInput()
+{
+  std::mt19937 generator(2024);
+  std::uniform_int_distribution<int> rowDist(0, SegmentationAlpide::NRows - 1), colDist(0, SegmentationAlpide::NCols - 1);
+  std::uniform_int_distribution<int> stepDist(-1, 1);
+  std::uniform_real_distribution<float> flat(0.f, 1.f);
+  Input input;
+  int track = 0;
+  for (int irof = 0; irof < NROFs; irof++) {
+    o2::InteractionRecord ir(irof * ROFLengthBC, 0);
+    auto& rof = input.rofs.emplace_back(ir, irof, input.digits.size(), 0);
+    for (int ichip = 0; ichip < NChipsPerROF; ichip++) {
+      const int chipID = ichip * 37;
+      std::map<std::pair<int, int>, std::vector<o2::MCCompLabel>> pixels; // ordered by column, then row, as the digitizer output
+      auto fire = [&pixels](int row, int col, int trackID) {
+        if (row >= 0 && row < SegmentationAlpide::NRows && col >= 0 && col < SegmentationAlpide::NCols) {
+          auto& labels = pixels[{col, row}];
+          if (labels.size() < 2 && std::find(labels.begin(), labels.end(), o2::MCCompLabel(trackID, 0, 0)) == labels.end()) {
+            labels.emplace_back(trackID, 0, 0);
+          }
+        }
+      };
+      for (int iblob = 0, nblobs = 1 + generator() % 20; iblob < nblobs; iblob++, track++) {
+        int row = rowDist(generator), col = colDist(generator);
+        for (int ipix = 0, npix = 1 + generator() % 25; ipix < npix; ipix++) {
+          fire(row, col, track);
+          row += stepDist(generator);
+          col += stepDist(generator);
+        }
+      }
+      if (ichip % 5 == 0) { // dense patch
+        int row0 = rowDist(generator) % (SegmentationAlpide::NRows - 40), col0 = colDist(generator) % (SegmentationAlpide::NCols - 40);
+        for (int col = col0; col < col0 + 40; col++) {
+          for (int row = row0; row < row0 + 40; row++) {
+            if (flat(generator) < 0.6f) {
+              fire(row, col, track);
+            }
+          }
+        }
+        track++;
+      }
+      if (ichip % 7 == 0) { // longer than the maximum row and column spans of a pattern
+        int col0 = colDist(generator) % (SegmentationAlpide::NCols - 300);
+        for (int row = 0; row < 300; row++) {
+          fire(row, col0 + row / 3, track);
+        }
+        track++;
+      }
+      fire(100, 200, 1000000); // hot pixel
+      for (auto& [colRow, labels] : pixels) {
+        for (auto& label : labels) {
+          input.labels.addElement(input.digits.size(), label);
+        }
+        input.digits.emplace_back(chipID, colRow.second, colRow.first, 100);
+      }
+    }
+    rof.setNEntries(input.digits.size() - rof.getFirstEntry());
+  }
+  return input;
+}
+
+Output clusterize(const Input& input, bool bitmaskKernel, int nThreads)
+{
+  std::vector<char> labelBuffer;
+  input.labels.flatten_to(labelBuffer);
+  o2::dataformats::ConstMCTruthContainerView<o2::MCCompLabel> labels(labelBuffer);
+
+  Clusterer clusterer;
+  clusterer.setNChips(ChipMappingITS::getNChips());
+  clusterer.setColumnBitmaskKernel(bitmaskKernel);
+  DigitPixelReader reader;
+  reader.setDigits(input.digits);
+  reader.setROFRecords(input.rofs);
+  reader.setDigitsMCTruth(&labels);
+  reader.init();
+  Output output;
+  clusterer.process(nThreads, reader, &output.clusters, &output.patterns, &output.rofs, &output.labels);
+  return output;
+}
+
+void compare(const Output& test, const Output& ref)
+{
+  BOOST_REQUIRE_EQUAL(test.rofs.size(), ref.rofs.size());
+  for (size_t i = 0; i < ref.rofs.size(); i++) {
+    BOOST_CHECK_EQUAL(test.rofs[i].getFirstEntry(), ref.rofs[i].getFirstEntry());
+    BOOST_CHECK_EQUAL(test.rofs[i].getNEntries(), ref.rofs[i].getNEntries());
+  }
+  BOOST_REQUIRE_EQUAL(test.clusters.size(), ref.clusters.size());
+  for (size_t i = 0; i < ref.clusters.size(); i++) {
+    BOOST_CHECK_EQUAL(test.clusters[i].getChipID(), ref.clusters[i].getChipID());
+    BOOST_CHECK_EQUAL(test.clusters[i].getRow(), ref.clusters[i].getRow());
+    BOOST_CHECK_EQUAL(test.clusters[i].getCol(), ref.clusters[i].getCol());
+    BOOST_CHECK_EQUAL(test.clusters[i].getPatternID(), ref.clusters[i].getPatternID());
+  }
+  BOOST_CHECK(test.patterns == ref.patterns);
+  // the labels of a cluster may be listed in a different order
+  BOOST_REQUIRE_EQUAL(test.labels.getIndexedSize(), ref.labels.getIndexedSize());
+  for (size_t i = 0; i < ref.clusters.size(); i++) {
+    auto testLabels = test.labels.getLabels(i), refLabels = ref.labels.getLabels(i);
+    std::vector<o2::MCCompLabel> testSorted(testLabels.begin(), testLabels.end()), refSorted(refLabels.begin(), refLabels.end());
+    std::sort(testSorted.begin(), testSorted.end());
+    std::sort(refSorted.begin(), refSorted.end());
+    BOOST_CHECK(testSorted == refSorted);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ClustererBitmask_test)
+{
+  const auto input = makeInput();
+  const auto reference = clusterize(input, false, 1);
+  BOOST_CHECK(!reference.clusters.empty());
+  BOOST_CHECK(reference.labels.getIndexedSize() == reference.clusters.size());
+  compare(clusterize(input, true, 1), reference);
+  compare(clusterize(input, true, 4), reference);
+}
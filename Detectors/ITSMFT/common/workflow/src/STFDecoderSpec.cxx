@@ -93,6 +93,7 @@ void STFDecoder<Mapping>::init(InitContext& ic)
       throw std::runtime_error(fmt::format("directory {} for raw data dumps does not exist", dumpDir));
     }
     mDecoder->setAllowEmptyROFs(ic.options().get<bool>("allow-empty-rofs"));
+    mDecoder->setMeasureLinkTime(ic.options().get<bool>("measure-link-throughput"));
     mDecoder->setRawDumpDirectory(dumpDir);
     mDecoder->setFillCalibData(mDoCalibData);
   } catch (const std::exception& e) {
@@ -279,6 +280,7 @@ void STFDecoder<Mapping>::updateTimeDependentParams(ProcessingContext& pc)
         nROFsToSquash = 2 + int(clParams.maxSOTMUS / (rofBC * o2::constants::lhc::LHCBunchSpacingMUS)); // use squashing
       }
       mClusterer->setMaxROFDepthToSquash(clParams.maxBCDiffToSquashBias > 0 ? nROFsToSquash : 0);
+      mClusterer->setColumnBitmaskKernel(clParams.columnBitmaskKernel);
       mClusterer->print();
     }
   }
@@ -389,6 +391,7 @@ DataProcessorSpec getSTFDecoderSpec(const STFDecoderInp& inp)
       {"raw-data-dumps-directory", VariantType::String, "", {"Destination directory for the raw data dumps"}},
       {"unmute-extra-lanes", VariantType::Bool, false, {"allow extra lanes to be as verbose as 1st one"}},
       {"allow-empty-rofs", VariantType::Bool, false, {"record ROFs w/o any hit"}},
+      {"measure-link-throughput", VariantType::Bool, false, {"measure the decoding time of each GBT link and report the throughput at the end"}},
       {"ignore-noise-map", VariantType::Bool, false, {"do not mask pixels flagged in the noise map"}},
       {"ignore-cluster-dictionary", VariantType::Bool, false, {"do not use cluster dictionary, always store explicit patterns"}}}};
 }
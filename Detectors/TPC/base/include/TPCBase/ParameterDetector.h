@@ -17,6 +17,7 @@
 #define ALICEO2_TPC_ParameterDetector_H_
 
 #include <array>
+#include <cstdint>
 #include "DataFormatsTPC/Defs.h"
 #include "CommonUtils/ConfigurableParam.h"
 #include "CommonUtils/ConfigurableParamHelper.h"
@@ -33,9 +34,25 @@ struct ParameterDetector : public o2::conf::ConfigurableParamHelper<ParameterDet
   float PadCapacitance = 0.1f; ///< Capacitance of a single pad [pF]
   TimeBin TmaxTriggered = 550; ///< Maximum time bin in case of triggered readout mode
   float DriftTimeOffset = 0.;  ///< drift time offset in time bins
+  bool CounterBasedRandom = false; ///< Random numbers of the electron transport and amplification attached to each electron, independent of the processing order
+  unsigned int RandomSeed = 0;     ///< Seed of the counter-based random numbers
 
   O2ParamDef(ParameterDetector, "TPCDetParam");
 };
+
+/// Second word of the key of the counter-based random numbers which are not attached to an electron, see
+/// ParameterDetector::CounterBasedRandom. The keys of the electrons contain the source ID in the upper 8 bits and the
+/// event ID in the lower 24 bits, which stay below these values for the source IDs below 255.
+enum class RandomStream : uint32_t {
+  TransportGaus = 0xffffff00, ///< Gaussian ring of the electron transport
+  TransportFlat,              ///< Flat ring of the electron transport
+  GEMGaus,                    ///< Gaussian ring of the GEM amplification
+  GEMFlat,                    ///< Flat ring of the GEM amplification
+  GEMGain,                    ///< Polya rings of the 4 individual GEMs, GEMGain + i for GEM i
+  GEMGainStack = GEMGain + 4, ///< Polya ring of the full stack
+  Noise,                      ///< Gaussian ring of the noise
+  NoisePosition,              ///< Position of the noise ring for each time bin and sector
+};
 } // namespace tpc
 } // namespace o2
 
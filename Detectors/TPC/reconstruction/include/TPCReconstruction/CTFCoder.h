@@ -207,9 +207,9 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
 
-  o2::ctf::CTFIOSize iosize;
-  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // blocks are encoded concurrently if requested, at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  ConcurrentEncoder<CTF, VEC> encoder(*this, buff);
+  auto encodeTPC = [&encoder, &optField](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
     const auto slotVal = static_cast<int>(slot);
     if (reject && begin != end) {
       std::vector<std::decay_t<decltype(*begin)>> tmp;
@@ -219,9 +219,9 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
           tmp.emplace_back(*i);
         }
       }
-      iosize += CTF::get(buff.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal].get(), mfc);
+      encoder.add(std::move(tmp), slotVal, probabilityBits, optField[slotVal]);
     } else {
-      iosize += CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal].get(), mfc);
+      encoder.add(begin, end, slotVal, probabilityBits, optField[slotVal]);
     }
   };
 
@@ -287,6 +287,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
 
   encodeTPC(ccl.nTrackClusters, ccl.nTrackClusters + ccl.nTracks, CTF::BLCnTrackClusters, 0, rejectTracks);
   encodeTPC(ccl.nSliceRowClusters, ccl.nSliceRowClusters + ccl.nSliceRows, CTF::BLCnSliceRowClusters, 0);
+  auto iosize = encoder.run();
   CTF::get(buff.data())->print(getPrefix(), mVerbosity);
   finaliseCTFOutput<CTF>(buff);
   iosize.rawIn = iosize.ctfIn;
@@ -316,11 +317,10 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec)
   ccFlat->set(sz, cc); // set offsets
   ec.print(getPrefix(), mVerbosity);
 
-  // decode encoded data directly to destination buff
-  o2::ctf::CTFIOSize iosize;
-  auto decodeTPC = [&ec, &coders = mCoders, &iosize](auto begin, CTF::Slots slot) {
-    const auto slotVal = static_cast<int>(slot);
-    iosize += ec.decode(begin, slotVal, coders[slotVal].get());
+  // decode encoded data directly to destination buff, concurrently if requested
+  ConcurrentDecoder decoder(*this);
+  auto decodeTPC = [&ec, &decoder](auto begin, CTF::Slots slot) {
+    decoder.add(ec, begin, static_cast<int>(slot));
   };
 
   if (mCombineColumns) {
@@ -375,6 +375,7 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec)
 
   decodeTPC(cc.nTrackClusters, CTF::BLCnTrackClusters);
   decodeTPC(cc.nSliceRowClusters, CTF::BLCnSliceRowClusters);
+  auto iosize = decoder.run();
   iosize.rawIn = iosize.ctfIn;
   return iosize;
 }
@@ -16,8 +16,10 @@
 #ifndef ALICEO2_TPC_DigitContainer_H_
 #define ALICEO2_TPC_DigitContainer_H_
 
-#include <deque>
 #include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCSimulation/DigitTime.h"
@@ -35,7 +37,9 @@ class Digit;
 /// This is the base class of the intermediate Digit Containers, in which all incoming electrons from the hits are
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
-/// This class holds the time bin containers.
+/// The charges are kept in a flat ring buffer of time bins x pads, which is allocated once and recycled when the
+/// time bins are written out. The MC labels of each pad and time bin are kept separately, in a per time bin list
+/// of (label, occurrence) pairs chained per pad.
 
 class DigitContainer
 {
@@ -49,6 +53,10 @@ class DigitContainer
   /// Reset the container
   void reset();
 
+  /// Release the memory of the time bins, e.g. of a digitizer which is only used for the setup shared by other
+  /// digitizers. The container grows again with the next call to reserve()
+  void release();
+
   /// Reserve space in the container for a given event
   void reserve(TimeBin eventTimeBin);
 
@@ -65,6 +73,10 @@ class DigitContainer
   /// \param signal Charge of the digit in ADC counts
   void addDigit(const MCCompLabel& label, const CRU& cru, TimeBin timeBin, GlobalPadNumber globalPad, float signal);
 
+  /// Update the per pad ion tail and common mode parameters cached in the class. To be called once per sector,
+  /// before the container is flushed
+  void updateParameters();
+
   /// Fill output vector
   /// \param output Output container
   /// \param mcTruth MC Truth container
@@ -76,15 +88,50 @@ class DigitContainer
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
 
   /// Get the size of the container for one event
-  size_t size() const { return mTimeBins.size(); }
+  size_t size() const { return mNTimeBins; }
 
  private:
+  static constexpr size_t NPads = Mapper::getPadsInSector();
+
+  /// MC label with its number of occurrences on a pad, chained to the previous label of the same pad
+  struct PadLabel {
+    MCCompLabel label{};
+    int nOccurrences = 0;
+    int next = -1; ///< index of the previous label on the same pad, -1 for the first one
+  };
+
+  /// \return position in the ring buffer of the time bin relative to the first time bin
+  size_t getSlot(size_t effectiveTimeBin) const
+  {
+    const size_t slot = mFirstSlot + effectiveTimeBin;
+    return slot < mNSlots ? slot : slot - mNSlots;
+  }
+
+  /// resize the ring buffer, keeping the stored time bins
+  void resizeSlots(size_t nSlots);
+
+  /// clear the charges and labels of one time bin
+  void clearSlot(size_t slot);
+
+  /// convert the charges of one time bin to digits
+  template <DigitzationMode MODE>
+  void fillOutputTimeBin(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin, size_t slot, o2::utils::DebugStreamer* debugStream, const CalPad* padParams[3]);
+
   TimeBin mFirstTimeBin = 0;                                  ///< First time bin to consider
   TimeBin mEffectiveTimeBin = 0;                              ///< Effective time bin of that digit
   TimeBin mTmaxTriggered = 0;                                 ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
   TimeBin mOffset;                                            ///< Size of the container for one event
-  std::deque<DigitTime*> mTimeBins;                           ///< Time bin Container for the ADC value
+  size_t mNTimeBins = 0;                                      ///< Number of time bins in use, starting at mFirstTimeBin
+  size_t mNSlots = 0;                                         ///< Number of time bins allocated in the ring buffer
+  size_t mFirstSlot = 0;                                      ///< Position of mFirstTimeBin in the ring buffer
+  std::vector<float> mCharge;                                 ///< Charges of the pads, mNSlots x NPads
+  std::vector<int> mFirstLabel;                               ///< Index of the last added label of each pad in mLabels, -1 if none, mNSlots x NPads
+  std::vector<std::vector<PadLabel>> mLabels;                 ///<! MC labels of each time bin
+  std::vector<bool> mHasSignal;                               ///< Flag if any charge was added to the time bin
+  std::array<unsigned char, NPads> mPadRegion;                ///< Region of each pad in the sector
+  std::vector<GlobalPadNumber> mSelectedPads;                 ///< Workspace for the pads to be converted to digits
   std::unique_ptr<DigitTime::PrevDigitInfoArray> mPrevDigArr; ///< Keep track of ToT and ion tail cumul from last time bin
+  const CalPad* mPadParams[3] = {nullptr, nullptr, nullptr};  ///< Caching of the per pad ion tail and common mode parameters
   o2::utils::DebugStreamer mStreamer;                         ///< Debug streamer
 };
 
@@ -97,28 +144,45 @@ inline DigitContainer::DigitContainer()
 
   // always have 50 % contingency for the size of the container depending on the input
   mOffset = static_cast<TimeBin>(detParam.TPCRecoWindowSim * detParam.TPClength / gasParam.DriftV / eleParam.ZbinWidth);
-  mTimeBins.resize(mOffset, nullptr);
+  resizeSlots(mOffset);
+  mNTimeBins = mOffset;
+
+  const auto& mapper = Mapper::instance();
+  for (size_t iPad = 0; iPad < NPads; ++iPad) {
+    mPadRegion[iPad] = static_cast<unsigned char>(mapper.getCRU(Sector(0), iPad));
+  }
+  mSelectedPads.resize(NPads);
 }
 
 inline void DigitContainer::reset()
 {
   mFirstTimeBin = 0;
   mEffectiveTimeBin = 0;
-  for (auto& time : mTimeBins) {
-    if (time) {
-      time->reset();
-    }
+  for (size_t slot = 0; slot < mNSlots; ++slot) {
+    clearSlot(slot);
   }
   if (mPrevDigArr) {
     std::fill(mPrevDigArr->begin(), mPrevDigArr->end(), PrevDigitInfo{});
   }
 }
 
+inline void DigitContainer::release()
+{
+  resizeSlots(0);
+  mNTimeBins = 0;
+  mFirstTimeBin = 0;
+  mEffectiveTimeBin = 0;
+  mPrevDigArr.reset();
+}
+
 inline void DigitContainer::reserve(TimeBin eventTimeBin)
 {
-  const auto space = mOffset + eventTimeBin - mFirstTimeBin;
-  if (mTimeBins.size() < space) {
-    mTimeBins.resize(space);
+  const size_t space = mOffset + eventTimeBin - mFirstTimeBin;
+  if (mNTimeBins < space) {
+    if (mNSlots < space) {
+      resizeSlots(std::max(space, mNSlots + mNSlots / 2));
+    }
+    mNTimeBins = space;
   }
 }
 
@@ -126,16 +190,27 @@ inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, T
                                      float signal)
 {
   mEffectiveTimeBin = timeBin - mFirstTimeBin;
-  if (mEffectiveTimeBin >= mTimeBins.size()) {
+  if (mEffectiveTimeBin >= mNTimeBins) {
     // LOG(warning) << "Out of bound access to digit container .. dropping digit";
     return;
   }
 
-  if (mTimeBins[mEffectiveTimeBin] == nullptr) {
-    mTimeBins[mEffectiveTimeBin] = new DigitTime();
+  const size_t slot = getSlot(mEffectiveTimeBin);
+  const size_t index = slot * NPads + globalPad;
+  mCharge[index] += signal;
+  mHasSignal[slot] = true;
+
+  auto& labels = mLabels[slot];
+  int& firstLabel = mFirstLabel[index];
+  for (int iLabel = firstLabel; iLabel != -1; iLabel = labels[iLabel].next) {
+    // compare directly on the bare label, see DigitGlobalPad::compareMClabels
+    if (labels[iLabel].label.getRawValue() == label.getRawValue()) {
+      ++labels[iLabel].nOccurrences;
+      return;
+    }
   }
-
-  mTimeBins[mEffectiveTimeBin]->addDigit(label, cru, globalPad, signal);
+  labels.push_back({label, 1, firstLabel});
+  firstLabel = static_cast<int>(labels.size()) - 1;
 }
 
 } // namespace o2::tpc
@@ -80,7 +80,14 @@ class DigitGlobalPad
                 o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>&);
 
   /// Fold signal with previous pad signal add ion tail and ToT for sigmal saturation
-  void foldSignal(PrevDigitInfo& prevDigit, const int sector, const int pad, const TimeBin time, Streamer* debugStream = nullptr, const CalPad* padParams[3] = nullptr);
+  void foldSignal(PrevDigitInfo& prevDigit, const int sector, const int pad, const TimeBin time, Streamer* debugStream = nullptr, const CalPad* padParams[3] = nullptr)
+  {
+    foldSignal(mChargePad, prevDigit, sector, pad, time, debugStream, padParams);
+  }
+
+  /// Fold signal with previous pad signal for a charge which is not stored in a DigitGlobalPad
+  /// \param chargePad accumulated charge on the pad, which is modified
+  static void foldSignal(float& chargePad, PrevDigitInfo& prevDigit, const int sector, const int pad, const TimeBin time, Streamer* debugStream = nullptr, const CalPad* padParams[3] = nullptr);
 
   void setID(int id) { mID = id; }
   int getID() const { return mID; }
@@ -131,7 +138,7 @@ inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
   mChargePad += signal;
 }
 
-inline void DigitGlobalPad::foldSignal(PrevDigitInfo& prevDigit, const int sector, const int pad, const TimeBin time, Streamer* debugStream, const CalPad* padParams[3])
+inline void DigitGlobalPad::foldSignal(float& chargePad, PrevDigitInfo& prevDigit, const int sector, const int pad, const TimeBin time, Streamer* debugStream, const CalPad* padParams[3])
 {
   const auto& eleParam = ParameterElectronics::Instance();
   const auto& itSettings = IonTailSettings::Instance();
@@ -142,7 +149,7 @@ inline void DigitGlobalPad::foldSignal(PrevDigitInfo& prevDigit, const int secto
   // Saturation tail simulation
   if (eleParam.doSaturationTail) {
     if (prevDigit.signal > 1023.f) {
-      prevDigit.tot += int(std::round(mChargePad * eleParam.adcToT));
+      prevDigit.tot += int(std::round(chargePad * eleParam.adcToT));
     }
     if (prevDigit.tot > 0) {
       prevDigit.tot -= 1;
@@ -151,9 +158,9 @@ inline void DigitGlobalPad::foldSignal(PrevDigitInfo& prevDigit, const int secto
 
   // ion tail simulation
   // not done in case we are in the saturation tail
-  float modCharge = mChargePad;
+  float modCharge = chargePad;
   if ((prevDigit.tot == 0) && (eleParam.doIonTail || eleParam.doIonTailPerPad)) {
-    modCharge = mChargePad + kAmp * (1 - expLambda) * prevDigit.cumul;
+    modCharge = chargePad + kAmp * (1 - expLambda) * prevDigit.cumul;
     prevDigit.cumul += prevDigInf.signal;
     prevDigit.cumul *= expLambda;
     if (prevDigit.cumul < 0.1) {
@@ -180,13 +187,13 @@ inline void DigitGlobalPad::foldSignal(PrevDigitInfo& prevDigit, const int secto
                                << "kAmp=" << kAmpTmp
                                << "tailSlopeUnit=" << tailSlopeUnitTmp
                                << "cmKValue=" << cmKValue
-                               << "charge=" << mChargePad
+                               << "charge=" << chargePad
                                << "prevDig=" << prevDigInfTmp
                                << "dig=" << prevDigit
                                << "\n";
   }
 
-  mChargePad = modCharge;
+  chargePad = modCharge;
 
   // TODO: propagate labels for ion tail?
 }
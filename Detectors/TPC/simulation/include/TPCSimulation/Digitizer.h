@@ -85,6 +85,13 @@ class Digitizer
              o2::dataformats::MCTruthContainer<o2::MCCompLabel>& labels,
              std::vector<o2::tpc::CommonMode>& commonModeOutput, bool finalFlush = false);
 
+  /// Flush the debug output to file. Called by flush(), except for digitizers using the distortions of another
+  /// digitizer: the owner of the distortions calls it once all of them are done
+  void flushDebugStreamer();
+
+  /// Release the memory of the digit container, for a digitizer which only keeps the setup shared by other digitizers
+  void releaseDigitContainer() { mDigitContainer.release(); }
+
   /// Set the sector to be processed
   /// \param sec Sector to be processed
   void setSector(Sector sec)
@@ -128,12 +135,17 @@ class Digitizer
   /// \param file containing distortions
   void setUseSCDistortions(std::string_view finp);
 
+  /// Use the space-charge distortions of another digitizer, e.g. one processing other sectors in a different thread.
+  /// The distortions are only read and are initialized by the init() of the owning digitizer
+  /// \param other digitizer owning the distortions
+  void setUseSCDistortions(const Digitizer& other);
+
   void setVDrift(float v) { mVDrift = v; }
   void setTDriftOffset(float t) { mTDriftOffset = t; }
 
  private:
   DigitContainer mDigitContainer;    ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;  ///< Handler of space-charge distortions
+  std::shared_ptr<SC> mSpaceCharge;  ///<! Handler of space-charge distortions
   Sector mSector = -1;               ///< ID of the currently processed sector
   double mEventTime = 0.f;           ///< Time of the currently processed event
   double mOutputDigitTimeOffset = 0; ///< Time of the first IR sampled in the digitizer
@@ -141,7 +153,8 @@ class Digitizer
   float mTDriftOffset = 0;           ///< drift time additive offset in \mus
   bool mIsContinuous;                ///< Switch for continuous readout
   bool mUseSCDistortions = false;    ///< Flag to switch on the use of space-charge distortions
-  ClassDefNV(Digitizer, 1);
+  bool mSharedSCDistortions = false; ///< Flag if the space-charge distortions are owned by another digitizer
+  ClassDefNV(Digitizer, 2);
 };
 } // namespace tpc
 } // namespace o2
@@ -21,6 +21,9 @@
 
 #include "TPCBase/Mapper.h"
 #include "MathUtils/RandomRing.h"
+#include "MathUtils/Philox.h"
+
+#include <vector>
 
 namespace o2
 {
@@ -35,9 +38,29 @@ namespace tpc
 class ElectronTransport
 {
  public:
+  /// Electrons after the drift, stored as structure of arrays
+  struct ElectronBatch {
+    std::vector<float> x;         ///< x position after the drift
+    std::vector<float> y;         ///< y position after the drift
+    std::vector<float> z;         ///< z position after the drift
+    std::vector<float> driftTime; ///< drift time
+    std::vector<uint32_t> index;  ///< index of the electron in the hit, which fixes its random numbers
+
+    size_t size() const { return index.size(); }
+    void resize(size_t n)
+    {
+      x.resize(n);
+      y.resize(n);
+      z.resize(n);
+      driftTime.resize(n);
+      index.resize(n);
+    }
+  };
+
+  /// Thread local instance, see GEMAmplification::instance()
   static ElectronTransport& instance()
   {
-    static ElectronTransport electronTransport;
+    static thread_local ElectronTransport electronTransport;
     return electronTransport;
   }
 
@@ -53,6 +76,16 @@ class ElectronTransport
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion
   GlobalPosition3D getElectronDrift(GlobalPosition3D posEle, float& driftTime);
 
+  /// Drift of all electrons of a hit, taking into account diffusion and attachment
+  /// The random numbers of an electron are given by the counter-based generator for the counter of the hit and the index
+  /// of the electron, such that the result does not depend on the processing order
+  /// \param posEle GlobalPosition3D with start position of the electrons
+  /// \param nElectrons Number of electrons
+  /// \param counter Counter identifying the hit, the last word is replaced by the electron index
+  /// \param key Key of the counter-based generator
+  /// \param batch Output with the electrons which are not attached
+  void getElectronDrift(GlobalPosition3D posEle, int nElectrons, math_utils::Philox::Counter counter, const math_utils::Philox::Key& key, ElectronBatch& batch) const;
+
   /// Drift of electrons in electric field taking into account diffusion with 3 sigma of the width
   /// \param posEle GlobalPosition3D with start position of the electrons
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion with
@@ -17,6 +17,7 @@
 #define ALICEO2_TPC_GEMAmplification_H_
 
 #include "MathUtils/RandomRing.h"
+#include "MathUtils/Philox.h"
 #include "TPCBase/ParameterGas.h"
 #include "TPCBase/ParameterGEM.h"
 #include "TPCBase/CRU.h"
@@ -36,10 +37,10 @@ namespace tpc
 class GEMAmplification
 {
  public:
-  /// Default constructor
+  /// One instance per thread, such that sectors can be digitized concurrently with independent random rings
   static GEMAmplification& instance()
   {
-    static GEMAmplification gemAmplification;
+    static thread_local GEMAmplification gemAmplification;
     return gemAmplification;
   }
 
@@ -49,6 +50,14 @@ class GEMAmplification
   /// Update the OCDB parameters cached in the class. To be called once per event
   void updateParameters();
 
+  /// Position the random rings at offsets given by the counter-based generator, such that the following amplification
+  /// of one electron only depends on its counter and not on the electrons amplified before
+  /// \param counter Counter identifying the hit, see ElectronTransport::getElectronDrift()
+  /// \param key Key of the counter-based generator
+  /// \param electron Index of the electron in the hit
+  /// \param mode Amplification mode, the rings of the individual GEMs are only positioned in the full mode
+  void setRandomStreams(math_utils::Philox::Counter counter, const math_utils::Philox::Key& key, uint32_t electron, const AmplificationMode mode);
+
   /// Compute the number of electrons after amplification in a full stack of four GEM foils
   /// \param nElectrons Number of electrons arriving at the first amplification stage (GEM1)
   /// \return Number of electrons after amplification in a full stack of four GEM foils
@@ -40,9 +40,10 @@ namespace tpc
 class SAMPAProcessing
 {
  public:
+  /// Thread local instance, each with its own noise ring
   static SAMPAProcessing& instance()
   {
-    static SAMPAProcessing sampaProcessing;
+    static thread_local SAMPAProcessing sampaProcessing;
     return sampaProcessing;
   }
   /// Destructor
@@ -118,6 +119,12 @@ class SAMPAProcessing
   /// \return Noise on the channel of interest
   float getNoise(const int sector, const int globalPadInSector);
 
+  /// Position the noise ring at an offset given by the counter-based generator, such that the noise of a time bin
+  /// only depends on the sector and the time bin and not on the time bins processed before by the same thread
+  /// \param sector sector number
+  /// \param timeBin time bin to be converted to digits
+  void setNoiseStream(const int sector, const TimeBin timeBin);
+
   /// Get the zero suppression threshold for a given channel
   float getZeroSuppression(const int sector, const int globalPadInSector) const;
 
@@ -15,6 +15,7 @@
 
 #include "TPCSimulation/DigitContainer.h"
 #include <memory>
+#include <numeric>
 #include <fairlogger/Logger.h>
 #include "TPCBase/Mapper.h"
 #include "TPCBase/CDBInterface.h"
@@ -24,6 +25,58 @@
 
 using namespace o2::tpc;
 
+void DigitContainer::resizeSlots(size_t nSlots)
+{
+  std::vector<float> charge(nSlots * NPads, 0.f);
+  std::vector<int> firstLabel(nSlots * NPads, -1);
+  std::vector<std::vector<PadLabel>> labels(nSlots);
+  std::vector<bool> hasSignal(nSlots, false);
+
+  // the time bins in use are moved to the beginning of the new buffer
+  for (size_t iTimeBin = 0; iTimeBin < std::min(mNTimeBins, nSlots); ++iTimeBin) {
+    const size_t slot = getSlot(iTimeBin);
+    std::copy_n(mCharge.begin() + slot * NPads, NPads, charge.begin() + iTimeBin * NPads);
+    std::copy_n(mFirstLabel.begin() + slot * NPads, NPads, firstLabel.begin() + iTimeBin * NPads);
+    labels[iTimeBin].swap(mLabels[slot]);
+    hasSignal[iTimeBin] = mHasSignal[slot];
+  }
+
+  mCharge.swap(charge);
+  mFirstLabel.swap(firstLabel);
+  mLabels.swap(labels);
+  mHasSignal.swap(hasSignal);
+  mNSlots = nSlots;
+  mFirstSlot = 0;
+}
+
+void DigitContainer::clearSlot(size_t slot)
+{
+  std::fill_n(mCharge.begin() + slot * NPads, NPads, 0.f);
+  std::fill_n(mFirstLabel.begin() + slot * NPads, NPads, -1);
+  mLabels[slot].clear(); // keep the capacity for the next time bins
+  mHasSignal[slot] = false;
+}
+
+void DigitContainer::updateParameters()
+{
+  const auto& eleParam = ParameterElectronics::Instance();
+  auto& cdb = CDBInterface::instance();
+
+  // ion tail per pad parameters
+  mPadParams[0] = mPadParams[1] = mPadParams[2] = nullptr;
+  if (eleParam.doIonTailPerPad) {
+    const auto& itSettings = IonTailSettings::Instance();
+    if (itSettings.padITCorrFile.size()) {
+      cdb.setFEEParamsFromFile(itSettings.padITCorrFile);
+    }
+    mPadParams[0] = &cdb.getITFraction();
+    mPadParams[1] = &cdb.getITExpLambda();
+  }
+  if (eleParam.doCommonModePerPad) {
+    mPadParams[2] = &cdb.getCMkValues();
+  }
+}
+
 void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
                                          dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush)
 {
@@ -43,21 +96,6 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   // Without this we might get crashes in the clusterization step.
   static const int maxTimeBinForTimeFrame = o2::conf::DigiParams::Instance().maxOrbitsToDigitize != -1 ? ((o2::conf::DigiParams::Instance().maxOrbitsToDigitize * 3564 + 2 * 8 - 2) / 8) : -1;
 
-  // ion tail per pad parameters
-  const CalPad* padParams[3] = {nullptr, nullptr, nullptr};
-  auto& cdb = CDBInterface::instance();
-  if (eleParam.doIonTailPerPad) {
-    const auto& itSettings = IonTailSettings::Instance();
-    if (itSettings.padITCorrFile.size()) {
-      cdb.setFEEParamsFromFile(itSettings.padITCorrFile);
-    }
-    padParams[0] = &cdb.getITFraction();
-    padParams[1] = &cdb.getITExpLambda();
-  }
-  if (eleParam.doCommonModePerPad) {
-    padParams[2] = &cdb.getCMkValues();
-  }
-
   const bool needsPrevDigArray = eleParam.doIonTail || eleParam.doIonTailPerPad || eleParam.doSaturationTail;
   const bool needsEmptyTimeBins = needsPrevDigArray || eleParam.doNoiseEmptyPads;
 
@@ -66,7 +104,7 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     mPrevDigArr = std::make_unique<DigitTime::PrevDigitInfoArray>();
   }
 
-  for (auto& time : mTimeBins) {
+  for (size_t iTimeBin = 0; iTimeBin < mNTimeBins; ++iTimeBin) {
     /// the time bins between the last event and the timing of this event are uncorrelated and can be written out
     /// OR the readout is triggered (i.e. not continuous) and we can dump everything in any case, as long it is within one drift time interval
     if (!((nProcessedTimeBins + mFirstTimeBin < eventTimeBin) || !isContinuous || finalFlush)) {
@@ -77,42 +115,37 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
       continue;
     }
 
-    // fill also time bins without signal to get noise, ion tail and saturated signals
-    if (needsEmptyTimeBins && !time) {
-      time = new DigitTime;
-    }
-
     if (maxTimeBinForTimeFrame != -1 && timeBin >= maxTimeBinForTimeFrame) {
       LOG(warn) << "Timebin going beyond timeframe limit .. truncating flush " << timeBin;
       break;
     }
 
-    // fmt::print("Processing secotor: {}, time bin: {}, mFirstTimeBin: {}, dgitTime: {}\n", sector.getSector(), timeBin, mFirstTimeBin, (void*)time);
-
-    if (time) {
+    // fill also time bins without signal to get noise, ion tail and saturated signals
+    const size_t slot = getSlot(iTimeBin);
+    if (needsEmptyTimeBins || mHasSignal[slot]) {
       switch (digitizationMode) {
         case DigitzationMode::FullMode: {
-          time->fillOutputContainer<DigitzationMode::FullMode>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::FullMode>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
         case DigitzationMode::ZeroSuppression: {
-          time->fillOutputContainer<DigitzationMode::ZeroSuppression>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::ZeroSuppression>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
         case DigitzationMode::ZeroSuppressionCMCorr: {
-          time->fillOutputContainer<DigitzationMode::ZeroSuppressionCMCorr>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::ZeroSuppressionCMCorr>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
         case DigitzationMode::SubtractPedestal: {
-          time->fillOutputContainer<DigitzationMode::SubtractPedestal>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::SubtractPedestal>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
         case DigitzationMode::NoSaturation: {
-          time->fillOutputContainer<DigitzationMode::NoSaturation>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::NoSaturation>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
         case DigitzationMode::PropagateADC: {
-          time->fillOutputContainer<DigitzationMode::PropagateADC>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams);
+          fillOutputTimeBin<DigitzationMode::PropagateADC>(output, mcTruth, commonModeOutput, sector, timeBin, slot, debugStream, mPadParams);
           break;
         }
       }
@@ -123,11 +156,120 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   }
 
   if (nProcessedTimeBins > 0) {
+    // the processed time bins are recycled at the end of the ring buffer
+    for (int i = 0; i < nProcessedTimeBins; ++i) {
+      clearSlot(getSlot(i));
+    }
     mFirstTimeBin += nProcessedTimeBins;
-    while (nProcessedTimeBins--) {
-      auto popped = mTimeBins.front();
-      mTimeBins.pop_front();
-      delete popped;
+    mFirstSlot = getSlot(nProcessedTimeBins);
+    mNTimeBins -= nProcessedTimeBins;
+  }
+}
+
+template <DigitzationMode MODE>
+void DigitContainer::fillOutputTimeBin(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput,
+                                       const Sector& sector, TimeBin timeBin, size_t slot, o2::utils::DebugStreamer* debugStream, const CalPad* padParams[3])
+{
+  const auto& eleParam = ParameterElectronics::Instance();
+  SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+  const Mapper& mapper = Mapper::instance();
+  float* charge = mCharge.data() + slot * NPads;
+  const int* firstLabel = mFirstLabel.data() + slot * NPads;
+  const auto& labels = mLabels[slot];
+  auto* prevTime = mPrevDigArr.get();
+
+  // at this point we only have the pure signals from tracks
+  // loop over all pads to calculated ion tail, common mode and ToT for saturated signals
+  std::array<float, GEMSTACKSPERSECTOR> commonMode{};
+  for (size_t iPad = 0; iPad < NPads; ++iPad) {
+    if (prevTime) {
+      auto& prevDigit = (*prevTime)[iPad];
+      if (prevDigit.hasSignal()) {
+        DigitGlobalPad::foldSignal(charge[iPad], prevDigit, sector.getSector(), iPad, timeBin, debugStream, mPadParams);
+      }
+      prevDigit.signal = charge[iPad]; // to make hasSignal() check work in next time bin
+    }
+    const float cmKValue = (padParams[2]) ? padParams[2]->getValue(sector.getSector(), iPad) : 1.f;
+    commonMode[CRU(mPadRegion[iPad]).gemStack()] += charge[iPad] * eleParam.commonModeCoupling * cmKValue; // TODO: Add stack-by-stack variation?
+  }
+
+  // fill common mode output container
+  for (size_t i = 0; i < commonMode.size(); ++i) {
+    commonMode[i] /= static_cast<float>(mapper.getNumberOfPads(GEMstack(i)));
+    if (commonMode[i] > 0.) {
+      commonModeOutput.push_back({commonMode[i], timeBin, static_cast<unsigned char>(i)});
+    }
+  }
+
+  // select the pads to be converted without branching, such that the loop is vectorised
+  size_t nSelected = NPads;
+  if (!eleParam.doNoiseEmptyPads) {
+    nSelected = 0;
+    for (size_t iPad = 0; iPad < NPads; ++iPad) {
+      mSelectedPads[nSelected] = iPad;
+      nSelected += (charge[iPad] > 0.f);
+    }
+  } else {
+    std::iota(mSelectedPads.begin(), mSelectedPads.end(), 0);
+  }
+
+  if (ParameterDetector::Instance().CounterBasedRandom) {
+    sampaProcessing.setNoiseStream(sector.getSector(), timeBin);
+  }
+
+  static thread_local std::vector<std::pair<MCCompLabel, int>> labelCollector; // static workspace container for sorting
+  for (size_t iSelected = 0; iSelected < nSelected; ++iSelected) {
+    const GlobalPadNumber globalPad = mSelectedPads[iSelected];
+    const PrevDigitInfo prevDigit = prevTime ? (*prevTime)[globalPad] : PrevDigitInfo();
+    const CRU cru(sector, mPadRegion[globalPad]);
+    const float cm = commonMode[cru.gemStack()];
+
+    /// The charge accumulated on that pad is converted into ADC counts, saturation of the SAMPA is applied and a Digit
+    /// is created in written out
+    float noise, pedestal;
+    const float adc = sampaProcessing.makeSignal<MODE>(charge[globalPad], cru.sector(), globalPad, cm, pedestal, noise, prevDigit.tot);
+
+    if (debugStream && o2::utils::DebugStreamer::checkStream(o2::utils::StreamFlags::streamDigits)) {
+      int sectorTmp = cru.sector();
+      float adcTmp = adc;
+      float chargeTmp = charge[globalPad];
+      float cmTmp = cm;
+      PrevDigitInfo prevDigitTmp = prevDigit;
+      debugStream->getStreamer() << "digit"
+                                 << "sector=" << sectorTmp
+                                 << "pad=" << globalPad
+                                 << "timeBin=" << timeBin
+                                 << "charge=" << chargeTmp
+                                 << "adc=" << adcTmp
+                                 << "prevDig=" << prevDigitTmp
+                                 << "cm=" << cmTmp
+                                 << "\n";
+    }
+
+    /// only write out the data if there is actually charge on that pad
+    if (adc > 0) {
+      const PadPos pad = mapper.padPos(globalPad);
+      const auto digiPos = output.size();
+      output.emplace_back(cru, adc, pad.getRow(), pad.getPad(), timeBin); /// create Digit and append to container
+
+      // if no label was added the digit is from IT, CM or saturation
+      if (firstLabel[globalPad] == -1) {
+        mcTruth.addNoLabelIndex(digiPos);
+      } else {
+        labelCollector.clear();
+        for (int iLabel = firstLabel[globalPad]; iLabel != -1; iLabel = labels[iLabel].next) {
+          labelCollector.emplace_back(labels[iLabel].label, labels[iLabel].nOccurrences);
+        }
+        if (labelCollector.size() > 1) {
+          /// Sort the MC labels according to their occurrence, starting from the order in which they were added
+          using P = std::pair<MCCompLabel, int>;
+          std::reverse(labelCollector.begin(), labelCollector.end());
+          std::sort(labelCollector.begin(), labelCollector.end(), [](const P& a, const P& b) { return a.second > b.second; });
+        }
+        for (auto& mcLabel : labelCollector) {
+          mcTruth.addElement(digiPos, mcLabel.first); /// add MCTruth output
+        }
+      }
     }
   }
 }
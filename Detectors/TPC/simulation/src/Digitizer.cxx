@@ -41,7 +41,7 @@ Digitizer::Digitizer() = default;
 void Digitizer::init()
 {
   // Calculate distortion lookup tables if initial space-charge density is provided
-  if (mUseSCDistortions) {
+  if (mUseSCDistortions && !mSharedSCDistortions) {
     mSpaceCharge->init();
   }
   auto& gemAmplification = GEMAmplification::instance();
@@ -50,6 +50,7 @@ void Digitizer::init()
   electronTransport.updateParameters(mVDrift);
   auto& sampaProcessing = SAMPAProcessing::instance();
   sampaProcessing.updateParameters(mVDrift);
+  mDigitContainer.updateParameters();
 }
 
 void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
@@ -66,9 +67,14 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
 
+  /// random numbers attached to the electrons, see ParameterDetector::CounterBasedRandom
+  const bool counterBasedRandom = detParam.CounterBasedRandom;
+  const math_utils::Philox::Key key{detParam.RandomSeed, (static_cast<uint32_t>(sourceID) << 24) | (static_cast<uint32_t>(eventID) & 0xffffff)};
+  static thread_local ElectronTransport::ElectronBatch electronBatch;
+
   /// Reserve space in the digit container for the current event
   mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset));
 
@@ -77,6 +83,7 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   for (auto& hitGroup : hits) {
     const int MCTrackID = hitGroup.GetTrackID();
+    const uint32_t groupIndex = &hitGroup - hits.data();
     for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
       const auto& eh = hitGroup.getHit(hitindex);
 
@@ -96,52 +103,56 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
       /// The energy loss stored corresponds to nElectrons
       const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
       const float hitTime = eh.GetTime() * 0.001; /// in us
-      float driftTime = 0.f;
 
       /// TODO: add primary ions to space-charge density
 
-      /// Loop over electrons
-      for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
+      /// counter of the random numbers of the hit: the hits are read from the same branch for both neighbouring sectors
+      math_utils::Philox::Counter counter{};
+      if (counterBasedRandom) {
+        counter = {static_cast<uint32_t>(MCTrackID), (static_cast<uint32_t>(Sector::ToShiftedSector(eh.GetX(), eh.GetY(), eh.GetZ())) << 24) | groupIndex, static_cast<uint32_t>(hitindex), 0};
+      }
 
-        /// Drift and Diffusion
-        const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+      auto processElectron = [&](const GlobalPosition3D& posEleDiff, float driftTime, uint32_t electron) {
         const float eleTime = driftTime + hitTime; /// in us
         if (eleTime >= maxEleTime) {
           // LOG(warning) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
-          continue;
+          return;
         }
         const float absoluteTime = eleTime + mTDriftOffset + (mEventTime - mOutputDigitTimeOffset); /// in us
 
-        /// Attachment
-        if (electronTransport.isElectronAttachment(driftTime)) {
-          continue;
+        /// Attachment, decided together with the drift for counter-based random numbers
+        if (!counterBasedRandom && electronTransport.isElectronAttachment(driftTime)) {
+          return;
         }
 
         /// Remove electrons that end up outside the active volume
         if (std::abs(posEleDiff.Z()) > detParam.TPClength) {
-          continue;
+          return;
         }
 
         /// When the electron is not in the sector we're processing, abandon
         if (mapper.isOutOfSector(posEleDiff, mSector)) {
-          continue;
+          return;
         }
 
         /// Compute digit position and check for validity
         const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
         if (!digiPadPos.isValid()) {
-          continue;
+          return;
         }
 
         /// Remove digits the end up outside the currently produced sector
         if (digiPadPos.getCRU().sector() != mSector) {
-          continue;
+          return;
         }
 
         /// Electron amplification
+        if (counterBasedRandom) {
+          gemAmplification.setRandomStreams(counter, key, electron, amplificationMode);
+        }
         const int nElectronsGEM = gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
         if (nElectronsGEM == 0) {
-          continue;
+          return;
         }
 
         const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
@@ -154,6 +165,22 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
                                    signalArray[i]);
         }
         /// TODO: add ion backflow to space-charge density
+      };
+
+      /// Loop over electrons
+      if (counterBasedRandom) {
+        /// Drift and Diffusion of all electrons of the hit
+        electronTransport.getElectronDrift(posEle, nPrimaryElectrons, counter, key, electronBatch);
+        for (size_t iEle = 0; iEle < electronBatch.size(); ++iEle) {
+          processElectron(GlobalPosition3D(electronBatch.x[iEle], electronBatch.y[iEle], electronBatch.z[iEle]), electronBatch.driftTime[iEle], electronBatch.index[iEle]);
+        }
+      } else {
+        float driftTime = 0.f;
+        for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
+          /// Drift and Diffusion
+          const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+          processElectron(posEleDiff, driftTime, iEle);
+        }
       }
       /// end of loop over electrons
     }
@@ -167,8 +194,15 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
 {
   SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
   mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset), mIsContinuous, finalFlush);
-  // flushing debug output to file
-  if (((finalFlush && mIsContinuous) || (!mIsContinuous)) && mSpaceCharge) {
+  // flushing debug output to file, the threads sharing the distortions leave it to the owner
+  if (((finalFlush && mIsContinuous) || (!mIsContinuous)) && !mSharedSCDistortions) {
+    flushDebugStreamer();
+  }
+}
+
+void Digitizer::flushDebugStreamer()
+{
+  if (mSpaceCharge) {
     o2::utils::DebugStreamer::instance()->flush();
   }
 }
@@ -176,8 +210,9 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
 void Digitizer::setUseSCDistortions(const SCDistortionType& distortionType, const TH3* hisInitialSCDensity)
 {
   mUseSCDistortions = true;
-  if (!mSpaceCharge) {
-    mSpaceCharge = std::make_unique<SC>();
+  if (!mSpaceCharge || mSharedSCDistortions) {
+    mSpaceCharge = std::make_shared<SC>();
+    mSharedSCDistortions = false;
   }
   mSpaceCharge->setSCDistortionType(distortionType);
   if (hisInitialSCDensity) {
@@ -189,14 +224,23 @@ void Digitizer::setUseSCDistortions(const SCDistortionType& distortionType, cons
 void Digitizer::setUseSCDistortions(SC* spaceCharge)
 {
   mUseSCDistortions = true;
+  mSharedSCDistortions = false;
   mSpaceCharge.reset(spaceCharge);
 }
 
+void Digitizer::setUseSCDistortions(const Digitizer& other)
+{
+  mUseSCDistortions = other.mUseSCDistortions;
+  mSharedSCDistortions = true;
+  mSpaceCharge = other.mSpaceCharge;
+}
+
 void Digitizer::setUseSCDistortions(std::string_view finp)
 {
   mUseSCDistortions = true;
-  if (!mSpaceCharge) {
-    mSpaceCharge = std::make_unique<SC>();
+  if (!mSpaceCharge || mSharedSCDistortions) {
+    mSpaceCharge = std::make_shared<SC>();
+    mSharedSCDistortions = false;
   }
 
   // in case analytical distortions are loaded from file they are applied
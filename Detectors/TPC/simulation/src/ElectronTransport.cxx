@@ -24,6 +24,11 @@ using namespace o2::math_utils;
 ElectronTransport::ElectronTransport() : mRandomGaus(), mRandomFlat(RandomRing<>::RandomType::Flat)
 {
   updateParameters();
+  /// the content of the rings must not depend on the thread or on the state of gRandom either
+  if (mDetParam->CounterBasedRandom) {
+    mRandomGaus.initialize(RandomRing<>::RandomType::Gaus, {mDetParam->RandomSeed, static_cast<uint32_t>(RandomStream::TransportGaus)});
+    mRandomFlat.initialize(RandomRing<>::RandomType::Flat, {mDetParam->RandomSeed, static_cast<uint32_t>(RandomStream::TransportFlat)});
+  }
 }
 
 void ElectronTransport::updateParameters(float vdrift)
@@ -65,6 +70,53 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
   return posEleDiffusion;
 }
 
+void ElectronTransport::getElectronDrift(GlobalPosition3D posEle, int nElectrons, Philox::Counter counter, const Philox::Key& key, ElectronBatch& batch) const
+{
+  /// For drift lengths shorter than 1 mm, the drift length is set to that value
+  float driftl = mDetParam->TPClength - std::abs(posEle.Z());
+  if (driftl < 0.01) {
+    driftl = 0.01;
+  }
+  driftl = std::sqrt(driftl);
+  const float sigT = driftl * mGasParam->DiffT;
+  const float sigL = driftl * mGasParam->DiffL;
+  const float attachmentPerTime = mGasParam->AttCoeff * mGasParam->OxygenCont;
+  const float zEle = posEle.Z();
+
+  batch.resize(nElectrons);
+  float* x = batch.x.data();
+  float* y = batch.y.data();
+  float* z = batch.z.data();
+  float* driftTime = batch.driftTime.data();
+  uint32_t* index = batch.index.data();
+
+  /// The diffusion is computed for all electrons first, without branches, and the attached electrons are removed
+  /// in a second pass
+  for (int i = 0; i < nElectrons; ++i) {
+    counter[3] = static_cast<uint32_t>(i) << 2; // stream 0 of the electron
+    const auto random = Philox::generate(counter, key);
+    x[i] = mRandomGaus.getValue(random[0]) * sigT + posEle.X();
+    y[i] = mRandomGaus.getValue(random[1]) * sigT + posEle.Y();
+    z[i] = mRandomGaus.getValue(random[2]) * sigL + zEle;
+    driftTime[i] = Philox::toFlat(random[3]); // temporarily the random number for the attachment
+  }
+
+  size_t nKept = 0;
+  for (int i = 0; i < nElectrons; ++i) {
+    /// A sign change in the z position elongates the drift time, see getElectronDrift() above
+    const bool sideChange = zEle / z[i] < 0.f;
+    const float time = getDriftTime(z[i], sideChange ? -1.f : 1.f);
+    const bool attached = driftTime[i] < attachmentPerTime * time;
+    x[nKept] = x[i];
+    y[nKept] = y[i];
+    z[nKept] = sideChange ? zEle : z[i];
+    driftTime[nKept] = time;
+    index[nKept] = i;
+    nKept += !attached;
+  }
+  batch.resize(nKept);
+}
+
 bool ElectronTransport::isCompletelyOutOfSectorCoarseElectronDrift(GlobalPosition3D posEle, const Sector& sector) const
 {
   /// For drift lengths shorter than 1 mm, the drift length is set to that value
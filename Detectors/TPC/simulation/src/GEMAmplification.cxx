@@ -18,6 +18,7 @@
 #include "MathUtils/CachingTF1.h"
 #include <TFile.h>
 #include "TPCBase/CDBInterface.h"
+#include "TPCBase/ParameterDetector.h"
 #include <fstream>
 #include "Framework/Logger.h"
 #include <filesystem>
@@ -33,6 +34,15 @@ GEMAmplification::GEMAmplification()
 {
   updateParameters();
 
+  /// the content of the rings must not depend on the thread or on the state of gRandom either
+  const auto& detParam = ParameterDetector::Instance();
+  const bool counterBasedRandom = detParam.CounterBasedRandom;
+  auto makeKey = [&detParam](uint32_t stream) { return Philox::Key{detParam.RandomSeed, stream}; };
+  if (counterBasedRandom) {
+    mRandomGaus.initialize(RandomRing<>::RandomType::Gaus, makeKey(static_cast<uint32_t>(RandomStream::GEMGaus)));
+    mRandomFlat.initialize(RandomRing<>::RandomType::Flat, makeKey(static_cast<uint32_t>(RandomStream::GEMFlat)));
+  }
+
   TStopwatch watch;
   watch.Start();
   const float sigmaOverMu = mGasParam->SigmaOverMu;
@@ -65,7 +75,11 @@ GEMAmplification::GEMAmplification()
       polyaDistribution = (o2::math_utils::CachingTF1*)outfile->Get(TString::Format("func%d", i).Data());
       // FIXME: verify that distribution corresponds to the parameters used here
     }
-    mGain[i].initialize(*polyaDistribution);
+    if (counterBasedRandom) {
+      mGain[i].initialize(*polyaDistribution, makeKey(static_cast<uint32_t>(RandomStream::GEMGain) + i));
+    } else {
+      mGain[i].initialize(*polyaDistribution);
+    }
 
     if (!cacheexists) {
       outfile->WriteTObject(polyaDistribution, TString::Format("func%d", i).Data());
@@ -88,7 +102,11 @@ GEMAmplification::GEMAmplification()
   } else {
     polyaDistribution = (o2::math_utils::CachingTF1*)outfile->Get("polyaStack");
   }
-  mGainFullStack.initialize(*polyaDistribution);
+  if (counterBasedRandom) {
+    mGainFullStack.initialize(*polyaDistribution, makeKey(static_cast<uint32_t>(RandomStream::GEMGainStack)));
+  } else {
+    mGainFullStack.initialize(*polyaDistribution);
+  }
 
   if (!cacheexists) {
     outfile->WriteTObject(polyaDistribution, "polyaStack");
@@ -110,6 +128,25 @@ void GEMAmplification::updateParameters()
   mGainMap = &(cdb.getGainMap());
 }
 
+void GEMAmplification::setRandomStreams(Philox::Counter counter, const Philox::Key& key, uint32_t electron, const AmplificationMode mode)
+{
+  // streams 1 and 2 of the electron, stream 0 is used by the electron transport
+  counter[3] = (electron << 2) | 1;
+  const auto random = Philox::generate(counter, key);
+  mRandomGaus.setRingPosition(random[0]);
+  mRandomFlat.setRingPosition(random[1]);
+  mGainFullStack.setRingPosition(random[2]);
+  mGain[0].setRingPosition(random[3]);
+  if (mode != AmplificationMode::FullMode) {
+    return;
+  }
+  counter[3] = (electron << 2) | 2;
+  const auto randomGain = Philox::generate(counter, key);
+  for (int i = 1; i < 4; ++i) {
+    mGain[i].setRingPosition(randomGain[i]);
+  }
+}
+
 int GEMAmplification::getStackAmplification(int nElectrons)
 {
   /// We start with an arbitrary number of electrons given to the first amplification stage
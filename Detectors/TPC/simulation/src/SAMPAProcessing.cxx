@@ -27,6 +27,16 @@ using namespace o2::tpc;
 SAMPAProcessing::SAMPAProcessing() : mRandomNoiseRing()
 {
   updateParameters();
+  /// the content of the ring must not depend on the thread or on the state of gRandom either
+  if (mDetParam->CounterBasedRandom) {
+    mRandomNoiseRing.initialize(math_utils::RandomRing<>::RandomType::Gaus, {mDetParam->RandomSeed, static_cast<uint32_t>(RandomStream::Noise)});
+  }
+}
+
+void SAMPAProcessing::setNoiseStream(const int sector, const TimeBin timeBin)
+{
+  const auto random = math_utils::Philox::generate({static_cast<uint32_t>(timeBin), static_cast<uint32_t>(sector), 0, 0}, {mDetParam->RandomSeed, static_cast<uint32_t>(RandomStream::NoisePosition)});
+  mRandomNoiseRing.setRingPosition(random[0]);
 }
 
 void SAMPAProcessing::updateParameters(float vdrift)
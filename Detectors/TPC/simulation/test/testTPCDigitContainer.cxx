@@ -167,5 +167,42 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the DigitContainer
+/// Digits are added and written out in several steps in continuous mode, beyond the initial size of the container,
+/// and we check that the time bins which are reused do not keep charge or MC labels of the previous ones
+BOOST_AUTO_TEST_CASE(DigitContainer_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString(fmt::format("TPCEleParam.DigiMode={}", (int)o2::tpc::DigitzationMode::PropagateADC)); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer digitContainer;
+  digitContainer.reset();
+
+  const GlobalPadNumber globalPad = mapper.getPadNumberInROC(PadROCPos(CRU(0).roc(), PadPos(12, 1)));
+  const std::vector<TimeBin> Time = {10, 1000, 5000};
+  const std::vector<int> MCtrack = {22, 3, 4};
+  const std::vector<int> nEle = {60, 100, 250};
+
+  for (size_t i = 0; i < Time.size(); ++i) {
+    digitContainer.reserve(Time[i]);
+    digitContainer.addDigit(MCCompLabel(MCtrack[i], 1, 0, false), 0, Time[i], globalPad, nEle[i]);
+
+    std::vector<Digit> digits;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    dataformats::MCTruthContainer<MCCompLabel> mcTruth;
+    const bool finalFlush = (i == Time.size() - 1);
+    const TimeBin nextTime = finalFlush ? 0 : Time[i + 1];
+    digitContainer.fillOutputContainer(digits, mcTruth, commonMode, 0, nextTime, true, finalFlush);
+
+    BOOST_CHECK(digits.size() == 1);
+    BOOST_CHECK(digits[0].getTimeStamp() == Time[i]);
+    BOOST_CHECK_CLOSE(digits[0].getChargeFloat(), nEle[i], 1E-6);
+    const auto mcArray = mcTruth.getLabels(0);
+    BOOST_CHECK(mcArray.size() == 1);
+    BOOST_CHECK(mcArray[0].getTrackID() == MCtrack[i]);
+  }
+}
 } // namespace tpc
 } // namespace o2
@@ -0,0 +1,167 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCDigitizerThreads.cxx
+/// \brief This task tests that the digits do not depend on the number of threads with counter-based random numbers
+
+#define BOOST_TEST_MODULE Test TPC DigitizerThreads
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "TROOT.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include "DataFormatsTPC/Digit.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include "TPCBase/CDBInterface.h"
+#include "TPCSimulation/Digitizer.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+static constexpr int NSECTORS = 4; // hits spread over the first sectors of the A side
+static constexpr int NTHREADS = 2;
+
+/// tracks crossing the first NSECTORS sectors, including the sector boundaries
+std::vector<HitGroup> makeHits()
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> flat(0.f, 1.f);
+  std::vector<HitGroup> hits;
+  for (int track = 0; track < 50; ++track) {
+    auto& group = hits.emplace_back(track);
+    const float phi = flat(generator) * NSECTORS * float(M_PI) / 9.f;
+    const float z = 10.f + 230.f * flat(generator);
+    for (int hit = 0; hit < 20; ++hit) {
+      const float radius = 90.f + 7.5f * hit;
+      group.addHit(radius * std::cos(phi), radius * std::sin(phi), z, 0.f, 30);
+    }
+  }
+  return hits;
+}
+
+std::vector<Digit> digitizeSector(Digitizer& digitizer, const std::vector<HitGroup>& hits, int sector, std::mutex& initMutex)
+{
+  {
+    // the initialisation accesses the CDB, as in the digitizer workflow it is serialized
+    std::lock_guard<std::mutex> lock(initMutex);
+    digitizer.setSector(sector);
+    digitizer.init();
+    digitizer.setOutputDigitTimeOffset(0.);
+    digitizer.setStartTime(0.);
+  }
+  digitizer.setEventTime(0.);
+  digitizer.process(hits, 0, 0);
+  std::vector<Digit> digits;
+  dataformats::MCTruthContainer<MCCompLabel> labels;
+  std::vector<CommonMode> commonMode;
+  digitizer.flush(digits, labels, commonMode, true);
+  return digits;
+}
+
+void setup()
+{
+  ROOT::EnableThreadSafety();
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString("TPCDetParam.CounterBasedRandom=true;TPCDetParam.RandomSeed=7");
+}
+
+std::vector<std::vector<Digit>> digitizeSequential(const std::vector<HitGroup>& hits)
+{
+  std::mutex initMutex;
+  std::vector<std::vector<Digit>> digits(NSECTORS);
+  Digitizer digitizer;
+  digitizer.setContinuousReadout(true);
+  for (int sector = 0; sector < NSECTORS; ++sector) {
+    digits[sector] = digitizeSector(digitizer, hits, sector, initMutex);
+  }
+  return digits;
+}
+
+/// the threads process the sectors in the reverse order, optionally with the setup of an owning digitizer as in the
+/// digitizer workflow with TPCthreads > 1
+std::vector<std::vector<Digit>> digitizeThreads(const std::vector<HitGroup>& hits, const Digitizer* owner)
+{
+  std::mutex initMutex;
+  std::vector<std::vector<Digit>> digits(NSECTORS);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < NTHREADS; ++thread) {
+    threads.emplace_back([&hits, &initMutex, &digits, owner, thread]() {
+      Digitizer threadDigitizer;
+      if (owner) {
+        threadDigitizer.setUseSCDistortions(*owner);
+      }
+      threadDigitizer.setContinuousReadout(true);
+      for (int sector = NSECTORS - 1 - thread; sector >= 0; sector -= NTHREADS) {
+        digits[sector] = digitizeSector(threadDigitizer, hits, sector, initMutex);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return digits;
+}
+
+/// \brief Digitize the same hits in one thread and in NTHREADS threads processing the sectors in a different order
+BOOST_AUTO_TEST_CASE(DigitizerThreads_test)
+{
+  setup();
+  const auto hits = makeHits();
+  const auto digitsSequential = digitizeSequential(hits);
+  const auto digitsThreads = digitizeThreads(hits, nullptr);
+
+  for (int sector = 0; sector < NSECTORS; ++sector) {
+    const auto& sequential = digitsSequential[sector];
+    const auto& threaded = digitsThreads[sector];
+    BOOST_CHECK(!sequential.empty());
+    BOOST_REQUIRE_EQUAL(sequential.size(), threaded.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+      BOOST_CHECK_EQUAL(sequential[i].getCRU(), threaded[i].getCRU());
+      BOOST_CHECK_EQUAL(sequential[i].getRow(), threaded[i].getRow());
+      BOOST_CHECK_EQUAL(sequential[i].getPad(), threaded[i].getPad());
+      BOOST_CHECK_EQUAL(sequential[i].getTimeStamp(), threaded[i].getTimeStamp());
+      BOOST_CHECK_EQUAL(sequential[i].getChargeFloat(), threaded[i].getChargeFloat());
+    }
+  }
+}
+
+/// \brief Same number of digits per sector with the setup of the digitizer workflow with TPCthreads > 1: the digitizer
+/// of the task only keeps the shared setup and releases its digit container
+BOOST_AUTO_TEST_CASE(DigitizerSharedSetup_test)
+{
+  setup();
+  const auto hits = makeHits();
+  const auto digitsSequential = digitizeSequential(hits);
+
+  Digitizer owner;
+  owner.setContinuousReadout(true);
+  owner.releaseDigitContainer();
+  owner.init();
+  const auto digitsThreads = digitizeThreads(hits, &owner);
+  owner.flushDebugStreamer();
+
+  for (int sector = 0; sector < NSECTORS; ++sector) {
+    BOOST_CHECK(!digitsSequential[sector].empty());
+    BOOST_CHECK_EQUAL(digitsSequential[sector].size(), digitsThreads[sector].size());
+  }
+}
+
+} // namespace tpc
+} // namespace o2
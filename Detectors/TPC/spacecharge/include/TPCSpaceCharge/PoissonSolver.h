@@ -241,6 +241,16 @@ class PoissonSolver
   void relax3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2, const DataT tempRatioZ,
                const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const;
 
+  /// Red-black Gauss-Seidel relaxation of the points of one colour of a phi slice
+  ///
+  /// All the neighbours of the relaxed points have the other colour, so that the slices can be processed in any order
+  ///
+  /// \param m index of the phi slice
+  /// \param msw 1 for the first pass, 2 for the second one
+  void relax3DSlice(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2, const DataT tempRatioZ,
+                    const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4,
+                    const int m, const int msw) const;
+
   /// Relax2D
   ///
   ///    Relaxation operation for multiGrid
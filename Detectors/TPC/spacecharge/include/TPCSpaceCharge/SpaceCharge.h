@@ -281,6 +281,16 @@ class SpaceCharge
   /// \param otherSC other space-charge object, which charge will be added to current object
   void addChargeDensity(const SpaceCharge<DataT>& otherSC);
 
+  /// incremental update of the distortions and corrections for a small change of the space-charge density (e.g. from IDC fluctuations).
+  /// The multigrid is warm-started from the previous potential and the electric fields, local and global distortions/corrections are only recalculated for the phi slices affected by the change of the potential.
+  /// If no previous potential and global corrections are set, the full calculation is performed.
+  /// \param deltaDensity change of the space-charge density which is added to the current density
+  /// \param side side of the TPC
+  /// \param minDeltaPotential phi slices in which the potential changed by less than this value are not recalculated
+  /// \param calcVectors set to calculate also the local distortion and local correction vectors
+  /// \param stoppingConvergence stopping criterion used in the poisson solver
+  void updateDistortionsCorrections(const DataContainer& deltaDensity, const Side side, const DataT minDeltaPotential = 1e-3, const bool calcVectors = false, const DataT stoppingConvergence = 1e-6);
+
   /// step 3: calculate the local distortions and corrections with an electric field
   /// \param type calculate local corrections or local distortions: type = o2::tpc::SpaceCharge<>::Type::Distortions or o2::tpc::SpaceCharge<>::Type::Corrections
   /// \param formulaStruct struct containing a method to evaluate the electric field Er, Ez, Ephi (analytical formula or by TriCubic interpolator)
@@ -345,6 +355,8 @@ class SpaceCharge
 
   const auto& getPotential(const Side side) const& { return mPotential[side]; }
 
+  const auto& getDensity(const Side side) const& { return mDensity[side]; }
+
   /// get the space charge density for given coordinate
   /// \param z global z coordinate
   /// \param r global r coordinate
@@ -1110,6 +1122,8 @@ class SpaceCharge
   DataContainer mElectricFieldEz[FNSIDES]{};   ///< data storage for the electric field Ez
   DataContainer mElectricFieldEphi[FNSIDES]{}; ///< data storage for the electric field Ephi
 
+  std::vector<char> mUpdatePhiSlices[FNSIDES]{}; ///<! phi slices which are recalculated during an incremental update (all if empty)
+
   TriCubic mInterpolatorPotential[FNSIDES]{{mPotential[Side::A], mGrid3D[Side::A]}, {mPotential[Side::C], mGrid3D[Side::C]}};                                                                                                                                                                 ///<! interpolator for the potenial
   TriCubic mInterpolatorDensity[FNSIDES]{{mDensity[Side::A], mGrid3D[Side::A]}, {mDensity[Side::C], mGrid3D[Side::C]}};                                                                                                                                                                       ///<! interpolator for the charge
   DistCorrInterpolator<DataT> mInterpolatorGlobalCorr[FNSIDES]{{mGlobalCorrdR[Side::A], mGlobalCorrdZ[Side::A], mGlobalCorrdRPhi[Side::A], mGrid3D[Side::A], Side::A}, {mGlobalCorrdR[Side::C], mGlobalCorrdZ[Side::C], mGlobalCorrdRPhi[Side::C], mGrid3D[Side::C], Side::C}};               ///<! interpolator for the global corrections
@@ -1128,6 +1142,15 @@ class SpaceCharge
 
   static int getSign(const Side side) { return side == Side::C ? -1 : 1; }
 
+  /// \return returns true if the phi slice has to be calculated (always the case outside of an incremental update)
+  bool isPhiSliceUpdated(const size_t iPhi, const Side side) const { return mUpdatePhiSlices[side].empty() || mUpdatePhiSlices[side][iPhi]; }
+
+  /// extend the phi slices flagged for the incremental update by nSlices in both directions
+  void dilateUpdatedPhiSlices(const Side side, const int nSlices);
+
+  /// steps 2 to 4: calculate the electric fields, local and global distortions and corrections from the current potential
+  void calcDistortionsCorrectionsFromPotential(const Side side, const bool calcVectors);
+
   /// get inverse spacing in z direction
   DataT getInvSpacingZ(const Side side) const { return mGrid3D[side].getInvSpacingZ(); }
 
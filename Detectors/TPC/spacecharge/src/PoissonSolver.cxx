@@ -1222,50 +1222,20 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
+    // the points of a colour have only neighbours of the other colour, hence the phi slices can be relaxed in parallel.
+    // Exception: with periodic phi and an odd number of slices the first and the last slices are of the same colour,
+    // the last one is relaxed after the others as in the sequential sweep
+    const int nPhiParallel = (symmetry == 0 && (iPhi % 2)) ? iPhi - 1 : iPhi;
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
-        const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
-        }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
-        }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end mParamGrid.NRVertices
-      }     // end phi
-    }       // end sweep
+#pragma omp parallel for num_threads(sNThreads)
+      for (int m = 0; m < nPhiParallel; ++m) {
+        relax3DSlice(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4, m, msw);
+      }
+      if (nPhiParallel < iPhi) {
+        relax3DSlice(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4, iPhi - 1, msw);
+      }
+    } // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1314,6 +1284,61 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
   }
 }
 
+template <typename DataT>
+void PoissonSolver<DataT>::relax3DSlice(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2, const DataT tempRatioZ,
+                                        const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4,
+                                        const int m, const int msw) const
+{
+  const int jsw = ((msw + m) % 2) ? 1 : 2;
+  int mp1 = m + 1;
+  int signPlus = 1;
+  int mm1 = m - 1;
+  int signMinus = 1;
+  // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+  if (symmetry == 1) {
+    if (mp1 > iPhi - 1) {
+      mp1 = iPhi - 2;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+    }
+  }
+  // Anti-symmetry in phi
+  else if (symmetry == -1) {
+    if (mp1 > iPhi - 1) {
+      mp1 = iPhi - 2;
+      signPlus = -1;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+      signMinus = -1;
+    }
+  } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+    if (mp1 > iPhi - 1) {
+      mp1 = m + 1 - iPhi;
+    }
+    if (mm1 < 0) {
+      mm1 = m - 1 + iPhi;
+    }
+  }
+  const DataT* c1 = coefficient1.data();
+  const DataT* c2 = coefficient2.data();
+  const DataT* c3 = coefficient3.data();
+  const DataT* c4 = coefficient4.data();
+  int isw = jsw;
+  for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+    DataT* v = &matricesCurrentV(0, j, m);
+    const DataT* vZm1 = &matricesCurrentV(0, j - 1, m);
+    const DataT* vZp1 = &matricesCurrentV(0, j + 1, m);
+    const DataT* vPhip1 = &matricesCurrentV(0, j, mp1);
+    const DataT* vPhim1 = &matricesCurrentV(0, j, mm1);
+    const DataT* charge = &matricesCurrentCharge(0, j, m);
+    for (int i = isw; i < tnRRow - 1; i += 2) {
+      v[i] = (c2[i] * v[i - 1] + tempRatioZ * (vZm1[i] + vZp1[i]) + c1[i] * v[i + 1] + c3[i] * (signPlus * vPhip1[i] + signMinus * vPhim1[i]) + (h2 * charge[i])) * c4[i];
+    }
+  }
+}
+
 template <typename DataT>
 void PoissonSolver<DataT>::relax2D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const DataT h2, const DataT tempFourth, const DataT tempRatio,
                                    std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2)
@@ -141,7 +141,96 @@ void SpaceCharge<DataT>::calculateDistortionsCorrections(const o2::tpc::Side sid
   auto startTotal = timer::now();
 
   poissonSolver(side);
+  calcDistortionsCorrectionsFromPotential(side, calcVectors);
+
+  auto stop = timer::now();
+  std::chrono::duration<float> time = stop - startTotal;
+  LOGP(info, "everything is done. Total Time: {}", time.count());
+}
+
+template <typename DataT>
+void SpaceCharge<DataT>::updateDistortionsCorrections(const DataContainer& deltaDensity, const Side side, const DataT minDeltaPotential, const bool calcVectors, const DataT stoppingConvergence)
+{
+  using timer = std::chrono::high_resolution_clock;
+  initContainer(mDensity[side], true);
+  if (deltaDensity.getNDataPoints() != mDensity[side].getNDataPoints()) {
+    LOGP(warning, "Change of the space-charge density has different grid definition");
+    return;
+  }
+  mDensity[side] += deltaDensity;
+
+  // without previous solution there is nothing to start from
+  if (!mPotential[side].getNDataPoints() || !mGlobalCorrdR[side].getNDataPoints()) {
+    LOGP(info, "no previous potential or global corrections set: performing full calculation");
+    calculateDistortionsCorrections(side, calcVectors);
+    return;
+  }
+
+  auto startTotal = timer::now();
+  const DataContainer potentialPrev = mPotential[side];
+
+  // the V-cycle starts from the current potential, whereas the F-cycle would start from the solution on the coarsest grid
+  const auto cycleType = MGParameters::cycleType;
+  MGParameters::cycleType = CycleType::VCycle;
+  poissonSolver(side, stoppingConvergence);
+  MGParameters::cycleType = cycleType;
+
+  // flag the phi slices in which the potential changed
+  auto& updatePhiSlices = mUpdatePhiSlices[side];
+  updatePhiSlices.assign(mParamGrid.NPhiVertices, 0);
+#pragma omp parallel for num_threads(sNThreads)
+  for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    for (size_t iR = 0; iR < mParamGrid.NRVertices && !updatePhiSlices[iPhi]; ++iR) {
+      for (size_t iZ = 0; iZ < mParamGrid.NZVertices; ++iZ) {
+        if (std::abs(mPotential[side](iZ, iR, iPhi) - potentialPrev(iZ, iR, iPhi)) > minDeltaPotential) {
+          updatePhiSlices[iPhi] = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  const auto nUpdated = std::count(updatePhiSlices.begin(), updatePhiSlices.end(), 1);
+  LOGP(info, "potential changed in {} of {} phi slices", nUpdated, mParamGrid.NPhiVertices);
+  if (nUpdated) {
+    calcDistortionsCorrectionsFromPotential(side, calcVectors);
+  }
+  updatePhiSlices.clear();
+
+  auto stop = timer::now();
+  std::chrono::duration<float> time = stop - startTotal;
+  LOGP(info, "incremental update done. Total Time: {}", time.count());
+}
+
+template <typename DataT>
+void SpaceCharge<DataT>::dilateUpdatedPhiSlices(const Side side, const int nSlices)
+{
+  auto& updatePhiSlices = mUpdatePhiSlices[side];
+  if (updatePhiSlices.empty()) {
+    return;
+  }
+  const int nPhi = mParamGrid.NPhiVertices;
+  std::vector<char> dilated(nPhi, 0);
+  for (int iPhi = 0; iPhi < nPhi; ++iPhi) {
+    if (updatePhiSlices[iPhi]) {
+      for (int i = -nSlices; i <= nSlices; ++i) {
+        dilated[(iPhi + i + nPhi) % nPhi] = 1; // phi is periodic
+      }
+    }
+  }
+  updatePhiSlices.swap(dilated);
+}
+
+template <typename DataT>
+void SpaceCharge<DataT>::calcDistortionsCorrectionsFromPotential(const Side side, const bool calcVectors)
+{
+  using timer = std::chrono::high_resolution_clock;
+  using SC = o2::tpc::SpaceCharge<DataT>;
+
+  // during an incremental update the stencils and interpolators of each step extend the set of phi slices which have to be recalculated
+  dilateUpdatedPhiSlices(side, 1);
   calcEField(side);
+  dilateUpdatedPhiSlices(side, 2);
 
   const auto numEFields = getElectricFieldsInterpolator(side);
   if (getGlobalDistType() == SC::GlobalDistType::Standard) {
@@ -170,12 +259,14 @@ void SpaceCharge<DataT>::calculateDistortionsCorrections(const o2::tpc::Side sid
     LOGP(info, "local correction/distortion vector time: {}", time.count());
   }
 
+  dilateUpdatedPhiSlices(side, 2);
   start = timer::now();
   const auto lCorrInterpolator = getLocalCorrInterpolator(side);
   (getGlobalDistCorrMethod() == SC::GlobalDistCorrMethod::LocalDistCorr) ? calcGlobalCorrections(lCorrInterpolator) : calcGlobalCorrections(numEFields);
   stop = timer::now();
   time = stop - start;
   LOGP(info, "global corrections time: {}", time.count());
+  dilateUpdatedPhiSlices(side, 2);
   start = timer::now();
   if (getGlobalDistType() == SC::GlobalDistType::Fast) {
     const auto globalCorrInterpolator = getGlobalCorrInterpolator(side);
@@ -189,10 +280,6 @@ void SpaceCharge<DataT>::calculateDistortionsCorrections(const o2::tpc::Side sid
   stop = timer::now();
   time = stop - start;
   LOGP(info, "global distortions time: {}", time.count());
-
-  stop = timer::now();
-  time = stop - startTotal;
-  LOGP(info, "everything is done. Total Time: {}", time.count());
 }
 
 template <typename DataT>
@@ -567,6 +654,9 @@ void SpaceCharge<DataT>::calcEField(const Side side)
   initContainer(mElectricFieldEphi[side], true);
 #pragma omp parallel for num_threads(sNThreads)
   for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     const int symmetry = 0;
     size_t tmpPlus = iPhi + 1;
     int signPlus = 1;
@@ -655,6 +745,9 @@ void SpaceCharge<DataT>::calcGlobalDistWithGlobalCorrIterative(const DistCorrInt
   initContainer(mGlobalDistdRPhi[side], true);
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     const DataT phi = getPhiVertex(iPhi, side);
     for (unsigned int iR = 0; iR < mParamGrid.NRVertices; ++iR) {
       const DataT radius = getRVertex(iR, side);
@@ -977,6 +1070,9 @@ void SpaceCharge<DataT>::calcLocalDistortionsCorrections(const SpaceCharge<DataT
   // calculate local distortions/corrections for each vertex in the tpc
 #pragma omp parallel for num_threads(sNThreads)
   for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     const DataT phi = getPhiVertex(iPhi, side);
     for (size_t iR = 0; iR < mParamGrid.NRVertices; ++iR) {
       const DataT radius = getRVertex(iR, side);
@@ -1057,6 +1153,9 @@ void SpaceCharge<DataT>::calcLocalDistortionCorrectionVector(const ElectricField
   // calculate local distortion/correction vector for each vertex in the tpc
 #pragma omp parallel for num_threads(sNThreads)
   for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     for (size_t iR = 0; iR < mParamGrid.NRVertices; ++iR) {
       for (size_t iZ = 0; iZ < mParamGrid.NZVertices; ++iZ) {
         const DataT ezField = getEzField(formulaStruct.getSide());
@@ -1222,6 +1321,9 @@ void SpaceCharge<DataT>::calcGlobalDistortions(const Fields& formulaStruct, cons
   // loop over tpc volume and let the electron drift from each vertex to the readout of the tpc
 #pragma omp parallel for num_threads(sNThreads)
   for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     const DataT phi0 = getPhiVertex(iPhi, side);
     for (size_t iR = 0; iR < mParamGrid.NRVertices; ++iR) {
       const DataT r0 = getRVertex(iR, side);
@@ -1309,6 +1411,9 @@ void SpaceCharge<DataT>::calcGlobalCorrections(const Formulas& formulaStruct, co
 // loop over tpc volume and let the electron drift from each vertex to the readout of the tpc
 #pragma omp parallel for num_threads(sNThreads)
   for (size_t iPhi = 0; iPhi < mParamGrid.NPhiVertices; ++iPhi) {
+    if (!isPhiSliceUpdated(iPhi, side)) {
+      continue;
+    }
     const DataT phi0 = getPhiVertex(iPhi, side);
     for (size_t iR = 0; iR < mParamGrid.NRVertices; ++iR) {
 
@@ -0,0 +1,59 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  bench_PoissonSolver.cxx
+/// \brief timing of a single multigrid V-cycle of the 3D poisson solver for different grid sizes and numbers of threads
+
+#include "benchmark/benchmark.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+
+using namespace o2::tpc;
+using DataT = double;
+
+static void BM_PoissonSolverVCycle(benchmark::State& state)
+{
+  const unsigned short nRZ = state.range(0);
+  const unsigned short nPhi = state.range(1);
+  PoissonSolver<DataT>::setNThreads(state.range(2));
+  MGParameters::cycleType = CycleType::VCycle;
+  MGParameters::nMGCycle = 1;
+
+  using GridProp = GridProperties<DataT>;
+  const ParamSpaceCharge params{nRZ, nRZ, nPhi};
+  const RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(nRZ), GridProp::getGridSpacingR(nRZ), GridProp::getGridSpacingPhi(nPhi), params};
+
+  const AnalyticalFields<DataT> analyticalFields;
+  DataContainer3D<DataT> charge(nRZ, nRZ, nPhi);
+  for (size_t iPhi = 0; iPhi < nPhi; ++iPhi) {
+    const DataT phi = grid3D.getPhiVertex(iPhi);
+    for (size_t iR = 0; iR < nRZ; ++iR) {
+      const DataT radius = grid3D.getRVertex(iR);
+      for (size_t iZ = 0; iZ < nRZ; ++iZ) {
+        charge(iZ, iR, iPhi) = analyticalFields.evalDensity(grid3D.getZVertex(iZ), radius, phi);
+      }
+    }
+  }
+
+  for (auto _ : state) {
+    DataContainer3D<DataT> potential(nRZ, nRZ, nPhi);
+    PoissonSolver<DataT> poissonSolver(grid3D);
+    poissonSolver.poissonSolver3D(potential, charge, 0);
+  }
+  state.counters["vertices"] = size_t(nRZ) * nRZ * nPhi;
+}
+
+// grid size in r and z, grid size in phi, number of threads
+BENCHMARK(BM_PoissonSolverVCycle)->ArgsProduct({{33, 65, 129}, {180}, {1, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -198,6 +198,39 @@ void poissonSolver3D()
   testAlmostEqualArray<DataT>(potentialAnalytical, potentialNumerical);
 }
 
+template <typename DataT>
+void poissonSolver3DWarmStart()
+{
+  using GridProp = GridProperties<DataT>;
+  const ParamSpaceCharge params{NR, NZ, NPHI};
+  const o2::tpc::RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(NZ), GridProp::getGridSpacingR(NR), GridProp::getGridSpacingPhi(NPHI), params};
+
+  using DataContainer = o2::tpc::DataContainer3D<DataT>;
+  DataContainer potentialNumerical(NZ, NR, NPHI);
+  DataContainer potentialAnalytical(NZ, NR, NPHI);
+  DataContainer charge(NZ, NR, NPHI);
+
+  const o2::tpc::AnalyticalFields<DataT> analyticalFields;
+  setChargeDensityFromFormula<DataT>(analyticalFields, grid3D, charge);
+  setPotentialBoundaryFromFormula<DataT>(analyticalFields, grid3D, potentialNumerical);
+  setPotentialFromFormula<DataT>(analyticalFields, grid3D, potentialAnalytical);
+
+  // previous solution for a slightly different charge density
+  PoissonSolver<DataT> poissonSolver(grid3D);
+  const int symmetry = 0;
+  DataContainer chargePrev = charge;
+  chargePrev *= 0.9;
+  poissonSolver.poissonSolver3D(potentialNumerical, chargePrev, symmetry);
+
+  // V-cycles starting from the previous solution as done in the incremental update of the space-charge distortions
+  const auto cycleType = MGParameters::cycleType;
+  MGParameters::cycleType = CycleType::VCycle;
+  poissonSolver.poissonSolver3D(potentialNumerical, charge, symmetry);
+  MGParameters::cycleType = cycleType;
+
+  testAlmostEqualArray<DataT>(potentialAnalytical, potentialNumerical);
+}
+
 template <typename DataT>
 void poissonSolver2D()
 {
@@ -238,6 +271,12 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D2D_test)
   poissonSolver3D<DataT>();
 }
 
+BOOST_AUTO_TEST_CASE(PoissonSolver3DWarmStart_test)
+{
+  o2::tpc::MGParameters::isFull3D = true; // 3D
+  poissonSolver3DWarmStart<DataT>();
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver2D_test)
 {
   poissonSolver2D<DataT>();
@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCSpaceChargeUpdate.cxx
+/// \brief this task tests the incremental update of the distortions and corrections against the full calculation
+
+#define BOOST_TEST_MODULE Test TPC O2TPCSpaceChargeUpdate class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "TPCSpaceCharge/SpaceCharge.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+using DataT = double;
+using SC = SpaceCharge<DataT>;
+static constexpr DataT TOLERANCE = 0.05;    // maximum deviation from the full calculation relative to the change caused by the delta density
+static constexpr unsigned short NR = 33;    // grid in r
+static constexpr unsigned short NZ = 33;    // grid in z
+static constexpr unsigned short NPHI = 180; // grid in phi
+static constexpr int BFIELD = 5;            // magnetic field in kG
+
+/// all global corrections and distortions of the given side
+std::vector<DataT> getGlobalDistCorr(const SC& sc, const Side side)
+{
+  std::vector<DataT> values;
+  values.reserve(6 * NZ * NR * NPHI);
+  for (size_t iPhi = 0; iPhi < NPHI; ++iPhi) {
+    for (size_t iR = 0; iR < NR; ++iR) {
+      for (size_t iZ = 0; iZ < NZ; ++iZ) {
+        values.insert(values.end(), {sc.getGlobalCorrR(iZ, iR, iPhi, side), sc.getGlobalCorrZ(iZ, iR, iPhi, side), sc.getGlobalCorrRPhi(iZ, iR, iPhi, side),
+                                     sc.getGlobalDistR(iZ, iR, iPhi, side), sc.getGlobalDistZ(iZ, iR, iPhi, side), sc.getGlobalDistRPhi(iZ, iR, iPhi, side)});
+      }
+    }
+  }
+  return values;
+}
+
+DataT getMaxAbsDiff(const std::vector<DataT>& a, const std::vector<DataT>& b)
+{
+  DataT maxDiff = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+  }
+  return maxDiff;
+}
+
+BOOST_AUTO_TEST_CASE(SpaceChargeUpdate_test)
+{
+  const Side side = Side::A;
+  SC::setGlobalDistType(SC::GlobalDistType::Fast);
+  const AnalyticalFields<DataT> analyticalFields(side);
+
+  SC scUpdate(BFIELD, NZ, NR, NPHI);
+  scUpdate.setChargeDensityFromFormula(analyticalFields);
+  scUpdate.setPotentialBoundaryFromFormula(analyticalFields);
+  scUpdate.calculateDistortionsCorrections(side);
+  const auto distCorrPrev = getGlobalDistCorr(scUpdate, side);
+
+  // local change of the density: +20% in 10 of the phi slices
+  DataContainer3D<DataT> deltaDensity(NZ, NR, NPHI);
+  for (size_t iPhi = 40; iPhi < 50; ++iPhi) {
+    for (size_t iR = 0; iR < NR; ++iR) {
+      for (size_t iZ = 0; iZ < NZ; ++iZ) {
+        deltaDensity(iZ, iR, iPhi) = 0.2 * scUpdate.getDensity(iZ, iR, iPhi, side);
+      }
+    }
+  }
+
+  const auto& potential = scUpdate.getPotential(side);
+  const DataT maxPotential = std::abs(*std::max_element(potential.getData().begin(), potential.getData().end(), [](DataT a, DataT b) { return std::abs(a) < std::abs(b); }));
+  scUpdate.updateDistortionsCorrections(deltaDensity, side, 1e-5 * maxPotential);
+
+  // without previous global corrections the same call performs the full calculation for the summed density
+  SC scFull(BFIELD, NZ, NR, NPHI);
+  scFull.setChargeDensityFromFormula(analyticalFields);
+  scFull.setPotentialBoundaryFromFormula(analyticalFields);
+  scFull.updateDistortionsCorrections(deltaDensity, side);
+
+  const auto distCorrUpdate = getGlobalDistCorr(scUpdate, side);
+  const auto distCorrFull = getGlobalDistCorr(scFull, side);
+  const DataT maxChange = getMaxAbsDiff(distCorrFull, distCorrPrev);
+  BOOST_CHECK(maxChange > 0);
+  BOOST_CHECK_LE(getMaxAbsDiff(distCorrUpdate, distCorrFull), TOLERANCE * maxChange);
+}
+
+} // namespace tpc
+} // namespace o2
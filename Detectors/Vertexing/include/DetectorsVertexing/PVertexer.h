@@ -16,6 +16,7 @@
 #ifndef O2_PVERTEXER_H
 #define O2_PVERTEXER_H
 
+#include <algorithm>
 #include <array>
 #include <utility>
 #include "CommonConstants/LHCConstants.h"
@@ -82,6 +83,8 @@ class PVertexer
   void setBz(float bz) { mBz = bz; }
   void setValidateWithIR(bool v) { mValidateWithIR = v; }
   bool getValidateWithIR() const { return mValidateWithIR; }
+  void setDBScanUseZIndex(bool v) { mDBScanUseZIndex = v; } ///< if false, search the DBScan neighbours by the brute-force scan of the pool
+  bool getDBScanUseZIndex() const { return mDBScanUseZIndex; }
 
   auto& getTracksPool() const { return mTracksPool; }
   auto& getTimeZClusters() const { return mTimeZClusters; }
@@ -155,6 +158,8 @@ class PVertexer
 
   int dbscan_RangeQuery(int idxs, std::vector<int>& cand, std::vector<int>& status);
   void dbscan_clusterize();
+  void dbscan_buildZIndex();
+  int dbscan_getZBin(float z) const { return std::clamp(int((z - mDBSZMin) * mDBSZBinWidthInv), 0, mDBSNZBins - 1); }
   void doDBScanDump(const VertexingInput& input, gsl::span<const o2::MCCompLabel> lblTracks);
   void doVtxDump(std::vector<PVertex>& vertices, std::vector<uint32_t> trackIDsLoc, std::vector<V2TRef>& v2tRefsLoc, gsl::span<const o2::MCCompLabel> lblTracks);
   void doDBGPoolDump(gsl::span<const o2::MCCompLabel> lblTracks);
@@ -173,6 +178,12 @@ class PVertexer
   float mBz = 0.;                           ///< mag.field at beam line
   float mDBScanDeltaT = 0.;                 ///< deltaT cut for DBScan check
   float mDBSMaxZ2InvCorePoint = 0;          ///< inverse of max sigZ^2 of the track which can be core point in the DBScan
+  float mDBSZMin = 0.;                      ///< lower Z of the DBScan Z-strips index
+  float mDBSZBinWidthInv = 1.;              ///< inverse width of the DBScan Z-strip
+  int mDBSNZBins = 1;                       ///< number of DBScan Z-strips
+  std::vector<int> mDBSZIndexRef;           ///< start of every Z-strip in mDBSZIndex (+ the end of the last one)
+  std::vector<int> mDBSZIndex;              ///< time-ordered tracks which may neighbour the DBScan points in every Z-strip
+  bool mDBScanUseZIndex = true;             ///< use the Z-strips index for the DBScan neighbours search
   bool mValidateWithIR = false;             ///< require vertex validation with InteractionRecords (if available)
 
   o2::InteractionRecord mStartIR{0, 0}; ///< IR corresponding to the start of the TF
@@ -38,6 +38,7 @@ struct PVertexerParams : public o2::conf::ConfigurableParamHelper<PVertexerParam
   int maxVerticesPerCluster = 10; ///< max vertices per time-z cluster to look for
   int maxTrialsPerCluster = 100;  ///< max unsucessful trials for vertex search per vertex
   long maxTimeMSPerCluster = 10000; ///< max allowed time per TZCluster processing, ms
+  int nThreads = 1;                 ///< number of threads fitting the time-z clusters concurrently
 
   // track selection
   float meanVertexExtraErrSelection = 0.02; ///< extra error to meanvertex sigma used when selecting tracks
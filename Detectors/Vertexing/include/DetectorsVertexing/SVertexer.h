@@ -117,7 +117,8 @@ class SVertexer
   void initTPCTransform();
 
  private:
-  bool checkV0(const TrackCand& seed0, const TrackCand& seed1, int iP, int iN, int ithread);
+  bool checkV0(const TrackCand& seed0, const TrackCand& seed1, int iP, int iN, int ithread, bool cachedAux = false);
+  void checkV0Batches(const TrackCand& seedP, int iP, int firstN, int ithread);
   int checkCascades(float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   int check3bodyDecays(float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
@@ -142,6 +143,9 @@ class SVertexer
   std::vector<std::vector<DecayNbody>> m3bodyTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  std::array<std::vector<o2::track::TrackAuxPar>, 2> mTracksAux{}; // circle params of the pools tracks, filled for the batched V0 search only
+  std::array<o2::track::TrackCirclesSoA, 2> mTracksCircles{};      // the same in SoA layout
+  std::vector<std::vector<uint8_t>> mV0BatchMask;                   // per thread masks of the preselected V0 pairs of a batch
 
   o2d::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
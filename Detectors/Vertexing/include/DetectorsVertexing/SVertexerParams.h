@@ -46,6 +46,7 @@ struct SVertexerParams : public o2::conf::ConfigurableParamHelper<SVertexerParam
   float minXSeed = -1.;                                                 ///< minimal X of seed in prong frame (within the radial resolution track should not go to negative X)
   bool usePropagator = false;                                           ///< use external propagator
   bool refitWithMatCorr = false;                                        ///< refit V0 applying material corrections
+  int v0BatchSize = 0;                                                  ///< if > 0, preselect the V0 pairs by crossing of their circles in batches of this size
   //
   int maxPVContributors = 2;             ///< max number PV contributors to allow in V0
   float minDCAToPV = 0.05;               ///< min DCA to PV of single track to accept
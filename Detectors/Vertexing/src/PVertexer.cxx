@@ -18,9 +18,14 @@
 #include "Math/SMatrix.h"
 #include "Math/SVector.h"
 #include <unordered_map>
+#include <iterator>
 #include "CommonUtils/StringUtils.h"
 #include <TH2F.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::vertexing;
 
 constexpr float PVertexer::kAlmost0F;
@@ -56,9 +61,24 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
   mTimeVertexing.Start();
-  int cntTZ = 0;
-  for (auto tc : mTimeZClusters) {
-    size_t nnold = verticesLoc.size();
+  // the time-z clusters share no tracks, so they are fitted concurrently to their own outputs, merged then in the clusters order
+  struct ClusterVertices {
+    std::vector<PVertex> vertices;
+    std::vector<uint32_t> trackIDs;
+    std::vector<V2TRef> v2tRefs;
+  };
+  int nClus = mTimeZClusters.size();
+  std::vector<ClusterVertices> clusVertices(nClus);
+#ifdef _PV_DEBUG_TREE_
+  int nThreads = 1; // debug dump is not thread safe
+#else
+  int nThreads = std::max(1, mPVParams->nThreads);
+#endif
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int icl = 0; icl < nClus; icl++) {
+    auto& tc = mTimeZClusters[icl];
     VertexingInput inp;
     inp.idRange = gsl::span<int>(tc.trackIDs);
     inp.scaleSigma2 = mPVParams->iniScale2;
@@ -66,7 +86,20 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
 #ifdef _PV_DEBUG_TREE_
     doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    auto& out = clusVertices[icl];
+    findVertices(inp, out.vertices, out.trackIDs, out.v2tRefs);
+  }
+  for (auto& out : clusVertices) {
+    int vtxOffs = verticesLoc.size(), trOffs = trackIDs.size();
+    for (auto id : out.trackIDs) {
+      mTracksPool[id].vtxID += vtxOffs; // assigned vertex ID was local to the cluster
+    }
+    for (auto ref : out.v2tRefs) {
+      ref.setFirstEntry(ref.getFirstEntry() + trOffs);
+      v2tRefsLoc.push_back(ref);
+    }
+    verticesLoc.insert(verticesLoc.end(), out.vertices.begin(), out.vertices.end());
+    trackIDs.insert(trackIDs.end(), out.trackIDs.begin(), out.trackIDs.end());
   }
   mTimeVertexing.Stop();
   // sort in time
@@ -203,19 +236,27 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
     auto clTime = tCurr - tStart;
     if (clTime > mPVParams->maxTimeMSPerCluster) {
       LOGP(warn, "Time per TZ-cluster ({}ms) of {} tracks exceeded limit after {} trials, abandon", clTime, mult, nTrials);
+#ifdef WITH_OPENMP
+#pragma omp critical(PVertexerDumpPool)
+#endif
       if (!mPoolDumpProduced) {
         dumpPool();
       }
       break;
     }
   }
-  mTotTrials += nTrials;
-  if (size_t(nTrials) > mMaxTrialPerCluster) {
-    mMaxTrialPerCluster = nTrials;
-  }
-  if (tCurr - tStart > mLongestClusterTimeMS) {
-    mLongestClusterTimeMS = tCurr - tStart;
-    mLongestClusterMult = mult;
+#ifdef WITH_OPENMP
+#pragma omp critical(PVertexerClusterStat)
+#endif
+  {
+    mTotTrials += nTrials;
+    if (size_t(nTrials) > mMaxTrialPerCluster) {
+      mMaxTrialPerCluster = nTrials;
+    }
+    if (tCurr - tStart > mLongestClusterTimeMS) {
+      mLongestClusterTimeMS = tCurr - tStart;
+      mLongestClusterMult = mult;
+    }
   }
   return nfound;
 }
@@ -873,8 +914,6 @@ int PVertexer::dbscan_RangeQuery(int id, std::vector<int>& cand, std::vector<int
   if (tI.sig2ZI < mDBSMaxZ2InvCorePoint) {
     return nFound;
   }
-  int ntr = mTracksPool.size();
-
   auto procPnt = [this, &tI, &status, &cand, &nFound, id](int idN) {
     const auto& tL = this->mTracksPool[idN];
     if (std::abs(tI.timeEst.getTimeStamp() - tL.timeEst.getTimeStamp()) > this->mDBScanDeltaT) {
@@ -894,25 +933,99 @@ int PVertexer::dbscan_RangeQuery(int id, std::vector<int>& cand, std::vector<int
     }
     return 1;
   };
-  int idL = id;
-  while (--idL >= 0) { // index in time decreasing direction
-    if (procPnt(idL) < 0) {
+  if (!mDBScanUseZIndex) { // brute-force scan of the whole pool, the reference for the Z-strips index
+    int idL = id, idU = id, ntr = mTracksPool.size();
+    while (--idL >= 0) { // index in time decreasing direction
+      if (procPnt(idL) < 0) {
+        break;
+      }
+    }
+    while (++idU < ntr) { // index in time increasing direction
+      if (procPnt(idU) < 0) {
+        break;
+      }
+    }
+    return nFound;
+  }
+  // only the tracks of the Z-strip of the point may be its neighbours, they are in the same time order as in the pool
+  int bin = dbscan_getZBin(tI.z);
+  const int *first = mDBSZIndex.data() + mDBSZIndexRef[bin], *last = mDBSZIndex.data() + mDBSZIndexRef[bin + 1];
+  const int* pos = std::lower_bound(first, last, id);
+  for (auto idL = pos; idL-- != first;) { // index in time decreasing direction
+    if (procPnt(*idL) < 0) {
       break;
     }
   }
-  int idU = id;
-  while (++idU < ntr) { // index in time increasing direction
-    if (procPnt(idU) < 0) {
+  for (auto idU = pos; idU != last; idU++) { // index in time increasing direction
+    if (*idU != id && procPnt(*idU) < 0) {
       break;
     }
   }
   return nFound;
 }
 
+//_____________________________________________________
+void PVertexer::dbscan_buildZIndex()
+{
+  // Index the tracks pool in Z-strips for the DBScan neighbours search: since the distance is weighted by the errors of the
+  // neighbour, dz^2*sig2ZI < dbscanMaxDist2, every track is registered in all strips within its own reach in Z.
+  // The neighbours of any point are then found in the strip of this point only.
+  constexpr int MaxZBins = 1024;
+  constexpr float Tolerance = 1e-4; // safety margin for the reach rounding
+  int ntr = mTracksPool.size();
+  mDBSZIndexRef.clear();
+  mDBSZIndex.clear();
+  std::vector<float> reach(ntr);
+  float zMin = 1e9, zMax = -1e9;
+  for (int i = 0; i < ntr; i++) {
+    const auto& trc = mTracksPool[i];
+    zMin = std::min(zMin, trc.z);
+    zMax = std::max(zMax, trc.z);
+    reach[i] = trc.sig2ZI > 0.f ? std::sqrt(std::max(mPVParams->dbscanMaxDist2, 0.f) / trc.sig2ZI) * (1.f + Tolerance) + Tolerance : -1.f; // < 0: reaches everywhere
+  }
+  float binWidth = ntr ? zMax - zMin + 1.f : 1.f;
+  std::vector<float> reachSorted;
+  reachSorted.reserve(ntr);
+  std::copy_if(reach.begin(), reach.end(), std::back_inserter(reachSorted), [](float r) { return r > 0.f; });
+  if (!reachSorted.empty()) { // strips of the typical reach
+    auto median = reachSorted.begin() + reachSorted.size() / 2;
+    std::nth_element(reachSorted.begin(), median, reachSorted.end());
+    binWidth = std::max({*median, (zMax - zMin) / MaxZBins, Tolerance});
+  }
+  mDBSZMin = zMin;
+  mDBSZBinWidthInv = 1.f / binWidth;
+  mDBSNZBins = ntr ? 1 + std::min(int((zMax - zMin) * mDBSZBinWidthInv), MaxZBins) : 1;
+
+  auto getStrips = [this, &reach](int i, int& bin0, int& bin1) {
+    bin0 = reach[i] < 0.f ? 0 : dbscan_getZBin(mTracksPool[i].z - reach[i]);
+    bin1 = reach[i] < 0.f ? mDBSNZBins - 1 : dbscan_getZBin(mTracksPool[i].z + reach[i]);
+  };
+  mDBSZIndexRef.resize(mDBSNZBins + 1, 0);
+  int bin0, bin1;
+  for (int i = 0; i < ntr; i++) {
+    getStrips(i, bin0, bin1);
+    for (int ib = bin0; ib <= bin1; ib++) {
+      mDBSZIndexRef[ib + 1]++;
+    }
+  }
+  std::partial_sum(mDBSZIndexRef.begin(), mDBSZIndexRef.end(), mDBSZIndexRef.begin());
+  mDBSZIndex.resize(mDBSZIndexRef.back());
+  std::vector<int> fill(mDBSZIndexRef.begin(), mDBSZIndexRef.end() - 1);
+  for (int i = 0; i < ntr; i++) { // tracks are registered in time order
+    getStrips(i, bin0, bin1);
+    for (int ib = bin0; ib <= bin1; ib++) {
+      mDBSZIndex[fill[ib]++] = i;
+    }
+  }
+}
+
 //_____________________________________________________
 void PVertexer::dbscan_clusterize()
 {
   mTimeZClusters.clear();
+  if (mDBScanUseZIndex) {
+    dbscan_buildZIndex();
+  }
   int ntr = mTracksPool.size();
   std::vector<int> status(ntr, DBS_UNDEF);
   int clID = -1;
@@ -52,6 +52,13 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // ac
       LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
       continue;
     }
+    if (mSVParams->v0BatchSize > 0) {
+#ifdef WITH_OPENMP
+      iThread = omp_get_thread_num();
+#endif
+      checkV0Batches(seedP, itp, firstN, iThread);
+      continue;
+    }
     for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
       auto& seedN = mTracksPool[NEG][itn];
       if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
@@ -218,6 +225,7 @@ void SVertexer::setupThreads()
   mV0sTmp.resize(mNThreads);
   mCascadesTmp.resize(mNThreads);
   m3bodyTmp.resize(mNThreads);
+  mV0BatchMask.resize(mNThreads);
   mFitterV0.resize(mNThreads);
   auto bz = o2::base::Propagator::Instance()->getNominalBz();
   for (auto& fitter : mFitterV0) {
@@ -392,15 +400,56 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
     }
   }
 
+  if (mSVParams->v0BatchSize > 0) { // cache the circles of the seeds for the batched V0 search
+    float bz = mFitterV0[0].getBz();
+    for (int pn = 0; pn < 2; pn++) {
+      mTracksAux[pn].clear();
+      mTracksCircles[pn].clear();
+      mTracksAux[pn].reserve(mTracksPool[pn].size());
+      mTracksCircles[pn].reserve(mTracksPool[pn].size());
+      for (const auto& t : mTracksPool[pn]) {
+        mTracksCircles[pn].add(mTracksAux[pn].emplace_back(t, bz));
+      }
+    }
+  }
+
   LOG(info) << "Collected " << mTracksPool[POS].size() << " positive and " << mTracksPool[NEG].size() << " negative seeds";
 }
 
 //__________________________________________________________________
-bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
+void SVertexer::checkV0Batches(const TrackCand& seedP, int iP, int firstN, int ithread)
+{
+  // check the negative partners of the positive seed in batches: the pairs whose circles are too far to cross are masked
+  // in a single pass over the circles of the batch, the others are fitted reusing the cached circles
+  const auto& tracksN = mTracksPool[NEG];
+  const auto& auxP = mTracksAux[POS][iP];
+  auto& mask = mV0BatchMask[ithread];
+  float maxDXY = mFitterV0[ithread].getMaxDXYIni();
+  int ntrN = tracksN.size(), batchSize = mSVParams->v0BatchSize;
+  mask.resize(batchSize);
+  for (int itn0 = firstN; itn0 < ntrN; itn0 += batchSize) {
+    int nb = std::min(batchSize, ntrN - itn0);
+    mTracksCircles[NEG].preselectCrossings(auxP, itn0, nb, maxDXY, mask.data());
+    for (int ib = 0; ib < nb; ib++) {
+      int itn = itn0 + ib;
+      const auto& seedN = tracksN[itn];
+      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
+        return;
+      }
+      if (!mask[ib] || (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors)) {
+        continue;
+      }
+      checkV0(seedP, seedN, iP, itn, ithread, true);
+    }
+  }
+}
+
+//__________________________________________________________________
+bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread, bool cachedAux)
 {
 
   auto& fitterV0 = mFitterV0[ithread];
-  int nCand = fitterV0.process(seedP, seedN);
+  int nCand = cachedAux ? fitterV0.processWithAux({&mTracksAux[POS][iP], &mTracksAux[NEG][iN]}, seedP, seedN) : fitterV0.process(seedP, seedN);
   if (nCand == 0) { // discard this pair
     return false;
   }
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testPVertexerDBScan.cxx
+/// \brief Compare the vertices found with the DBScan Z-strips index and with the brute-force scan, with one and several threads
+
+#define BOOST_TEST_MODULE Test PVertexerDBScan
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TGeoGlobalMagField.h>
+#include <TRandom.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+#include "CommonUtils/ConfigurableParam.h"
+#include "DetectorsVertexing/PVertexer.h"
+#include "DetectorsVertexing/PVertexerHelpers.h"
+#include "Field/MagneticField.h"
+#include "ReconstructionDataFormats/Track.h"
+
+using namespace o2::vertexing;
+
+namespace
+{
+constexpr float ITSROFrameLengthMUS = 5.f;
+
+struct Result {
+  std::vector<std::vector<int>> clusters;
+  std::vector<PVertex> vertices;
+  std::vector<o2::dataformats::VtxTrackIndex> vertexTrackIDs;
+  std::vector<V2TRef> v2tRefs;
+};
+
+/// Collisions piling up in time at different Z, with precise and wide tracks in Z and time, and noise tracks
+std::vector<TrackVF> makePool()
+{
+  if (!TGeoGlobalMagField::Instance()->GetField()) { // needed by PVertexer::init
+    auto fld = new o2::field::MagneticField("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+    TGeoGlobalMagField::Instance()->SetField(fld);
+    TGeoGlobalMagField::Instance()->Lock();
+  }
+  gRandom->SetSeed(2024);
+  struct Source {
+    float t, z;
+    bool noise;
+  };
+  std::vector<Source> sources;
+  for (int icoll = 0; icoll < 80; icoll++) {
+    float t = icoll < 40 ? gRandom->Uniform(0., 20.) : gRandom->Uniform(0., 400.), z = gRandom->Gaus(0., 6.);
+    for (int itr = 0, ntr = 2 + gRandom->Poisson(icoll % 4 ? 8 : 40); itr < ntr; itr++) {
+      sources.push_back({t, z, false});
+    }
+  }
+  for (int itr = 0; itr < 300; itr++) {
+    sources.push_back({float(gRandom->Uniform(0., 400.)), float(gRandom->Uniform(-20., 20.)), true});
+  }
+  std::vector<std::pair<TimeEst, o2::track::TrackParCov>> tracks;
+  for (const auto& src : sources) {
+    float sigZ = gRandom->Rndm() < 0.7 ? 0.005 : (gRandom->Rndm() < 0.8 ? 0.2 : 3.), sigT = gRandom->Rndm() < 0.7 ? 0.3 : 2.5;
+    std::array<float, o2::track::kNParams> par{float(gRandom->Gaus(0., 0.003)), src.z + (src.noise ? 0.f : float(gRandom->Gaus(0., sigZ))),
+                                               float(gRandom->Uniform(-0.3, 0.3)), float(gRandom->Uniform(-0.8, 0.8)), float(gRandom->Uniform(-2., 2.))};
+    std::array<float, o2::track::kCovMatSize> cov{};
+    cov[0] = 0.003 * 0.003;
+    cov[2] = sigZ * sigZ;
+    cov[5] = 1e-4;
+    cov[9] = 1e-4;
+    cov[14] = 1e-2;
+    TimeEst time(src.noise ? src.t : src.t + float(gRandom->Gaus(0., sigT)), sigT);
+    tracks.emplace_back(time, o2::track::TrackParCov(0., gRandom->Uniform(-M_PI, M_PI), par, cov));
+  }
+  std::sort(tracks.begin(), tracks.end(), [](const auto& a, const auto& b) { return a.first.getTimeStamp() < b.first.getTimeStamp(); });
+  std::vector<TrackVF> pool;
+  for (const auto& [time, trc] : tracks) {
+    int entry = pool.size();
+    pool.emplace_back(trc, time, entry, GTrackID(entry, GTrackID::ITSTPC));
+  }
+  return pool;
+}
+
+Result runVertexer(const std::vector<TrackVF>& pool, bool useZIndex, int nThreads)
+{
+  o2::conf::ConfigurableParam::updateFromString("pvertexer.nThreads=" + std::to_string(nThreads));
+  PVertexer vertexer;
+  vertexer.setITSROFrameLength(ITSROFrameLengthMUS);
+  vertexer.setDBScanUseZIndex(useZIndex);
+  vertexer.init();
+  Result result;
+  vertexer.processFromExternalPool(pool, result.vertices, result.vertexTrackIDs, result.v2tRefs);
+  for (const auto& clus : vertexer.getTimeZClusters()) {
+    result.clusters.push_back(clus.trackIDs);
+  }
+  vertexer.end();
+  return result;
+}
+
+void compare(const Result& test, const Result& ref)
+{
+  BOOST_REQUIRE_EQUAL(test.clusters.size(), ref.clusters.size());
+  for (size_t i = 0; i < ref.clusters.size(); i++) {
+    BOOST_CHECK(test.clusters[i] == ref.clusters[i]);
+  }
+  BOOST_REQUIRE_EQUAL(test.vertices.size(), ref.vertices.size());
+  for (size_t i = 0; i < ref.vertices.size(); i++) {
+    BOOST_CHECK_EQUAL(test.vertices[i].getX(), ref.vertices[i].getX());
+    BOOST_CHECK_EQUAL(test.vertices[i].getY(), ref.vertices[i].getY());
+    BOOST_CHECK_EQUAL(test.vertices[i].getZ(), ref.vertices[i].getZ());
+    BOOST_CHECK_EQUAL(test.vertices[i].getTimeStamp().getTimeStamp(), ref.vertices[i].getTimeStamp().getTimeStamp());
+    BOOST_CHECK_EQUAL(test.vertices[i].getNContributors(), ref.vertices[i].getNContributors());
+    BOOST_CHECK_EQUAL(test.vertices[i].getChi2(), ref.vertices[i].getChi2());
+  }
+  BOOST_REQUIRE_EQUAL(test.v2tRefs.size(), ref.v2tRefs.size());
+  for (size_t i = 0; i < ref.v2tRefs.size(); i++) {
+    BOOST_CHECK_EQUAL(test.v2tRefs[i].getFirstEntry(), ref.v2tRefs[i].getFirstEntry());
+    BOOST_CHECK_EQUAL(test.v2tRefs[i].getEntries(), ref.v2tRefs[i].getEntries());
+  }
+  BOOST_REQUIRE_EQUAL(test.vertexTrackIDs.size(), ref.vertexTrackIDs.size());
+  for (size_t i = 0; i < ref.vertexTrackIDs.size(); i++) {
+    BOOST_CHECK_EQUAL(test.vertexTrackIDs[i].getRaw(), ref.vertexTrackIDs[i].getRaw());
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PVertexerDBScan_test)
+{
+  const auto pool = makePool();
+  const auto reference = runVertexer(pool, false, 1);
+  BOOST_CHECK(!reference.clusters.empty());
+  BOOST_CHECK(!reference.vertices.empty());
+  compare(runVertexer(pool, true, 1), reference);
+  compare(runVertexer(pool, true, 4), reference);
+  compare(runVertexer(pool, false, 4), reference);
+}
@@ -245,12 +245,19 @@ struct AnalysisDataProcessorBuilder {
   static auto extractFilteredFromRecord(InputRecord& record, ExpressionInfo& info, pack<Os...> const&)
   {
     auto table = o2::soa::ArrowHelpers::joinTables(std::vector<std::shared_ptr<arrow::Table>>{extractTableFromRecord<Os>(record)...});
-    if (info.tree != nullptr && info.filter == nullptr) {
-      info.filter = framework::expressions::createFilter(table->schema(), framework::expressions::makeCondition(info.tree));
-    }
-    if (info.tree != nullptr && info.filter != nullptr && info.resetSelection == true) {
-      info.selection = framework::expressions::createSelection(table, info.filter);
-      info.resetSelection = false;
+    if (info.backend == expressions::FilterBackend::Interpreter) {
+      if (info.interpreted != nullptr && info.resetSelection == true) {
+        info.selection = framework::expressions::createSelection(table, *info.interpreted);
+        info.resetSelection = false;
+      }
+    } else {
+      if (info.tree != nullptr && info.filter == nullptr) {
+        info.filter = framework::expressions::createFilter(table->schema(), framework::expressions::makeCondition(info.tree));
+      }
+      if (info.tree != nullptr && info.filter != nullptr && info.resetSelection == true) {
+        info.selection = framework::expressions::createSelection(table, info.filter);
+        info.resetSelection = false;
+      }
     }
     if constexpr (!o2::soa::is_smallgroups_v<std::decay_t<T>>) {
       if (info.selection == nullptr) {
@@ -634,6 +641,10 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
 
   homogeneous_apply_refs([&outputs, &hash](auto& x) { return OutputManager<std::decay_t<decltype(x)>>::appendOutput(outputs, x, hash); }, *task.get());
 
+  if (!expressionInfos.empty()) {
+    options.push_back(ConfigParamSpec{"filter-backend", VariantType::String, "gandiva", {"How Filters are evaluated: gandiva (compiled at start) or interpreter (no compilation)"}});
+  }
+
   auto requiredServices = CommonServices::defaultServices();
   auto arrowServices = CommonServices::arrowServices();
   requiredServices.insert(requiredServices.end(), arrowServices.begin(), arrowServices.end());
@@ -668,6 +679,12 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
       return FilterManager<std::decay_t<decltype(x)>>::createExpressionTrees(x, expressionInfos);
     },
                            *task.get());
+    if (!expressionInfos.empty()) {
+      auto backend = expressions::filterBackendFromString(ic.options().get<std::string>("filter-backend"));
+      for (auto& info : expressionInfos) {
+        info.backend = backend;
+      }
+    }
 
     if constexpr (has_init_v<T>) {
       task->init(ic);
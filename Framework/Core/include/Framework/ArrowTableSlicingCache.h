@@ -30,7 +30,9 @@ struct SliceInfoPtr {
 
 struct SliceInfoUnsortedPtr {
   gsl::span<int const> values;
-  ListVector const* groups;
+  // rows of the group with index value v are rows[offsets[v]] ... rows[offsets[v + 1] - 1]
+  gsl::span<int64_t const> offsets;
+  gsl::span<int64_t const> rows;
 
   gsl::span<int64_t const> getSliceFor(int value) const;
 };
@@ -55,7 +57,9 @@ struct ArrowTableSlicingCache {
 
   std::vector<StringPair> bindingsKeysUnsorted;
   std::vector<std::vector<int>> valuesUnsorted;
-  std::vector<ListVector> groups;
+  // grouped rows in compressed sparse row layout, reusing the memory from one update to the next
+  std::vector<std::vector<int64_t>> groupOffsets;
+  std::vector<std::vector<int64_t>> groupRows;
 
   ArrowTableSlicingCache(std::vector<StringPair>&& bsks, std::vector<StringPair>&& bsksUnsorted = {});
 
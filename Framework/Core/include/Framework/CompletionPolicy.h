@@ -94,6 +94,10 @@ struct CompletionPolicy {
   /// not needed if the policy always happens to consume / discard
   /// data.
   bool balanceChannels = true;
+  /// Set to true if the callback returns Wait as long as any of the inputs
+  /// is missing. The DataRelayer can then skip the callback for incomplete
+  /// records by looking at the number of filled inputs only.
+  bool requiresAllInputs = false;
 
   /// Helper to create the default configuration.
   static std::vector<CompletionPolicy> createDefaultPolicies();
@@ -14,6 +14,7 @@
 #include "Framework/DataRelayer.h"
 #include "Framework/AlgorithmSpec.h"
 #include <functional>
+#include <mutex>
 
 namespace o2::framework
 {
@@ -22,6 +23,7 @@ struct DeviceContext;
 struct ServiceRegistry;
 struct DataAllocator;
 struct DataProcessorSpec;
+class StreamPool;
 
 struct DataProcessorContext {
   DataProcessorContext(DataProcessorContext const&) = delete;
@@ -48,6 +50,16 @@ struct DataProcessorContext {
 
   DataProcessorSpec* spec = nullptr; /// Invoke callbacks to be executed in PreRun(), before the User Start callbacks
 
+  /// Workers processing timeslices concurrently, owned by the DataProcessingDevice.
+  /// nullptr unless the DataProcessor requested more than one stream.
+  StreamPool* streamPool = nullptr;
+  /// Id of the stream of the first worker of the streamPool. The streams
+  /// of the workers follow the ones of the main loop.
+  short firstWorkerStream = 0;
+  /// Serializes the user PreProcessing callbacks, which the workers of
+  /// the streamPool invoke concurrently.
+  std::mutex userPreProcessingMutex;
+
   /// Invoke callbacks to be executed before starting the processing loop
   void preStartCallbacks(ServiceRegistryRef);
   /// Invoke callbacks to be executed before every process method invokation
@@ -41,6 +41,7 @@ namespace o2::framework
 struct InputChannelInfo;
 struct DeviceState;
 struct ComputingQuotaEvaluator;
+class StreamPool;
 
 /// Context associated to a given DataProcessor.
 /// For the time being everything points to
@@ -116,6 +117,7 @@ class DataProcessingDevice : public fair::mq::Device
   bool mWasActive = false;                                       /// Whether or not the device was active at last iteration.
   std::vector<uv_work_t> mHandles;                               /// Handles to use to schedule work.
   std::vector<TaskStreamInfo> mStreams;                          /// Information about the task running in the associated mHandle.
+  std::shared_ptr<StreamPool> mStreamPool;                       /// Workers for the additional streams, if DeviceSpec::nStreams > 1.
   /// Handle to wake up the main loop from other threads
   /// e.g. when FairMQ notifies some callback in an asynchronous way
   uv_async_t* mAwakeHandle = nullptr;
@@ -69,6 +69,12 @@ struct DataProcessorSpec {
   /// put, but this is actually to be handled in the actual DeviceSpec.
   size_t inputTimeSliceId = 0;
   size_t maxInputTimeslices = 1;
+  /// How many timeslices are processed concurrently by the same device.
+  /// When larger than 1, the processing callback is invoked from several
+  /// threads at once, so it must be reentrant, while outputs are still sent
+  /// in timeslice order. Contrary to time pipelining, the device and
+  /// whatever it holds (CCDB objects, geometry...) are not replicated.
+  size_t nStreams = 1;
 };
 
 } // namespace o2::framework
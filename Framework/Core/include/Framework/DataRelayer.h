@@ -22,8 +22,10 @@
 #include "Framework/TimesliceSlot.h"
 #include "Framework/ServiceRegistryRef.h"
 
+#include <atomic>
 #include <cstddef>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 
@@ -141,6 +143,17 @@ class DataRelayer
   /// Tune the maximum number of in flight timeslices this can handle.
   void setPipelineLength(size_t s);
 
+  /// Enable the indexed relay mode: the slot of an incoming message is looked up
+  /// by timeslice rather than by matching all the slots in flight and, for policies
+  /// requiring all the inputs, incomplete slots are skipped without invoking
+  /// the completion callback. Useful for devices with many inputs and a long pipeline.
+  /// Can also be enabled with DPL_INDEXED_RELAY=1.
+  void setIndexedRelay(bool indexed) { mIndexedRelay = indexed; }
+  [[nodiscard]] bool isIndexedRelay() const { return mIndexedRelay; }
+
+  /// Number of inputs which have data in the given slot. Does not lock.
+  [[nodiscard]] size_t getFilledInputsForSlot(TimesliceSlot slot) const { return mFilledInputs[slot.index].load(std::memory_order_acquire); }
+
   /// Send metrics with the VariableContext information
   void sendContextState();
   void publishMetrics();
@@ -194,6 +207,16 @@ class DataRelayer
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
 
+  /// Number of inputs with data for each slot. Updated with the mutex held,
+  /// but can be read without it.
+  std::vector<std::atomic<size_t>> mFilledInputs;
+  /// Timeslice to slot lookup for the indexed relay mode. Entries are
+  /// validated against the TimesliceIndex on use, so stale ones are harmless.
+  std::unordered_map<size_t, TimesliceSlot> mSlotForTimeslice;
+  /// Timeslice each slot was last indexed with.
+  std::vector<size_t> mTimesliceForSlot;
+  bool mIndexedRelay = false;
+
   TracyLockableN(std::recursive_mutex, mMutex, "data relayer mutex");
 };
 
@@ -81,6 +81,8 @@ struct DeviceSpec {
   ComputingResource resource;
   unsigned short resourceMonitoringInterval;
   std::vector<DataProcessorLabel> labels;
+  /// How many timeslices are processed concurrently inside this device.
+  size_t nStreams = 1;
 };
 
 } // namespace o2::framework
@@ -77,6 +77,12 @@ struct ColumnOperationSpec {
   }
 };
 
+/// Filter evaluated by interpreting the operation sequences of its parts
+struct InterpretedFilter {
+  /// operations of the filters attached to a table, all of them have to be fulfilled
+  std::vector<Operations> conditions;
+};
+
 /// helper struct used to parse trees
 struct NodeRecord {
   /// pointer to the actual tree node
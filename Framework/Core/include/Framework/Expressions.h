@@ -49,6 +49,16 @@ using Selection = std::shared_ptr<gandiva::SelectionVector>;
 using FilterPtr = std::shared_ptr<gandiva::Filter>;
 } // namespace gandiva
 
+namespace o2::framework::expressions
+{
+/// The ways of evaluating filters
+enum struct FilterBackend : int {
+  Gandiva,    /// compiled to machine code by Gandiva
+  Interpreter /// interpreted as vectorized kernels over blocks of rows, no compilation
+};
+struct InterpretedFilter;
+} // namespace o2::framework::expressions
+
 using atype = arrow::Type;
 struct ExpressionInfo {
   int argumentIndex;
@@ -58,6 +68,8 @@ struct ExpressionInfo {
   gandiva::NodePtr tree;
   gandiva::FilterPtr filter;
   gandiva::Selection selection;
+  std::shared_ptr<o2::framework::expressions::InterpretedFilter> interpreted;
+  o2::framework::expressions::FilterBackend backend = o2::framework::expressions::FilterBackend::Gandiva;
   bool resetSelection = false;
 };
 
@@ -482,6 +494,10 @@ using Projector = Filter;
 gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, Filter const& expression);
 /// Function for creating gandiva selection from prepared gandiva expressions tree
 gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::shared_ptr<gandiva::Filter> const& gfilter);
+/// Function for creating gandiva selection by interpreting the filter operations, without compiling them
+gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, InterpretedFilter const& filter);
+/// Function to get the filter backend from its name
+FilterBackend filterBackendFromString(std::string const& name);
 
 struct ColumnOperationSpec;
 using Operations = std::vector<ColumnOperationSpec>;
@@ -203,22 +203,18 @@ struct GroupSlicer {
           // generic split
           if constexpr (soa::is_soa_filtered_v<std::decay_t<A1>>) {
             auto selection = sliceInfosUnsorted[index].getSliceFor(pos);
-            // intersect selections
-            o2::soa::SelectionVector s;
-            if (selections[index]->empty()) {
-              if (!selection.empty()) {
-                std::copy(selection.begin(), selection.end(), std::back_inserter(s));
-              }
-            } else {
-              if (!selection.empty()) {
-                if constexpr (std::decay_t<A1>::applyFilters) {
-                  std::set_intersection(selection.begin(), selection.end(), selections[index]->begin(), selections[index]->end(), std::back_inserter(s));
-                } else {
-                  std::copy(selection.begin(), selection.end(), std::back_inserter(s));
-                }
+            // the group is a view on the rows stored in the cache, unless it needs to be intersected with the filter selection
+            if constexpr (std::decay_t<A1>::applyFilters) {
+              if (!selections[index]->empty() && !selection.empty()) {
+                o2::soa::SelectionVector s;
+                s.reserve(std::min(selection.size(), selections[index]->size()));
+                std::set_intersection(selection.begin(), selection.end(), selections[index]->begin(), selections[index]->end(), std::back_inserter(s));
+                std::decay_t<A1> typedTable{{originalTable.asArrowTable()}, std::move(s)};
+                typedTable.bindInternalIndicesTo(&originalTable);
+                return typedTable;
               }
             }
-            std::decay_t<A1> typedTable{{originalTable.asArrowTable()}, std::move(s)};
+            std::decay_t<A1> typedTable{{originalTable.asArrowTable()}, selection};
             typedTable.bindInternalIndicesTo(&originalTable);
             return typedTable;
           } else {
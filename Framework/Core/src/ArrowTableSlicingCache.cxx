@@ -49,11 +49,11 @@ gsl::span<const int64_t> SliceInfoUnsortedPtr::getSliceFor(int value) const
   if (values.empty()) {
     return {};
   }
-  if (value > values[values.size() - 1]) {
+  if (value < 0 || value + 1 >= static_cast<int64_t>(offsets.size())) {
     return {};
   }
 
-  return {(*groups)[value].data(), (*groups)[value].size()};
+  return rows.subspan(offsets[value], offsets[value + 1] - offsets[value]);
 }
 
 void ArrowTableSlicingCacheDef::setCaches(std::vector<StringPair>&& bsks)
@@ -74,7 +74,8 @@ ArrowTableSlicingCache::ArrowTableSlicingCache(std::vector<StringPair>&& bsks, s
   counts.resize(bindingsKeys.size());
 
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
-  groups.resize(bindingsKeysUnsorted.size());
+  groupOffsets.resize(bindingsKeysUnsorted.size());
+  groupRows.resize(bindingsKeysUnsorted.size());
 }
 
 void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vector<StringPair>&& bsksUnsorted)
@@ -87,8 +88,10 @@ void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vect
   counts.resize(bindingsKeys.size());
   valuesUnsorted.clear();
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
-  groups.clear();
-  groups.resize(bindingsKeysUnsorted.size());
+  groupOffsets.clear();
+  groupOffsets.resize(bindingsKeysUnsorted.size());
+  groupRows.clear();
+  groupRows.resize(bindingsKeysUnsorted.size());
 }
 
 arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<arrow::Table> const& table)
@@ -114,31 +117,56 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<
 
 arrow::Status ArrowTableSlicingCache::updateCacheEntryUnsorted(int pos, const std::shared_ptr<arrow::Table>& table)
 {
-  valuesUnsorted[pos].clear();
-  groups[pos].clear();
+  auto& values = valuesUnsorted[pos];
+  auto& offsets = groupOffsets[pos];
+  auto& rows = groupRows[pos];
+  values.clear();
+  offsets.clear();
+  rows.clear();
   if (table->num_rows() == 0) {
     return arrow::Status::OK();
   }
   auto& [b, k] = bindingsKeysUnsorted[pos];
   auto column = table->GetColumnByName(k);
-  auto row = 0;
+
+  // counting sort of the rows by index value: first count the rows of each group in offsets[v + 1]...
   for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
     auto chunk = static_cast<arrow::NumericArray<arrow::Int32Type>>(column->chunk(iChunk)->data());
     for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
       auto v = chunk.Value(iElement);
       if (v >= 0) {
-        if (std::find(valuesUnsorted[pos].begin(), valuesUnsorted[pos].end(), v) == valuesUnsorted[pos].end()) {
-          valuesUnsorted[pos].push_back(v);
+        if (offsets.size() < static_cast<size_t>(v) + 2) {
+          offsets.resize(v + 2, 0);
         }
-        if (groups[pos].size() <= v) {
-          groups[pos].resize(v + 1);
-        }
-        (groups[pos])[v].push_back(row);
+        ++offsets[v + 1];
+      }
+    }
+  }
+  if (offsets.empty()) {
+    return arrow::Status::OK();
+  }
+  for (auto v = 0U; v + 1 < offsets.size(); ++v) {
+    if (offsets[v + 1] != 0) {
+      values.push_back(v);
+    }
+    offsets[v + 1] += offsets[v];
+  }
+
+  // ... then place the rows, using offsets[v] as insertion point of group v, which leaves it at the start of group v + 1
+  rows.resize(offsets.back());
+  int64_t row = 0;
+  for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
+    auto chunk = static_cast<arrow::NumericArray<arrow::Int32Type>>(column->chunk(iChunk)->data());
+    for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
+      auto v = chunk.Value(iElement);
+      if (v >= 0) {
+        rows[offsets[v]++] = row;
       }
       ++row;
     }
   }
-  std::sort(valuesUnsorted[pos].begin(), valuesUnsorted[pos].end());
+  std::copy_backward(offsets.begin(), offsets.end() - 1, offsets.end());
+  offsets[0] = 0;
   return arrow::Status::OK();
 }
 
@@ -210,8 +238,9 @@ SliceInfoPtr ArrowTableSlicingCache::getCacheForPos(int pos) const
 SliceInfoUnsortedPtr ArrowTableSlicingCache::getCacheUnsortedForPos(int pos) const
 {
   return {
-    {reinterpret_cast<int const*>(valuesUnsorted[pos].data()), valuesUnsorted[pos].size()},
-    &(groups[pos]) //
+    {valuesUnsorted[pos].data(), valuesUnsorted[pos].size()},
+    {groupOffsets[pos].data(), groupOffsets[pos].size()},
+    {groupRows[pos].data(), groupRows[pos].size()} //
   };
 }
 
@@ -114,7 +114,9 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAll(const char* name, Compl
     }
     return CompletionPolicy::CompletionOp::Consume;
   };
-  return CompletionPolicy{name, matcher, callback};
+  CompletionPolicy policy{name, matcher, callback};
+  policy.requiresAllInputs = true;
+  return policy;
 }
 
 CompletionPolicy CompletionPolicyHelpers::consumeWhenAllOrdered(const char* name, CompletionPolicy::Matcher matcher)
@@ -137,7 +139,9 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAllOrdered(const char* name
     (*nextTimeSlice)++;
     return CompletionPolicy::CompletionOp::ConsumeAndRescan;
   };
-  return CompletionPolicy{name, matcher, callback};
+  CompletionPolicy policy{name, matcher, callback};
+  policy.requiresAllInputs = true;
+  return policy;
 }
 
 CompletionPolicy CompletionPolicyHelpers::consumeWhenAllOrdered(std::string matchName)
@@ -55,6 +55,7 @@
 #include "Framework/DataProcessingHelpers.h"
 #include "DataRelayerHelpers.h"
 #include "ProcessingPoliciesHelpers.h"
+#include "StreamPool.h"
 #include "Headers/DataHeader.h"
 #include "Headers/DataHeaderHelpers.h"
 
@@ -74,6 +75,7 @@
 #include <vector>
 #include <numeric>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <uv.h>
 #include <execinfo.h>
@@ -412,9 +414,11 @@ void DataProcessingDevice::Init()
     spec.callbacksPolicy.policy(mServiceRegistry.get<CallbackService>(ServiceRegistry::globalDeviceSalt()), initContext);
   }
 
-  // Services which are stream should be initialised now
+  // Services which are stream should be initialised now.
+  // The streams of the StreamPool workers, if any, follow the ones of the main loop.
   auto* options = GetConfig();
-  for (size_t si = 0; si < mStreams.size(); ++si) {
+  size_t nWorkerStreams = spec.nStreams > 1 ? spec.nStreams : 0;
+  for (size_t si = 0; si < mStreams.size() + nWorkerStreams; ++si) {
     ServiceRegistry::Salt streamSalt = ServiceRegistry::streamSalt(si + 1, ServiceRegistry::globalDeviceSalt().dataProcessorId);
     mServiceRegistry.lateBindStreamServices(state, *options, streamSalt);
   }
@@ -910,6 +914,15 @@ void DataProcessingDevice::InitTask()
   // We will get there.
   this->fillContext(mServiceRegistry.get<DataProcessorContext>(ServiceRegistry::globalDeviceSalt()), deviceContext);
 
+  // Additional streams are served by a pool of workers which wake up the
+  // main loop whenever some outputs are ready to be sent.
+  if (spec.nStreams > 1 && mStreamPool == nullptr) {
+    LOGP(detail, "Processing up to {} timeslices concurrently", spec.nStreams);
+    mStreamPool = std::make_shared<StreamPool>(spec.nStreams, [awakeMainThread = state.awakeMainThread]() { uv_async_send(awakeMainThread); });
+    context.streamPool = mStreamPool.get();
+    context.firstWorkerStream = mStreams.size() + 1;
+  }
+
   /// We now run an event loop also in InitTask. This is needed to:
   /// * Make sure region registration callbacks are invoked
   /// on the main thread.
@@ -1023,7 +1036,9 @@ void DataProcessingDevice::PreRun()
   }
   auto& dpContext = ref.get<DataProcessorContext>();
   dpContext.preStartCallbacks(ref);
-  for (size_t i = 0; i < mStreams.size(); ++i) {
+  auto& spec = getRunningDevice(mRunningDevice, ref);
+  size_t nWorkerStreams = spec.nStreams > 1 ? spec.nStreams : 0;
+  for (size_t i = 0; i < mStreams.size() + nWorkerStreams; ++i) {
     auto streamRef = ServiceRegistryRef{mServiceRegistry, ServiceRegistry::globalStreamSalt(i + 1)};
     auto& context = streamRef.get<StreamContext>();
     context.preStartStreamCallbacks(streamRef);
@@ -1054,9 +1069,13 @@ void DataProcessingDevice::PostRun()
   auto& monitoring = ref.get<Monitoring>();
   monitoring.send(Metric{(uint64_t)0, "device_state"}.addTag(Key::Subsystem, Value::DPL));
 
+  auto& dpContext = ref.get<DataProcessorContext>();
+  // Timeslices still being processed must be sent before we stop.
+  if (dpContext.streamPool) {
+    dpContext.streamPool->drain();
+  }
   stopPollers();
   ref.get<CallbackService>().call<CallbackService::Id::Stop>();
-  auto& dpContext = ref.get<DataProcessorContext>();
   dpContext.postStopCallbacks(ref);
 }
 
@@ -1445,6 +1464,11 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
   auto& state = ref.get<DeviceState>();
   auto& spec = ref.get<DeviceSpec const>();
 
+  // Send the outputs of the timeslices the workers are done with.
+  if (context.streamPool) {
+    *context.wasActive |= context.streamPool->commitReady() > 0;
+  }
+
   if (state.streaming == StreamingState::Idle) {
     *context.wasActive = false;
     return;
@@ -1489,6 +1513,9 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
     while (DataProcessingDevice::tryDispatchComputation(ref, context.completed) && hasOnlyGenerated == false) {
       relayer.processDanglingInputs(context.expirationHandlers, *context.registry, false);
     }
+    if (context.streamPool) {
+      context.streamPool->drain();
+    }
     EndOfStreamContext eosContext{*context.registry, ref.get<DataAllocator>()};
 
     context.preEOSCallbacks(eosContext);
@@ -1534,6 +1561,8 @@ void DataProcessingDevice::ResetTask()
 {
   ServiceRegistryRef ref{mServiceRegistry};
   ref.get<DataRelayer>().clear();
+  ref.get<DataProcessorContext>().streamPool = nullptr;
+  mStreamPool.reset();
 }
 
 struct WaitBackpressurePolicy {
@@ -1872,17 +1901,35 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   auto& context = ref.get<DataProcessorContext>();
   ZoneScopedN("DataProcessingDevice::tryDispatchComputation");
   LOGP(debug, "DataProcessingDevice::tryDispatchComputation");
-  // This is the actual hidden state for the outer loop. In case we decide we
-  // want to support multithreaded dispatching of operations, I can simply
-  // move these to some thread local store and the rest of the lambdas
-  // should work just fine.
-  std::vector<MessageSet> currentSetOfInputs;
+  // This is the actual hidden state for the outer loop, one per action, so
+  // that the action can be handed over to a different stream when the
+  // DataProcessor has more than one (see DataProcessorSpec::nStreams).
+  struct ActionState {
+    DataRelayer::RecordAction action;
+    std::vector<MessageSet> inputs;
+    std::optional<InputSpan> span;
+    std::optional<InputRecord> record;
+    std::optional<ProcessingContext> processContext;
+    TimingInfo timingInfo; /// Only used to hand the timing over to a worker stream
+    uint64_t tStart = 0;
+    uint64_t tStartMilli = 0;
+    bool onlyForward = false; /// Discarded inputs which we still need to forward
+    bool processed = false;   /// Whether the user callback was invoked
+  };
 
   // For the moment we have a simple "immediately dispatch" policy for stuff
   // in the cache. This could be controlled from the outside e.g. by waiting
   // for a few sets of inputs to arrive before we actually dispatch the
   // computation, however this can be defined at a later stage.
   auto canDispatchSomeComputation = [&completed, ref]() -> bool {
+    // With multiple streams we keep at most two timeslices per stream in
+    // flight. Whatever is not dispatched stays in the relayer, which applies
+    // the usual backpressure, and is picked up once a worker is done and
+    // wakes up the loop.
+    auto* streamPool = ref.get<DataProcessorContext>().streamPool;
+    if (streamPool && streamPool->pending() >= 2 * streamPool->getNStreams()) {
+      return false;
+    }
     ref.get<DataRelayer>().getReadyToProcess(completed);
     return completed.empty() == false;
   };
@@ -1901,7 +1948,7 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   };
 
   //
-  auto getInputSpan = [ref, &currentSetOfInputs](TimesliceSlot slot, bool consume = true) {
+  auto getInputSpan = [ref](TimesliceSlot slot, std::vector<MessageSet>& currentSetOfInputs, bool consume = true) {
     auto& relayer = ref.get<DataRelayer>();
     if (consume) {
       currentSetOfInputs = relayer.consumeAllInputsForTimeslice(slot);
@@ -1942,10 +1989,9 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   // propagates it to the various contextes (i.e. the actual entities which
   // create messages) because the messages need to have the timeslice id into
   // it.
-  auto prepareAllocatorForCurrentTimeSlice = [ref](TimesliceSlot i) -> void {
+  auto prepareAllocatorForCurrentTimeSlice = [ref](TimesliceSlot i, TimingInfo& timingInfo) -> void {
     auto& dataProcessorContext = ref.get<DataProcessorContext>();
     auto& relayer = ref.get<DataRelayer>();
-    auto& timingInfo = ref.get<TimingInfo>();
     ZoneScopedN("DataProcessingDevice::prepareForCurrentTimeslice");
     auto timeslice = relayer.getTimesliceForSlot(i);
 
@@ -1969,7 +2015,7 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   // to avoid double counting them.
   // This was actually the easiest solution we could find for
   // O2-646.
-  auto cleanTimers = [&currentSetOfInputs](TimesliceSlot slot, InputRecord& record) {
+  auto cleanTimers = [](std::vector<MessageSet>& currentSetOfInputs, InputRecord& record) {
     assert(record.size() == currentSetOfInputs.size());
     for (size_t ii = 0, ie = record.size(); ii < ie; ++ii) {
       // assuming that for timer inputs we do have exactly one PartRef object
@@ -1991,7 +2037,7 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   // simply use it to keep track of input messages
   // which are not needed, to display them in the GUI.
 #ifdef TRACY_ENABLE
-  auto cleanupRecord = [](InputRecord& record) {
+  static auto cleanupRecord = [](InputRecord& record) {
     for (size_t ii = 0, ie = record.size(); ii < ie; ++ii) {
       DataRef input = record.getByPos(ii);
       if (input.header == nullptr) {
@@ -2062,156 +2108,214 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     states.updateState({.id = short((int)ProcessingStateId::DATA_RELAYER_BASE + action.slot.index), (int)(record.size() + buffer - relayerSlotState), relayerSlotState});
   };
 
-  // This is the main dispatching loop
-  LOGP(debug, "Processing actions:");
-  auto& state = ref.get<DeviceState>();
-  auto& spec = ref.get<DeviceSpec const>();
+  static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
-  auto& dpContext = ref.get<DataProcessorContext>();
-  auto& streamContext = ref.get<StreamContext>();
-  for (auto action : getReadyActions()) {
-    LOGP(debug, "  Begin action");
-    if (action.op == CompletionPolicy::CompletionOp::Wait) {
-      LOGP(debug, "  - Action is to Wait");
-      continue;
+  auto withErrorHandling = [](DataProcessorContext& context, InputRecord& record, auto&& callback) {
+    if (noCatch) {
+      try {
+        callback();
+      } catch (o2::framework::RuntimeErrorRef e) {
+        ZoneScopedN("error handling");
+        (context.errorHandling)(e, record);
+      }
+    } else {
+      try {
+        callback();
+      } catch (std::exception& ex) {
+        ZoneScopedN("error handling");
+        /// Convert a standard exception to a RuntimeErrorRef
+        /// Notice how this will lose the backtrace information
+        /// and report the exception coming from here.
+        auto e = runtime_error(ex.what());
+        (context.errorHandling)(e, record);
+      } catch (o2::framework::RuntimeErrorRef e) {
+        ZoneScopedN("error handling");
+        (context.errorHandling)(e, record);
+      }
     }
+  };
 
-    switch (action.op) {
-      case CompletionPolicy::CompletionOp::Consume:
-        LOG(debug) << "  - Action is to " << action.op << " " << action.slot.index;
-        break;
-      default:
-        LOG(debug) << "  - Action is to " << action.op << " " << action.slot.index;
-        break;
+  // The user code, including the callbacks to be invoked around it, on the
+  // stream of @a ref. Returns false if nothing was run because we are quitting.
+  // When @a deferred, the callbacks of the DataProcessor level services are
+  // left to commitAction, since those services are shared by all the streams.
+  auto runNoCatch = [](ServiceRegistryRef ref, DataRelayer::RecordAction& action, ProcessingContext& processContext, bool deferred) -> bool {
+    auto& context = ref.get<DataProcessorContext>();
+    auto& state = ref.get<DeviceState>();
+    auto& spec = ref.get<DeviceSpec const>();
+    auto& streamContext = ref.get<StreamContext>();
+    auto& dpContext = ref.get<DataProcessorContext>();
+    if (state.quitRequested) {
+      return false;
+    }
+    {
+      ZoneScopedN("service post processing");
+      // Callbacks from services
+      if (deferred == false) {
+        dpContext.preProcessingCallbacks(processContext);
+      }
+      streamContext.preProcessingCallbacks(processContext);
+      if (deferred == false) {
+        dpContext.preProcessingCallbacks(processContext);
+      }
+      // Callbacks from users
+      std::unique_lock<std::mutex> userLock(dpContext.userPreProcessingMutex, std::defer_lock);
+      if (deferred) {
+        userLock.lock();
+      }
+      ref.get<CallbackService>().call<CallbackService::Id::PreProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
+    }
+    if (context.statefulProcess) {
+      ZoneScopedN("statefull process");
+      (context.statefulProcess)(processContext);
+    } else if (context.statelessProcess) {
+      ZoneScopedN("stateless process");
+      (context.statelessProcess)(processContext);
+    } else {
+      state.streaming = StreamingState::Idle;
     }
 
-    prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
-    bool shouldConsume = action.op == CompletionPolicy::CompletionOp::Consume ||
-                         action.op == CompletionPolicy::CompletionOp::Discard;
-    InputSpan span = getInputSpan(action.slot, shouldConsume);
+    // Notify the sink we just consumed some timeframe data
+    if (context.isSink && action.op == CompletionPolicy::CompletionOp::Consume) {
+      auto& allocator = ref.get<DataAllocator>();
+      allocator.make<int>(OutputRef{"dpl-summary", compile_time_hash(spec.name.c_str())}, 1);
+    }
+    return true;
+  };
+
+  // The post processing callbacks are the ones actually sending the outputs,
+  // so with multiple streams they are deferred until the action is committed.
+  auto runPostProcessing = [](ServiceRegistryRef ref, DataRelayer::RecordAction& action, ProcessingContext& processContext) {
+    auto& streamContext = ref.get<StreamContext>();
+    auto& dpContext = ref.get<DataProcessorContext>();
+    ZoneScopedN("service post processing");
+    ref.get<CallbackService>().call<CallbackService::Id::PostProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
+    dpContext.postProcessingCallbacks(processContext);
+    streamContext.postProcessingCallbacks(processContext);
+  };
+
+  // Everything up to the user code. When @a deferred, this runs on a
+  // worker, so it must not touch the relayer nor send anything.
+  auto processAction = [markInputsAsDone, preUpdateStats, withErrorHandling, runNoCatch, runPostProcessing](ServiceRegistryRef ref, ActionState& s, bool deferred) {
+    auto& context = ref.get<DataProcessorContext>();
+    auto& state = ref.get<DeviceState>();
     auto& spec = ref.get<DeviceSpec const>();
-    InputRecord record{spec.inputs,
-                       span,
-                       *context.registry};
-    ProcessingContext processContext{record, ref, ref.get<DataAllocator>()};
+    auto& streamContext = ref.get<StreamContext>();
+    auto& action = s.action;
+    if (deferred) {
+      auto& timingInfo = ref.get<TimingInfo>();
+      auto lapse = timingInfo.lapse;
+      timingInfo = s.timingInfo;
+      timingInfo.lapse = lapse;
+    }
+    s.processContext.emplace(*s.record, ref, ref.get<DataAllocator>());
+    auto& processContext = *s.processContext;
     {
       ZoneScopedN("service pre processing");
       // Notice this should be thread safe and reentrant
       // as it is called from many threads.
       streamContext.preProcessingCallbacks(processContext);
-      dpContext.preProcessingCallbacks(processContext);
+      if (deferred == false) {
+        context.preProcessingCallbacks(processContext);
+      }
     }
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
       LOGP(debug, "  - Action is to Discard");
-      context.postDispatchingCallbacks(processContext);
-      if (spec.forwards.empty() == false) {
-        auto& timesliceIndex = ref.get<TimesliceIndex>();
-        forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), false);
-        continue;
+      if (deferred == false) {
+        context.postDispatchingCallbacks(processContext);
+      }
+      if (s.onlyForward) {
+        if (deferred == false) {
+          auto& timesliceIndex = ref.get<TimesliceIndex>();
+          forwardInputs(ref, action.slot, s.inputs, timesliceIndex.getOldestPossibleOutput(), false);
+        }
+        return;
       }
     }
     // If there is no optional inputs we canForwardEarly
     // the messages to that parallel processing can happen.
     // In this case we pass true to indicate that we want to
     // copy the messages to the subsequent data processor.
+    // With multiple streams we always forward late, from the main thread.
     bool hasForwards = spec.forwards.empty() == false;
     bool consumeSomething = action.op == CompletionPolicy::CompletionOp::Consume || action.op == CompletionPolicy::CompletionOp::ConsumeExisting;
 
-    if (context.canForwardEarly && hasForwards && consumeSomething) {
+    if (deferred == false && context.canForwardEarly && hasForwards && consumeSomething) {
       LOGP(debug, "  - Early forwarding");
       auto& timesliceIndex = ref.get<TimesliceIndex>();
-      forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), true, action.op == CompletionPolicy::CompletionOp::Consume);
+      forwardInputs(ref, action.slot, s.inputs, timesliceIndex.getOldestPossibleOutput(), true, action.op == CompletionPolicy::CompletionOp::Consume);
+    }
+    if (deferred == false) {
+      markInputsAsDone(action.slot);
     }
-    markInputsAsDone(action.slot);
-
-    uint64_t tStart = uv_hrtime();
-    uint64_t tStartMilli = TimingHelpers::getRealtimeSinceEpochStandalone();
-    preUpdateStats(action, record, tStart);
-
-    static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
-
-    auto runNoCatch = [&context, ref, &processContext](DataRelayer::RecordAction& action) mutable {
-      auto& state = ref.get<DeviceState>();
-      auto& spec = ref.get<DeviceSpec const>();
-      auto& streamContext = ref.get<StreamContext>();
-      auto& dpContext = ref.get<DataProcessorContext>();
-      if (state.quitRequested == false) {
-        {
-          ZoneScopedN("service post processing");
-          // Callbacks from services
-          dpContext.preProcessingCallbacks(processContext);
-          streamContext.preProcessingCallbacks(processContext);
-          dpContext.preProcessingCallbacks(processContext);
-          // Callbacks from users
-          ref.get<CallbackService>().call<CallbackService::Id::PreProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
-        }
-        if (context.statefulProcess) {
-          ZoneScopedN("statefull process");
-          (context.statefulProcess)(processContext);
-        } else if (context.statelessProcess) {
-          ZoneScopedN("stateless process");
-          (context.statelessProcess)(processContext);
-        } else {
-          state.streaming = StreamingState::Idle;
-        }
 
-        // Notify the sink we just consumed some timeframe data
-        if (context.isSink && action.op == CompletionPolicy::CompletionOp::Consume) {
-          auto& allocator = ref.get<DataAllocator>();
-          allocator.make<int>(OutputRef{"dpl-summary", compile_time_hash(spec.name.c_str())}, 1);
-        }
+    s.tStart = uv_hrtime();
+    s.tStartMilli = TimingHelpers::getRealtimeSinceEpochStandalone();
+    preUpdateStats(action, *s.record, s.tStart);
 
-        {
-          ZoneScopedN("service post processing");
-          ref.get<CallbackService>().call<CallbackService::Id::PostProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
-          dpContext.postProcessingCallbacks(processContext);
-          streamContext.postProcessingCallbacks(processContext);
-        }
-      }
-    };
-
-    if ((state.tracingFlags & DeviceState::LoopReason::TRACE_USERCODE) != 0) {
+    // The severity is global, so we only change it when running serially.
+    if (deferred == false && (state.tracingFlags & DeviceState::LoopReason::TRACE_USERCODE) != 0) {
       state.severityStack.push_back((int)fair::Logger::GetConsoleSeverity());
       fair::Logger::SetConsoleSeverity(fair::Severity::trace);
     }
-    if (noCatch) {
-      try {
-        runNoCatch(action);
-      } catch (o2::framework::RuntimeErrorRef e) {
-        ZoneScopedN("error handling");
-        (context.errorHandling)(e, record);
-      }
-    } else {
-      try {
-        runNoCatch(action);
-      } catch (std::exception& ex) {
-        ZoneScopedN("error handling");
-        /// Convert a standard exception to a RuntimeErrorRef
-        /// Notice how this will lose the backtrace information
-        /// and report the exception coming from here.
-        auto e = runtime_error(ex.what());
-        (context.errorHandling)(e, record);
-      } catch (o2::framework::RuntimeErrorRef e) {
-        ZoneScopedN("error handling");
-        (context.errorHandling)(e, record);
+    withErrorHandling(context, *s.record, [&]() {
+      s.processed = runNoCatch(ref, action, processContext, deferred);
+      if (s.processed && deferred == false) {
+        runPostProcessing(ref, action, processContext);
       }
-    }
-    if (state.severityStack.empty() == false) {
+    });
+    if (deferred == false && state.severityStack.empty() == false) {
       fair::Logger::SetConsoleSeverity((fair::Severity)state.severityStack.back());
       state.severityStack.pop_back();
     }
+  };
+
+  // Sending of the outputs, forwarding and cleanup. Always on the main
+  // thread and, with multiple streams, in timeslice order.
+  auto commitAction = [postUpdateStats, withErrorHandling, runPostProcessing, cleanTimers](ActionState& s, bool deferred) {
+    auto ref = s.processContext->services();
+    auto& context = ref.get<DataProcessorContext>();
+    auto& spec = ref.get<DeviceSpec const>();
+    auto& action = s.action;
+    auto& record = *s.record;
+    auto& processContext = *s.processContext;
+    if (deferred) {
+      // The DataProcessor level callbacks skipped on the worker, as many
+      // times as they would have been invoked when processing serially.
+      ZoneScopedN("service pre processing");
+      context.preProcessingCallbacks(processContext);
+      if (s.processed) {
+        context.preProcessingCallbacks(processContext);
+        context.preProcessingCallbacks(processContext);
+      }
+    }
+    if (deferred && action.op == CompletionPolicy::CompletionOp::Discard) {
+      context.postDispatchingCallbacks(processContext);
+    }
+    if (s.onlyForward) {
+      if (deferred) {
+        auto& timesliceIndex = ref.get<TimesliceIndex>();
+        forwardInputs(ref, action.slot, s.inputs, timesliceIndex.getOldestPossibleOutput(), false);
+      }
+      return;
+    }
+    if (deferred && s.processed) {
+      withErrorHandling(context, record, [&]() { runPostProcessing(ref, action, processContext); });
+    }
 
-    postUpdateStats(action, record, tStart, tStartMilli);
+    postUpdateStats(action, record, s.tStart, s.tStartMilli);
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
       context.postDispatchingCallbacks(processContext);
       ref.get<CallbackService>().call<CallbackService::Id::DataConsumed>(o2::framework::ServiceRegistryRef{ref});
     }
-    if ((context.canForwardEarly == false) && hasForwards && consumeSomething) {
+    bool hasForwards = spec.forwards.empty() == false;
+    bool consumeSomething = action.op == CompletionPolicy::CompletionOp::Consume || action.op == CompletionPolicy::CompletionOp::ConsumeExisting;
+    if ((context.canForwardEarly == false || deferred) && hasForwards && consumeSomething) {
       LOGP(debug, "Late forwarding");
       auto& timesliceIndex = ref.get<TimesliceIndex>();
-      forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), false, action.op == CompletionPolicy::CompletionOp::Consume);
+      forwardInputs(ref, action.slot, s.inputs, timesliceIndex.getOldestPossibleOutput(), false, action.op == CompletionPolicy::CompletionOp::Consume);
     }
     context.postForwardingCallbacks(processContext);
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
@@ -2219,12 +2323,65 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       cleanupRecord(record);
 #endif
     } else if (action.op == CompletionPolicy::CompletionOp::Process) {
-      cleanTimers(action.slot, record);
+      cleanTimers(s.inputs, record);
+    }
+  };
+
+  // This is the main dispatching loop
+  LOGP(debug, "Processing actions:");
+  auto& state = ref.get<DeviceState>();
+  auto& spec = ref.get<DeviceSpec const>();
+
+  auto actions = getReadyActions();
+  // Outputs are committed in submission order, so submit the oldest first.
+  if (context.streamPool) {
+    std::sort(actions.begin(), actions.end(), [](auto const& a, auto const& b) { return a.timeslice.value < b.timeslice.value; });
+  }
+  for (auto action : actions) {
+    LOGP(debug, "  Begin action");
+    if (action.op == CompletionPolicy::CompletionOp::Wait) {
+      LOGP(debug, "  - Action is to Wait");
+      continue;
     }
+
+    switch (action.op) {
+      case CompletionPolicy::CompletionOp::Consume:
+        LOG(debug) << "  - Action is to " << action.op << " " << action.slot.index;
+        break;
+      default:
+        LOG(debug) << "  - Action is to " << action.op << " " << action.slot.index;
+        break;
+    }
+
+    bool deferred = context.streamPool != nullptr;
+    auto s = std::make_shared<ActionState>();
+    s->action = action;
+    prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot}, deferred ? s->timingInfo : ref.get<TimingInfo>());
+    bool shouldConsume = action.op == CompletionPolicy::CompletionOp::Consume ||
+                         action.op == CompletionPolicy::CompletionOp::Discard;
+    s->span.emplace(getInputSpan(action.slot, s->inputs, shouldConsume));
+    s->record.emplace(spec.inputs, *s->span, *context.registry);
+    s->onlyForward = action.op == CompletionPolicy::CompletionOp::Discard && spec.forwards.empty() == false;
+
+    if (deferred == false) {
+      processAction(ref, *s, false);
+      commitAction(*s, false);
+      continue;
+    }
+    if (s->onlyForward == false) {
+      markInputsAsDone(action.slot);
+    }
+    context.streamPool->submit({[s, processAction, registry = context.registry, firstWorkerStream = context.firstWorkerStream](int stream) {
+                                  processAction(ServiceRegistryRef{*registry, ServiceRegistry::globalStreamSalt(firstWorkerStream + stream)}, *s, true);
+                                },
+                                [s, commitAction]() { commitAction(*s, true); }});
   }
 
   // We now broadcast the end of stream if it was requested
   if (state.streaming == StreamingState::EndOfStreaming) {
+    if (context.streamPool) {
+      context.streamPool->drain();
+    }
     LOGP(detail, "Broadcasting end of stream");
     for (auto& channel : spec.outputChannels) {
       auto& rawDevice = ref.get<RawDeviceService>();
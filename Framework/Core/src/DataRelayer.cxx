@@ -73,6 +73,9 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
+  static bool indexedRelay = getenv("DPL_INDEXED_RELAY") && atoi(getenv("DPL_INDEXED_RELAY"));
+  mIndexedRelay = indexedRelay;
+
   if (policy.configureRelayer == nullptr) {
     static int pipelineLength = DefaultsHelpers::pipelineLength();
     setPipelineLength(pipelineLength);
@@ -218,6 +221,9 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       assert(expirator.handler);
       PartRef newRef;
       expirator.handler(services, newRef, variables);
+      if (part.size() == 0) {
+        mFilledInputs[ti].fetch_add(1, std::memory_order_release);
+      }
       part.reset(std::move(newRef));
       activity.expiredSlots++;
 
@@ -335,6 +341,7 @@ void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
   auto pruneCache = [&onDrop,
                      &cache = mCache,
                      &cachedStateMetrics = mCachedStateMetrics,
+                     &filledInputs = mFilledInputs,
                      numInputTypes = mDistinctRoutesIndex.size(),
                      &index = mTimesliceIndex,
                      ref = mContext](TimesliceSlot slot) {
@@ -366,6 +373,7 @@ void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
       cache[ai].clear();
       cachedStateMetrics[ai] = CacheEntryStatus::EMPTY;
     }
+    filledInputs[slot.index].store(0, std::memory_order_release);
   };
 
   pruneCache(slot);
@@ -423,10 +431,14 @@ DataRelayer::RelayChoice
                      &nMessages,
                      &nPayloads,
                      &cache = mCache,
+                     &filledInputs = mFilledInputs,
                      numInputTypes = mDistinctRoutesIndex.size()](TimesliceId timeslice, int input, TimesliceSlot slot) {
     auto cacheIdx = numInputTypes * slot.index + input;
     MessageSet& target = cache[cacheIdx];
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    if (target.size() == 0) {
+      filledInputs[slot.index].fetch_add(1, std::memory_order_release);
+    }
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     assert(nPayloads > 0);
@@ -461,6 +473,22 @@ DataRelayer::RelayChoice
     }
   };
 
+  // Keep the timeslice -> slot lookup of the indexed mode up to date,
+  // dropping the entry of whatever timeslice the slot held before.
+  auto indexSlot = [indexed = mIndexedRelay,
+                    &slotForTimeslice = mSlotForTimeslice,
+                    &timesliceForSlot = mTimesliceForSlot](TimesliceId timeslice, TimesliceSlot slot) {
+    if (!indexed || timesliceForSlot[slot.index] == timeslice.value) {
+      return;
+    }
+    auto stale = slotForTimeslice.find(timesliceForSlot[slot.index]);
+    if (stale != slotForTimeslice.end() && stale->second.index == slot.index) {
+      slotForTimeslice.erase(stale);
+    }
+    timesliceForSlot[slot.index] = timeslice.value;
+    slotForTimeslice[timeslice.value] = slot;
+  };
+
   // OUTER LOOP
   //
   // This is the actual outer loop processing input as part of a given
@@ -471,9 +499,25 @@ DataRelayer::RelayChoice
   auto& index = mTimesliceIndex;
 
   bool needsCleaning = false;
+  // In indexed mode we extract the timeslice once and go directly to the
+  // slot which already holds it. We still match against the context of
+  // the slot, because other variables might be bound there. If the
+  // timeslice is not indexed yet (e.g. first message of a timeslice)
+  // we fall back to the scan below.
+  if (mIndexedRelay) {
+    VariableContext lookupContext;
+    auto [lookupInput, lookupTimeslice] = getInputTimeslice(lookupContext);
+    auto indexed = mSlotForTimeslice.find(lookupTimeslice.value);
+    if (lookupInput != INVALID_INPUT && indexed != mSlotForTimeslice.end() &&
+        index.isValid(indexed->second) && isSlotInLane(indexed->second)) {
+      slot = indexed->second;
+      std::tie(input, timeslice) = getInputTimeslice(index.getVariablesForSlot(slot));
+    }
+  }
+
   // First look for matching slots which already have some
   // partial match.
-  for (size_t ci = 0; ci < index.size(); ++ci) {
+  for (size_t ci = 0; input == INVALID_INPUT && ci < index.size(); ++ci) {
     slot = TimesliceSlot{ci};
     if (!isSlotInLane(slot)) {
       continue;
@@ -515,6 +559,7 @@ DataRelayer::RelayChoice
       mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
     }
     saveInSlot(timeslice, input, slot);
+    indexSlot(timeslice, slot);
     index.publishSlot(slot);
     index.markAsDirty(slot, true);
     stats.updateStats({static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), DataProcessingStats::Op::Add, (int)1});
@@ -591,6 +636,7 @@ DataRelayer::RelayChoice
       this->pruneCache(slot, onDrop);
       mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
       saveInSlot(timeslice, input, slot);
+      indexSlot(timeslice, slot);
       index.publishSlot(slot);
       index.markAsDirty(slot, true);
       return RelayChoice{.type = RelayChoice::Type::WillRelay};
@@ -663,6 +709,14 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
       notDirty++;
       continue;
     }
+    // If the policy needs all the inputs, a slot which misses some of them
+    // can only wait, no need to build the span and invoke the callback.
+    if (mIndexedRelay && mCompletionPolicy.requiresAllInputs &&
+        mFilledInputs[li].load(std::memory_order_acquire) < numInputTypes) {
+      countWait++;
+      mTimesliceIndex.markAsDirty(slot, false);
+      continue;
+    }
     auto partial = getPartialRecord(li);
     // TODO: get the data ref from message model
     auto getter = [&partial](size_t idx, size_t part) {
@@ -789,11 +843,12 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
   // timeslice, so I can simply do that. I keep the assertion there because in principle
   // we should have dispatched the timeslice already!
   // FIXME: what happens when we have enough timeslices to hit the invalid one?
-  auto invalidateCacheFor = [&numInputTypes, &index, &cache](TimesliceSlot s) {
+  auto invalidateCacheFor = [&numInputTypes, &index, &cache, &filledInputs = mFilledInputs](TimesliceSlot s) {
     for (size_t ai = s.index * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
       assert(std::accumulate(cache[ai].messages.begin(), cache[ai].messages.end(), true, [](bool result, auto const& element) { return result && element.get() == nullptr; }));
       cache[ai].clear();
     }
+    filledInputs[s.index].store(0, std::memory_order_release);
     index.markAsInvalid(s);
   };
 
@@ -841,11 +896,21 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTime
     }
   };
 
+  // The slot stays valid and keeps the headers, so the inputs which
+  // arrived are still accounted for. Recount them rather than assuming
+  // the counter is in sync.
+  auto recountFilledInputs = [&numInputTypes, &cache, &filledInputs = mFilledInputs](TimesliceSlot s) {
+    auto filled = std::count_if(cache.begin() + s.index * numInputTypes, cache.begin() + (s.index + 1) * numInputTypes,
+                                [](MessageSet const& part) { return part.size() > 0; });
+    filledInputs[s.index].store(filled, std::memory_order_release);
+  };
+
   // Outer loop here.
   jumpToCacheEntryAssociatedWith(slot);
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
     copyHeaderPayloadToOutput(slot, ai);
   }
+  recountFilledInputs(slot);
 
   return std::move(messages);
 }
@@ -857,6 +922,9 @@ void DataRelayer::clear()
   for (auto& cache : mCache) {
     cache.clear();
   }
+  for (auto& filled : mFilledInputs) {
+    filled.store(0, std::memory_order_release);
+  }
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
@@ -879,6 +947,18 @@ void DataRelayer::setPipelineLength(size_t s)
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
   publishMetrics();
+
+  // The cache has been resized, recount what is in each slot and
+  // start over with the indexing.
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  mFilledInputs = std::vector<std::atomic<size_t>>(s);
+  for (size_t si = 0; si < s; ++si) {
+    auto filled = std::count_if(mCache.begin() + si * numInputTypes, mCache.begin() + (si + 1) * numInputTypes,
+                                [](MessageSet const& part) { return part.size() > 0; });
+    mFilledInputs[si].store(filled, std::memory_order_release);
+  }
+  mTimesliceForSlot.assign(s, TimesliceId::INVALID);
+  mSlotForTimeslice.clear();
 }
 
 void DataRelayer::publishMetrics()
@@ -542,7 +542,8 @@ void DeviceSpecHelpers::processOutEdgeActions(ConfigContext const& configContext
       .inputTimesliceId = edge.producerTimeIndex,
       .maxInputTimeslices = processor.maxInputTimeslices,
       .resource = {acceptedOffer},
-      .labels = processor.labels});
+      .labels = processor.labels,
+      .nStreams = processor.nStreams});
     /// If any of the inputs or outputs are "Lifetime::OutOfBand"
     /// create the associated channels.
     //
@@ -828,7 +829,8 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
       .inputTimesliceId = edge.timeIndex,
       .maxInputTimeslices = processor.maxInputTimeslices,
       .resource = {acceptedOffer},
-      .labels = processor.labels};
+      .labels = processor.labels,
+      .nStreams = processor.nStreams};
 
     if (processor.maxInputTimeslices != 1) {
       device.id += "_t" + std::to_string(edge.timeIndex);
@@ -0,0 +1,512 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ExpressionHelpers.h"
+#include "Framework/RuntimeError.h"
+#include "arrow/table.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+// Evaluation of the filter operation sequences (see createOperations) without
+// Gandiva: the operations are applied one after the other to blocks of rows,
+// each one as a simple loop over the values of its arguments which the
+// compiler vectorizes. Columns are read in place, intermediate results live
+// in per-operation buffers sized for a block, so that they stay in cache.
+
+namespace o2::framework::expressions
+{
+
+namespace
+{
+constexpr int64_t BlockSize = 1024;
+
+/// The values of a datum for the rows of a block, or a single value for all of them
+struct Block {
+  atype::type type = atype::NA;
+  bool scalar = false;
+  void const* data = nullptr;
+};
+
+/// Block sized storage, large enough for any of the supported types
+struct Buffer {
+  std::unique_ptr<uint64_t[]> storage{new uint64_t[BlockSize]};
+  template <typename T>
+  T* as()
+  {
+    return reinterpret_cast<T*>(storage.get());
+  }
+};
+
+template <typename F>
+void dispatch(atype::type type, F&& f)
+{
+  switch (type) {
+    case atype::BOOL:
+      return f(bool{});
+    case atype::UINT8:
+      return f(uint8_t{});
+    case atype::INT8:
+      return f(int8_t{});
+    case atype::UINT16:
+      return f(uint16_t{});
+    case atype::INT16:
+      return f(int16_t{});
+    case atype::UINT32:
+      return f(uint32_t{});
+    case atype::INT32:
+      return f(int32_t{});
+    case atype::UINT64:
+      return f(uint64_t{});
+    case atype::INT64:
+      return f(int64_t{});
+    case atype::FLOAT:
+      return f(float{});
+    case atype::DOUBLE:
+      return f(double{});
+    default:
+      throw runtime_error_f("Type %s is not supported by the filter interpreter", stringType(type));
+  }
+}
+
+/// math functions are evaluated in single precision unless the argument is a double, as with Gandiva
+template <typename F>
+void dispatchFloating(atype::type type, F&& f)
+{
+  if (type == atype::DOUBLE) {
+    f(double{});
+  } else {
+    f(float{});
+  }
+}
+
+/// the type in which two arguments are compared, following the promotions of createOperations
+atype::type commonType(atype::type t1, atype::type t2)
+{
+  if (t1 == t2) {
+    return t1;
+  }
+  if (t1 == atype::DOUBLE || t2 == atype::DOUBLE) {
+    return atype::DOUBLE;
+  }
+  if (t1 == atype::FLOAT || t2 == atype::FLOAT) {
+    return atype::FLOAT;
+  }
+  if (t1 == atype::BOOL) {
+    return t2;
+  }
+  if (t2 == atype::BOOL) {
+    return t1;
+  }
+  return t1 > t2 ? t1 : t2;
+}
+
+/// values of @a block as T, converted in @a scratch if needed
+template <typename T>
+T const* valuesAs(Block const& block, T* scratch, int64_t n)
+{
+  if (block.type == selectArrowType<T>()) {
+    return static_cast<T const*>(block.data);
+  }
+  auto count = block.scalar ? 1 : n;
+  dispatch(block.type, [&](auto s) {
+    using S = decltype(s);
+    auto source = static_cast<S const*>(block.data);
+    for (int64_t i = 0; i < count; ++i) {
+      scratch[i] = static_cast<T>(source[i]);
+    }
+  });
+  return scratch;
+}
+
+/// State of one operation: where its result and converted arguments are stored
+struct Slot {
+  Buffer result;
+  Buffer scratch[3];
+};
+
+template <typename R, typename T, typename F>
+Block unary(Block const& arg, Slot& slot, int64_t n, F&& f)
+{
+  auto a = valuesAs<T>(arg, slot.scratch[0].as<T>(), n);
+  auto out = slot.result.as<R>();
+  auto count = arg.scalar ? 1 : n;
+  for (int64_t i = 0; i < count; ++i) {
+    out[i] = f(a[i]);
+  }
+  return {selectArrowType<R>(), arg.scalar, out};
+}
+
+template <typename R, typename T, typename F>
+Block binary(Block const& left, Block const& right, Slot& slot, int64_t n, F&& f)
+{
+  auto a = valuesAs<T>(left, slot.scratch[0].as<T>(), n);
+  auto b = valuesAs<T>(right, slot.scratch[1].as<T>(), n);
+  auto out = slot.result.as<R>();
+  // separate loops for the scalar arguments, which keep them vectorizable
+  if (left.scalar && right.scalar) {
+    out[0] = f(a[0], b[0]);
+  } else if (left.scalar) {
+    auto av = a[0];
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = f(av, b[i]);
+    }
+  } else if (right.scalar) {
+    auto bv = b[0];
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = f(a[i], bv);
+    }
+  } else {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = f(a[i], b[i]);
+    }
+  }
+  return {selectArrowType<R>(), left.scalar && right.scalar, out};
+}
+
+template <typename T>
+Block conditional(Block const& condition, Block const& left, Block const& right, Slot& slot, int64_t n)
+{
+  auto c = valuesAs<bool>(condition, slot.scratch[2].as<bool>(), n);
+  auto a = valuesAs<T>(left, slot.scratch[0].as<T>(), n);
+  auto b = valuesAs<T>(right, slot.scratch[1].as<T>(), n);
+  auto out = slot.result.as<T>();
+  bool scalar = condition.scalar && left.scalar && right.scalar;
+  auto count = scalar ? 1 : n;
+  for (int64_t i = 0; i < count; ++i) {
+    out[i] = c[condition.scalar ? 0 : i] ? a[left.scalar ? 0 : i] : b[right.scalar ? 0 : i];
+  }
+  return {selectArrowType<T>(), scalar, out};
+}
+
+Block evaluate(ColumnOperationSpec const& spec, Block const& left, Block const& right, Block const& condition, Slot& slot, int64_t n)
+{
+  Block result;
+  auto arithmetic = [&](auto op) {
+    dispatch(spec.type, [&](auto t) {
+      using T = decltype(t);
+      result = binary<T, T>(left, right, slot, n, [&op](T a, T b) { return static_cast<T>(op(a, b)); });
+    });
+  };
+  auto bitwise = [&](auto op) {
+    dispatch(spec.type, [&](auto t) {
+      using T = decltype(t);
+      if constexpr (std::is_integral_v<T>) {
+        result = binary<T, T>(left, right, slot, n, [&op](T a, T b) { return static_cast<T>(op(a, b)); });
+      } else {
+        throw runtime_error_f("Bitwise operation on %s values", stringType(spec.type));
+      }
+    });
+  };
+  auto comparison = [&](auto op) {
+    dispatch(commonType(left.type, right.type), [&](auto t) {
+      using T = decltype(t);
+      result = binary<bool, T>(left, right, slot, n, op);
+    });
+  };
+  auto math = [&](auto op) {
+    dispatchFloating(spec.type, [&](auto t) {
+      using T = decltype(t);
+      result = unary<T, T>(left, slot, n, [&op](T a) { return static_cast<T>(op(a)); });
+    });
+  };
+  auto math2 = [&](auto op) {
+    dispatchFloating(spec.type, [&](auto t) {
+      using T = decltype(t);
+      result = binary<T, T>(left, right, slot, n, [&op](T a, T b) { return static_cast<T>(op(a, b)); });
+    });
+  };
+
+  switch (spec.op) {
+    case BasicOp::LogicalAnd:
+      result = binary<bool, bool>(left, right, slot, n, [](bool a, bool b) { return a & b; });
+      break;
+    case BasicOp::LogicalOr:
+      result = binary<bool, bool>(left, right, slot, n, [](bool a, bool b) { return a | b; });
+      break;
+    case BasicOp::Addition:
+      arithmetic([](auto a, auto b) { return a + b; });
+      break;
+    case BasicOp::Subtraction:
+      arithmetic([](auto a, auto b) { return a - b; });
+      break;
+    case BasicOp::Multiplication:
+      arithmetic([](auto a, auto b) { return a * b; });
+      break;
+    case BasicOp::Division:
+      arithmetic([](auto a, auto b) {
+        if constexpr (std::is_integral_v<decltype(a)>) {
+          return b != 0 ? a / b : decltype(a / b){0};
+        } else {
+          return a / b;
+        }
+      });
+      break;
+    case BasicOp::BitwiseAnd:
+      bitwise([](auto a, auto b) { return a & b; });
+      break;
+    case BasicOp::BitwiseOr:
+      bitwise([](auto a, auto b) { return a | b; });
+      break;
+    case BasicOp::BitwiseXor:
+      bitwise([](auto a, auto b) { return a ^ b; });
+      break;
+    case BasicOp::LessThan:
+      comparison([](auto a, auto b) { return a < b; });
+      break;
+    case BasicOp::LessThanOrEqual:
+      comparison([](auto a, auto b) { return a <= b; });
+      break;
+    case BasicOp::GreaterThan:
+      comparison([](auto a, auto b) { return a > b; });
+      break;
+    case BasicOp::GreaterThanOrEqual:
+      comparison([](auto a, auto b) { return a >= b; });
+      break;
+    case BasicOp::Equal:
+      comparison([](auto a, auto b) { return a == b; });
+      break;
+    case BasicOp::NotEqual:
+      comparison([](auto a, auto b) { return a != b; });
+      break;
+    case BasicOp::Atan2:
+      math2([](auto a, auto b) { return std::atan2(a, b); });
+      break;
+    case BasicOp::Power:
+      math2([](auto a, auto b) { return std::pow(a, b); });
+      break;
+    case BasicOp::Sqrt:
+      math([](auto a) { return std::sqrt(a); });
+      break;
+    case BasicOp::Exp:
+      math([](auto a) { return std::exp(a); });
+      break;
+    case BasicOp::Log:
+      math([](auto a) { return std::log(a); });
+      break;
+    case BasicOp::Log10:
+      math([](auto a) { return std::log10(a); });
+      break;
+    case BasicOp::Sin:
+      math([](auto a) { return std::sin(a); });
+      break;
+    case BasicOp::Cos:
+      math([](auto a) { return std::cos(a); });
+      break;
+    case BasicOp::Tan:
+      math([](auto a) { return std::tan(a); });
+      break;
+    case BasicOp::Asin:
+      math([](auto a) { return std::asin(a); });
+      break;
+    case BasicOp::Acos:
+      math([](auto a) { return std::acos(a); });
+      break;
+    case BasicOp::Atan:
+      math([](auto a) { return std::atan(a); });
+      break;
+    case BasicOp::Abs:
+      math([](auto a) { return std::abs(a); });
+      break;
+    case BasicOp::Round:
+      math([](auto a) { return std::round(a); });
+      break;
+    case BasicOp::BitwiseNot:
+      dispatch(left.type, [&](auto t) {
+        using T = decltype(t);
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+          result = unary<T, T>(left, slot, n, [](T a) { return static_cast<T>(~a); });
+        } else {
+          throw runtime_error_f("Bitwise operation on %s values", stringType(left.type));
+        }
+      });
+      break;
+    case BasicOp::Conditional:
+      dispatch(spec.type, [&](auto t) { result = conditional<decltype(t)>(condition, left, right, slot, n); });
+      break;
+  }
+  return result;
+}
+
+/// An operation sequence prepared for a record batch
+class Program
+{
+ public:
+  Program(Operations const& ops, arrow::RecordBatch const& batch) : mOps{ops}, mSlots(ops.size())
+  {
+    size_t nResults = 0;
+    for (auto& op : ops) {
+      nResults = std::max(nResults, std::get<size_t>(op.result.datum) + 1);
+    }
+    mResults.resize(nResults);
+    // arguments which do not change from one block to the next
+    mLiterals.resize(ops.size());
+    for (auto i = 0U; i < ops.size(); ++i) {
+      for (auto* datum : {&ops[i].left, &ops[i].right, &ops[i].condition}) {
+        if (datum->datum.index() == 2) {
+          mLiterals[i].emplace_back(literal(*datum));
+        } else if (datum->datum.index() == 3) {
+          auto const& name = std::get<std::string>(datum->datum);
+          if (mColumns.count(name) == 0) {
+            auto column = batch.GetColumnByName(name);
+            if (column == nullptr) {
+              throw runtime_error_f("Cannot find field \"%s\"", name.c_str());
+            }
+            mColumns.emplace(name, column);
+          }
+        }
+      }
+    }
+  }
+
+  /// Evaluate the rows [offset, offset + n) of the batch, @return the boolean result of the sequence
+  Block run(int64_t offset, int64_t n)
+  {
+    for (auto& [name, column] : mColumns) {
+      mColumnBlocks[name] = columnBlock(column, offset, n);
+    }
+    // children come after their parents in the sequence
+    for (auto i = mOps.size(); i-- > 0;) {
+      auto const& op = mOps[i];
+      auto literalIt = mLiterals[i].begin();
+      auto datumBlock = [&](DatumSpec const& datum) -> Block {
+        switch (datum.datum.index()) {
+          case 1:
+            return mResults[std::get<size_t>(datum.datum)];
+          case 2:
+            return (literalIt++)->block();
+          case 3:
+            return mColumnBlocks[std::get<std::string>(datum.datum)];
+          default:
+            return {};
+        }
+      };
+      auto left = datumBlock(op.left);
+      auto right = datumBlock(op.right);
+      auto condition = datumBlock(op.condition);
+      mResults[std::get<size_t>(op.result.datum)] = evaluate(op, left, right, condition, mSlots[i], n);
+    }
+    return mResults[std::get<size_t>(mOps[0].result.datum)];
+  }
+
+ private:
+  struct Literal {
+    atype::type type;
+    Buffer value;
+    Block block() { return {type, true, value.storage.get()}; }
+  };
+
+  static Literal literal(DatumSpec const& datum)
+  {
+    Literal result{datum.type, {}};
+    std::visit([&](auto v) {
+      dispatch(datum.type, [&](auto t) { *result.value.as<decltype(t)>() = static_cast<decltype(t)>(v); });
+    },
+               std::get<LiteralNode::var_t>(datum.datum));
+    return result;
+  }
+
+  Block columnBlock(std::shared_ptr<arrow::Array> const& column, int64_t offset, int64_t n)
+  {
+    auto type = column->type_id();
+    if (type == atype::BOOL) {
+      // booleans are stored as bits, unpack them
+      auto& buffer = mUnpacked[column.get()];
+      auto values = buffer.as<bool>();
+      auto array = std::static_pointer_cast<arrow::BooleanArray>(column);
+      for (int64_t i = 0; i < n; ++i) {
+        values[i] = array->Value(offset + i);
+      }
+      return {type, false, values};
+    }
+    Block block{type, false, nullptr};
+    dispatch(type, [&](auto t) { block.data = column->data()->GetValues<decltype(t)>(1) + offset; });
+    return block;
+  }
+
+  Operations const& mOps;
+  std::vector<Slot> mSlots;
+  std::vector<Block> mResults;
+  std::vector<std::vector<Literal>> mLiterals;
+  std::unordered_map<std::string, std::shared_ptr<arrow::Array>> mColumns;
+  std::unordered_map<std::string, Block> mColumnBlocks;
+  std::unordered_map<arrow::Array const*, Buffer> mUnpacked;
+};
+} // namespace
+
+gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, InterpretedFilter const& filter)
+{
+  gandiva::Selection selection;
+  auto s = gandiva::SelectionVector::MakeInt64(table->num_rows(),
+                                               arrow::default_memory_pool(),
+                                               &selection);
+  if (!s.ok()) {
+    throw runtime_error_f("Cannot allocate selection vector %s", s.ToString().c_str());
+  }
+  if (table->num_rows() == 0) {
+    return selection;
+  }
+  arrow::TableBatchReader reader(*table);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  int64_t batchOffset = 0;
+  int64_t nSelected = 0;
+  std::unique_ptr<bool[]> selected{new bool[BlockSize]};
+  while (true) {
+    s = reader.ReadNext(&batch);
+    if (!s.ok()) {
+      throw runtime_error_f("Cannot read batches from table %s", s.ToString().c_str());
+    }
+    if (batch == nullptr) {
+      break;
+    }
+    std::vector<Program> programs;
+    for (auto& ops : filter.conditions) {
+      programs.emplace_back(ops, *batch);
+    }
+    for (int64_t offset = 0; offset < batch->num_rows(); offset += BlockSize) {
+      auto n = std::min(BlockSize, batch->num_rows() - offset);
+      std::fill_n(selected.get(), n, true);
+      for (auto& program : programs) {
+        auto result = program.run(offset, n);
+        auto values = static_cast<bool const*>(result.data);
+        if (result.type != atype::BOOL) {
+          throw runtime_error_f("Filter evaluates to %s instead of bool", stringType(result.type));
+        }
+        for (int64_t i = 0; i < n; ++i) {
+          selected[i] &= values[result.scalar ? 0 : i];
+        }
+      }
+      for (int64_t i = 0; i < n; ++i) {
+        if (selected[i]) {
+          selection->SetIndex(nSelected++, batchOffset + offset + i);
+        }
+      }
+    }
+    batchOffset += batch->num_rows();
+  }
+  selection->SetNumSlots(nSelected);
+  return selection;
+}
+
+FilterBackend filterBackendFromString(std::string const& name)
+{
+  if (name == "gandiva") {
+    return FilterBackend::Gandiva;
+  }
+  if (name == "interpreter") {
+    return FilterBackend::Interpreter;
+  }
+  throw runtime_error_f("Unknown filter backend %s, use gandiva or interpreter", name.c_str());
+}
+
+} // namespace o2::framework::expressions
@@ -755,6 +755,10 @@ void updateExpressionInfos(expressions::Filter const& filter, std::vector<Expres
       } else {
         info.tree = tree;
       }
+      if (info.interpreted == nullptr) {
+        info.interpreted = std::make_shared<InterpretedFilter>();
+      }
+      info.interpreted->conditions.push_back(ops);
     }
   }
 }
@@ -0,0 +1,165 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "StreamPool.h"
+
+namespace o2::framework
+{
+
+StreamPool::StreamPool(int nStreams, std::function<void()> notify)
+  : mQueues(nStreams),
+    mNotify{std::move(notify)}
+{
+  for (int si = 0; si < nStreams; ++si) {
+    mWorkers.emplace_back([this, si]() { work(si); });
+  }
+}
+
+StreamPool::~StreamPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWorkAvailable.notify_all();
+  mTaskCommitted.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+void StreamPool::submit(Task&& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueues[mNextQueue].push_back(Entry{mNextTicket++, std::move(task)});
+    mNextQueue = (mNextQueue + 1) % mQueues.size();
+  }
+  mWorkAvailable.notify_one();
+}
+
+// Must be called with the lock held. A worker first takes the oldest task
+// of its own queue, then steals the oldest pending one from the others, so
+// that older timeslices, which have to be committed first, are never
+// stuck behind a busy worker.
+bool StreamPool::pop(int stream, Entry& entry)
+{
+  std::deque<Entry>* victim = nullptr;
+  if (!mQueues[stream].empty()) {
+    victim = &mQueues[stream];
+  } else {
+    for (auto& queue : mQueues) {
+      if (!queue.empty() && (victim == nullptr || queue.front().ticket < victim->front().ticket)) {
+        victim = &queue;
+      }
+    }
+  }
+  if (victim == nullptr) {
+    return false;
+  }
+  entry = std::move(victim->front());
+  victim->pop_front();
+  return true;
+}
+
+void StreamPool::work(int stream)
+{
+  while (true) {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      bool found = false;
+      mWorkAvailable.wait(lock, [this, stream, &entry, &found]() {
+        found = pop(stream, entry);
+        return found || mStop;
+      });
+      if (!found) {
+        return;
+      }
+    }
+    Done done{std::move(entry.task.commit), nullptr};
+    try {
+      if (entry.task.process) {
+        entry.task.process(stream);
+      }
+    } catch (...) {
+      done.error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDone.emplace(entry.ticket, std::move(done));
+    }
+    mTaskDone.notify_all();
+    if (mNotify) {
+      mNotify();
+    }
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTaskCommitted.wait(lock, [this, ticket = entry.ticket]() { return mStop || mNextCommit > ticket; });
+  }
+}
+
+size_t StreamPool::commitReady()
+{
+  size_t committed = 0;
+  while (true) {
+    Done done;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto next = mDone.find(mNextCommit);
+      if (next == mDone.end()) {
+        return committed;
+      }
+      done = std::move(next->second);
+      mDone.erase(next);
+    }
+    committed++;
+    // The worker is released only after the commit, whatever its outcome.
+    auto release = [this]() {
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mNextCommit++;
+      }
+      mTaskCommitted.notify_all();
+    };
+    if (done.error) {
+      release();
+      std::rethrow_exception(done.error);
+    }
+    try {
+      if (done.commit) {
+        done.commit();
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+    release();
+  }
+}
+
+void StreamPool::wait(size_t maxPending)
+{
+  while (true) {
+    commitReady();
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mNextTicket - mNextCommit <= maxPending) {
+      return;
+    }
+    mTaskDone.wait(lock, [this]() { return mDone.count(mNextCommit) != 0; });
+  }
+}
+
+size_t StreamPool::pending() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNextTicket - mNextCommit;
+}
+
+} // namespace o2::framework
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_STREAMPOOL_H_
+#define O2_FRAMEWORK_STREAMPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// A pool of worker threads, one per stream, used to process several
+/// timeslices of the same DataProcessor concurrently.
+///
+/// Each task has two parts:
+/// - process, which is run on one of the workers, with the index of the
+///   worker as argument. Tasks are assigned to the workers round robin,
+///   and an idle worker steals pending tasks from the others.
+/// - commit, which is run by the owner of the pool (i.e. the main thread
+///   of the device) via commitReady(), strictly in submission order.
+///   This is where the outputs get sent.
+/// Since the outputs of a task are kept by the services of its stream until
+/// they are sent, a worker picks a new task only once its previous one has
+/// been committed.
+class StreamPool
+{
+ public:
+  struct Task {
+    std::function<void(int stream)> process;
+    std::function<void()> commit;
+  };
+
+  /// @a notify is invoked from the workers whenever a task is ready to be
+  /// committed, e.g. to wake up the event loop of the owner.
+  StreamPool(int nStreams, std::function<void()> notify);
+  ~StreamPool();
+
+  [[nodiscard]] int getNStreams() const { return mQueues.size(); }
+
+  /// Enqueue a task. Tasks are committed in the order they are submitted.
+  void submit(Task&& task);
+
+  /// Commit all the tasks which are done and whose predecessors were
+  /// committed already. An exception thrown by the processing of a task is
+  /// rethrown here, once its turn to be committed comes.
+  /// @return the number of committed tasks
+  size_t commitReady();
+
+  /// Commit tasks as they get ready, until no more than @a maxPending
+  /// tasks are left.
+  void wait(size_t maxPending);
+
+  /// Wait for all the submitted tasks to be processed and commit them.
+  void drain() { wait(0); }
+
+  /// @return the number of tasks submitted, but not committed yet.
+  [[nodiscard]] size_t pending() const;
+
+ private:
+  struct Entry {
+    uint64_t ticket;
+    Task task;
+  };
+  struct Done {
+    std::function<void()> commit;
+    std::exception_ptr error;
+  };
+
+  void work(int stream);
+  bool pop(int stream, Entry& entry);
+
+  std::vector<std::deque<Entry>> mQueues;
+  std::vector<std::thread> mWorkers;
+  std::function<void()> mNotify;
+  std::map<uint64_t, Done> mDone;
+  uint64_t mNextTicket = 0;
+  uint64_t mNextCommit = 0;
+  size_t mNextQueue = 0;
+  bool mStop = false;
+  // A single lock for all the queues is enough: tasks are whole timeslices,
+  // so the contention is negligible compared to the processing.
+  mutable std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mTaskDone;
+  std::condition_variable mTaskCommitted;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_STREAMPOOL_H_
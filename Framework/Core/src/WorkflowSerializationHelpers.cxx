@@ -47,6 +47,7 @@ struct WorkflowImporter : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
     IN_DATAPROCESSOR_N_SLOTS,
     IN_DATAPROCESSOR_TIMESLICE_ID,
     IN_DATAPROCESSOR_MAX_TIMESLICES,
+    IN_DATAPROCESSOR_N_STREAMS,
     IN_INPUTS,
     IN_OUTPUTS,
     IN_OPTIONS,
@@ -127,6 +128,9 @@ struct WorkflowImporter : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
       case State::IN_DATAPROCESSOR_MAX_TIMESLICES:
         s << "IN_DATAPROCESSOR_MAX_TIMESLICES";
         break;
+      case State::IN_DATAPROCESSOR_N_STREAMS:
+        s << "IN_DATAPROCESSOR_N_STREAMS";
+        break;
       case State::IN_INPUTS:
         s << "IN_INPUTS";
         break;
@@ -642,6 +646,8 @@ struct WorkflowImporter : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
       push(State::IN_DATAPROCESSOR_TIMESLICE_ID);
     } else if (in(State::IN_DATAPROCESSOR) && strncmp(str, "maxInputTimeslices", length) == 0) {
       push(State::IN_DATAPROCESSOR_MAX_TIMESLICES);
+    } else if (in(State::IN_DATAPROCESSOR) && strncmp(str, "nStreams", length) == 0) {
+      push(State::IN_DATAPROCESSOR_N_STREAMS);
     } else if (in(State::IN_DATAPROCESSOR) && strncmp(str, "inputs", length) == 0) {
       push(State::IN_INPUTS);
     } else if (in(State::IN_DATAPROCESSOR) && strncmp(str, "outputs", length) == 0) {
@@ -799,6 +805,8 @@ struct WorkflowImporter : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
       dataProcessors.back().inputTimeSliceId = i;
     } else if (in(State::IN_DATAPROCESSOR_MAX_TIMESLICES)) {
       dataProcessors.back().maxInputTimeslices = i;
+    } else if (in(State::IN_DATAPROCESSOR_N_STREAMS)) {
+      dataProcessors.back().nStreams = i;
     }
     pop();
     return true;
@@ -1183,6 +1191,8 @@ void WorkflowSerializationHelpers::dump(std::ostream& out,
     w.Int(processor.inputTimeSliceId);
     w.Key("maxInputTimeslices");
     w.Int(processor.maxInputTimeslices);
+    w.Key("nStreams");
+    w.Int(processor.nStreams);
 
     w.EndObject();
   }
@@ -18,6 +18,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
 #include <cstring>
+#include <string>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -348,4 +349,80 @@ static void BM_RelayMultiplePayloads(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultiplePayloads)->Arg(10)->Arg(100)->Arg(1000);
 
+/// Many inputs for the same timeslice, e.g. a merger collecting from many
+/// producers, with several timeslices in flight. The messages of the
+/// timeslices are interleaved, like when coming from different producers.
+/// First argument is the number of inputs, second one whether the
+/// indexed relay mode is used.
+static void BM_RelayHighFanIn(benchmark::State& state)
+{
+  Monitoring metrics;
+  const size_t nInputs = state.range(0);
+  const size_t nInFlight = 8;
+
+  std::vector<InputRoute> inputs;
+  for (size_t i = 0; i < nInputs; ++i) {
+    InputSpec spec{"input" + std::to_string(i), "TST", "FANIN", static_cast<DataHeader::SubSpecificationType>(i)};
+    inputs.emplace_back(InputRoute{spec, i, "Fake", 0});
+  }
+
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  ServiceRegistry registry;
+  DataRelayer relayer(policy, inputs, index, {registry});
+  relayer.setPipelineLength(nInFlight);
+  relayer.setIndexedRelay(state.range(1));
+
+  DataHeader dh;
+  dh.dataDescription = "FANIN";
+  dh.dataOrigin = "TST";
+  dh.payloadSize = 100;
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  Stack placeholder{dh, DataProcessingHeader{0, 1}};
+
+  // one header / payload pair per input and timeslice in flight
+  std::vector<fair::mq::MessagePtr> inflightMessages;
+  for (size_t i = 0; i < 2 * nInputs * nInFlight; ++i) {
+    inflightMessages.emplace_back(transport->CreateMessage(i % 2 ? dh.payloadSize : placeholder.size()));
+  }
+
+  size_t timeslice = 0;
+  std::vector<RecordAction> ready;
+  for (auto _ : state) {
+    for (size_t ti = 0; ti < nInFlight; ++ti) {
+      for (size_t i = 0; i < nInputs; ++i) {
+        dh.subSpecification = i;
+        Stack stack{dh, DataProcessingHeader{timeslice + ti, 1}};
+        memcpy(inflightMessages[2 * (ti * nInputs + i)]->GetData(), stack.data(), stack.size());
+      }
+    }
+    // inputs are the outer loop, so that all the timeslices stay incomplete
+    // until the last input arrives
+    for (size_t i = 0; i < nInputs; ++i) {
+      for (size_t ti = 0; ti < nInFlight; ++ti) {
+        auto mi = 2 * (ti * nInputs + i);
+        relayer.relay(inflightMessages[mi]->GetData(), &inflightMessages[mi], 2);
+        ready.clear();
+        relayer.getReadyToProcess(ready);
+        for (auto& action : ready) {
+          assert(action.op == CompletionPolicy::CompletionOp::Consume);
+          auto result = relayer.consumeAllInputsForTimeslice(action.slot);
+          auto ts = action.timeslice.value - timeslice;
+          for (size_t ri = 0; ri < nInputs; ++ri) {
+            inflightMessages[2 * (ts * nInputs + ri)] = std::move(result[ri].messages[0]);
+            inflightMessages[2 * (ts * nInputs + ri) + 1] = std::move(result[ri].messages[1]);
+          }
+        }
+      }
+    }
+    timeslice += nInFlight;
+  }
+  state.SetItemsProcessed(state.iterations() * nInputs * nInFlight);
+}
+
+BENCHMARK(BM_RelayHighFanIn)->ArgsProduct({{16, 64, 256}, {0, 1}});
+
 BENCHMARK_MAIN();
@@ -239,6 +239,90 @@ TEST_CASE("DataRelayer")
     REQUIRE(result.at(1).size() == 1);
   }
 
+  // Same as above, but with timeslices interleaved and the indexed
+  // relay mode enabled.
+  SECTION("TestIndexedRelay")
+  {
+    InputSpec spec1{"clusters", "TPC", "CLUSTERS"};
+    InputSpec spec2{"clusters_its", "ITS", "CLUSTERS"};
+
+    std::vector<InputRoute> inputs = {
+      InputRoute{spec1, 0, "Fake1", 0},
+      InputRoute{spec2, 1, "Fake2", 0}};
+
+    std::vector<InputChannelInfo> infos{1};
+    TimesliceIndex index{1, infos};
+
+    auto policy = CompletionPolicyHelpers::consumeWhenAll();
+    DataRelayer relayer(policy, inputs, index, {registry});
+    relayer.setPipelineLength(4);
+    relayer.setIndexedRelay(true);
+    REQUIRE(relayer.isIndexedRelay());
+
+    auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+    auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+
+    auto createMessage = [&transport, &channelAlloc, &relayer](DataHeader& dh, size_t time) {
+      std::array<fair::mq::MessagePtr, 2> messages;
+      messages[0] = o2::pmr::getMessage(Stack{channelAlloc, dh, DataProcessingHeader{time, 1}});
+      messages[1] = transport->CreateMessage(1000);
+      auto choice = relayer.relay(messages[0]->GetData(), messages.data(), messages.size());
+      REQUIRE(choice.type == DataRelayer::RelayChoice::Type::WillRelay);
+    };
+
+    DataHeader dh1;
+    dh1.dataDescription = "CLUSTERS";
+    dh1.dataOrigin = "TPC";
+    dh1.subSpecification = 0;
+    dh1.splitPayloadIndex = 0;
+    dh1.splitPayloadParts = 1;
+
+    DataHeader dh2;
+    dh2.dataDescription = "CLUSTERS";
+    dh2.dataOrigin = "ITS";
+    dh2.subSpecification = 0;
+    dh2.splitPayloadIndex = 0;
+    dh2.splitPayloadParts = 1;
+
+    for (size_t t = 0; t < 3; ++t) {
+      createMessage(dh1, t);
+    }
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 0);
+    for (size_t si = 0; si < 3; ++si) {
+      REQUIRE(relayer.getFilledInputsForSlot(TimesliceSlot{si}) == 1);
+    }
+    // Consuming what is there so far keeps the inputs accounted for.
+    auto existing = relayer.consumeExistingInputsForTimeslice(TimesliceSlot{0});
+    REQUIRE(existing.size() == 2);
+    REQUIRE(existing[0].size() + existing[1].size() == 1);
+    REQUIRE(relayer.getFilledInputsForSlot(TimesliceSlot{0}) == 1);
+
+    createMessage(dh2, 1);
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0].timeslice.value == 1);
+    REQUIRE(ready[0].op == CompletionPolicy::CompletionOp::Consume);
+    REQUIRE(relayer.getFilledInputsForSlot(ready[0].slot) == 2);
+    auto result = relayer.consumeAllInputsForTimeslice(ready[0].slot);
+    REQUIRE(result.size() == 2);
+    REQUIRE(relayer.getFilledInputsForSlot(ready[0].slot) == 0);
+
+    // A new timeslice can reuse the slot which was just freed.
+    createMessage(dh2, 3);
+    createMessage(dh2, 0);
+    ready.clear();
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0].timeslice.value == 0);
+    createMessage(dh1, 3);
+    ready.clear();
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0].timeslice.value == 3);
+  }
+
   // This test a more complicated set of inputs, and verifies that data is
   // correctly relayed before being processed.
   SECTION("TestRelayBug")
@@ -13,6 +13,7 @@
 #include "Framework/ExpressionHelpers.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/AODReaderHelpers.h"
+#include "Framework/TableBuilder.h"
 #include <catch_amalgamated.hpp>
 #include <arrow/util/config.h>
 
@@ -267,3 +268,38 @@ TEST_CASE("TestConditionalExpressions")
   auto gandiva_filter2 = createFilter(schema2, gandiva_condition2);
   REQUIRE(gandiva_tree2->ToString() == "bool greater_than((float) fSigned1Pt, (const float) 0 raw(0)) && if (bool less_than(float absf((float) fEta), (const float) 1 raw(3f800000)) && if (bool less_than((float) fPt, (const float) 1 raw(3f800000))) { bool greater_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) } else { bool less_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) }) { bool greater_than(float absf((float) fX), (const float) 1 raw(3f800000)) } else { bool greater_than(float absf((float) fY), (const float) 1 raw(3f800000)) }");
 }
+
+TEST_CASE("TestInterpretedFilter")
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float, int32_t>({"pt", "eta", "phi", "testInt"});
+  for (auto i = 0; i < 3000; ++i) {
+    rowWriter(0, 0.01f * (i % 500), -1.f + 0.001f * (i % 2000), 0.002f * i, i % 7);
+  }
+  auto table = builder.finalize();
+
+  auto compare = [&table](Filter&& f) {
+    auto ops = createOperations(f);
+    auto gandivaSelection = createSelection(table, createFilter(table->schema(), ops));
+    InterpretedFilter interpreted{{ops}};
+    auto selection = createSelection(table, interpreted);
+    REQUIRE(selection->GetNumSlots() == gandivaSelection->GetNumSlots());
+    for (auto i = 0; i < selection->GetNumSlots(); ++i) {
+      REQUIRE(selection->GetIndex(i) == gandivaSelection->GetIndex(i));
+    }
+    return selection->GetNumSlots();
+  };
+
+  REQUIRE(compare((nodes::pt > 1.f) && (nabs(nodes::eta) < 0.8f)) > 0);
+  REQUIRE(compare((nodes::phi - (float)M_PI) * 2.f < nodes::pt || nodes::testInt == 3) > 0);
+  REQUIRE(compare(nsqrt(nodes::pt * nodes::pt + nodes::eta * nodes::eta) < 2.f && (nodes::testInt & 1) == 1) > 0);
+  REQUIRE(compare(ifnode(nodes::pt < 2.f, nodes::eta > 0.f, nodes::eta < 0.f)) > 0);
+  REQUIRE(compare(nodes::pt > 100.f) == 0);
+
+  // several filters for the same table have to be fulfilled together
+  Filter f1 = nodes::pt > 1.f;
+  Filter f2 = nodes::testInt != 0;
+  InterpretedFilter both{{createOperations(f1), createOperations(f2)}};
+  auto selection = createSelection(table, both);
+  REQUIRE(selection->GetNumSlots() == compare((nodes::pt > 1.f) && (nodes::testInt != 0)));
+}
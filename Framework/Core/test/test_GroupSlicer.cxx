@@ -632,3 +632,42 @@ TEST_CASE("TestSlicingException")
     FAIL("Slicing should have failed due to unsorted index");
   }
 }
+
+TEST_CASE("ArrowUnsortedSlicing")
+{
+  std::vector<int> eventIds{7, 2, -1, 2, 0, 7, 7, -1, 3, 0, 2};
+
+  TableBuilder builderT;
+  auto trksWriter = builderT.cursor<aod::TrksXU>();
+  for (auto i = 0u; i < eventIds.size(); ++i) {
+    trksWriter(0, eventIds[i], 0.5f * i);
+  }
+  auto trkTable = builderT.finalize();
+
+  auto bk = std::make_pair(soa::getLabelFromType<aod::TrksXU>(), "fIndex" + o2::framework::cutString(soa::getLabelFromType<aod::Events>()));
+  ArrowTableSlicingCache cache({}, {bk});
+  auto s = cache.updateCacheEntryUnsorted(0, trkTable);
+  REQUIRE(s.ok());
+  auto lcache = cache.getCacheUnsortedFor(bk);
+  REQUIRE(std::vector<int>(lcache.values.begin(), lcache.values.end()) == std::vector<int>{0, 2, 3, 7});
+
+  for (auto value = -1; value < 10; ++value) {
+    std::vector<int64_t> expected;
+    if (value >= 0) {
+      for (auto i = 0u; i < eventIds.size(); ++i) {
+        if (eventIds[i] == value) {
+          expected.push_back(i);
+        }
+      }
+    }
+    auto rows = lcache.getSliceFor(value);
+    REQUIRE(std::vector<int64_t>(rows.begin(), rows.end()) == expected);
+  }
+
+  // an update with an empty table clears the cache entry
+  TableBuilder builderTE;
+  builderTE.cursor<aod::TrksXU>(); // only to define the schema, no rows are written
+  s = cache.updateCacheEntryUnsorted(0, builderTE.finalize());
+  REQUIRE(s.ok());
+  REQUIRE(cache.getCacheUnsortedFor(bk).getSliceFor(2).size() == 0);
+}
@@ -0,0 +1,65 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "../src/StreamPool.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/// Tasks finishing out of order are still committed in submission order.
+TEST_CASE("TestStreamPoolOrdering")
+{
+  using namespace o2::framework;
+  std::atomic<int> notified = 0;
+  StreamPool pool(4, [&notified]() { notified++; });
+  REQUIRE(pool.getNStreams() == 4);
+
+  std::vector<int> committed;
+  std::mutex streamsMutex;
+  std::set<int> streams;
+  for (int i = 0; i < 32; ++i) {
+    pool.submit({[i, &streamsMutex, &streams](int stream) {
+                   // earlier tasks take longer
+                   std::this_thread::sleep_for(std::chrono::microseconds((32 - i) * 50));
+                   std::lock_guard<std::mutex> lock(streamsMutex);
+                   streams.insert(stream);
+                 },
+                 [i, &committed]() { committed.push_back(i); }});
+  }
+  pool.drain();
+  REQUIRE(pool.pending() == 0);
+  REQUIRE(committed.size() == 32);
+  for (int i = 0; i < 32; ++i) {
+    REQUIRE(committed[i] == i);
+  }
+  REQUIRE(streams.size() > 1);
+  for (auto stream : streams) {
+    REQUIRE(stream >= 0);
+    REQUIRE(stream < 4);
+  }
+}
+
+/// Exceptions are propagated to the committing thread.
+TEST_CASE("TestStreamPoolException")
+{
+  using namespace o2::framework;
+  StreamPool pool(2, nullptr);
+  bool committed = false;
+  pool.submit({[](int) { throw std::runtime_error("failed"); }, [&committed]() { committed = true; }});
+  REQUIRE_THROWS_AS(pool.drain(), std::runtime_error);
+  REQUIRE(committed == false);
+  REQUIRE(pool.pending() == 0);
+}
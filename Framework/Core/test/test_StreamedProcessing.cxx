@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/CallbackService.h"
+#include "Framework/ControlService.h"
+#include "Framework/EndOfStreamContext.h"
+#include "Framework/Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Framework/runDataProcessing.h"
+using namespace o2::framework;
+
+static constexpr int nTimeslices = 100;
+
+// A processor with several streams, whose timeslices take different times:
+// the consumer must still receive its outputs in order and none must be lost.
+WorkflowSpec defineDataProcessing(ConfigContext const& specs)
+{
+  DataProcessorSpec streamed{
+    "B",
+    {InputSpec{"x", "TST", "A", Lifetime::Timeframe}},
+    {OutputSpec{{"b"}, "TST", "B"}},
+    AlgorithmSpec{adaptStateful([](CallbackService& callbacks) {
+      callbacks.set<CallbackService::Id::PreProcessing>([](ServiceRegistryRef, int) {
+        static std::atomic<bool> running = false;
+        if (running.exchange(true)) {
+          LOG(fatal) << "PreProcessing callbacks invoked concurrently";
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        running = false;
+      });
+      return adaptStateless([](InputRecord& inputs, DataAllocator& outputs) {
+        auto& value = inputs.get<int>("x");
+        std::this_thread::sleep_for(std::chrono::milliseconds((value * 7) % 5));
+        outputs.make<int>(OutputRef{"b"}) = 2 * value;
+      });
+    })}};
+  streamed.nStreams = 4;
+
+  return WorkflowSpec{
+    {"A",
+     Inputs{},
+     {OutputSpec{{"a"}, "TST", "A"}},
+     AlgorithmSpec{adaptStateless([](DataAllocator& outputs, ControlService& control) {
+       static int count = 0;
+       outputs.make<int>(OutputRef{"a"}) = count++;
+       if (count == nTimeslices) {
+         control.endOfStream();
+         control.readyToQuit(QuitRequest::Me);
+       }
+     })}},
+    streamed,
+    {"C",
+     {InputSpec{"y", "TST", "B", Lifetime::Timeframe}},
+     {},
+     AlgorithmSpec{adaptStateful([](CallbackService& callbacks) {
+       static int expected = 0;
+       callbacks.set<CallbackService::Id::EndOfStream>([](EndOfStreamContext& context) {
+         if (expected != nTimeslices) {
+           LOGP(fatal, "Received {} timeslices, expected {}.", expected, nTimeslices);
+         }
+         context.services().get<ControlService>().readyToQuit(QuitRequest::All);
+       });
+       return adaptStateless([](InputRecord& inputs) {
+         auto& value = inputs.get<int>("y");
+         if (value != 2 * expected) {
+           LOGP(fatal, "Out of order or missing timeslice. Expected: {}, Found {}.", 2 * expected, value);
+         }
+         expected++;
+       });
+     })}}};
+}
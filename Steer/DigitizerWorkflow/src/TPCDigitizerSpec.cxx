@@ -34,6 +34,7 @@
 #include "DataFormatsParameters/GRPObject.h"
 #include "DataFormatsTPC/TPCSectorHeader.h"
 #include "TPCBase/CDBInterface.h"
+#include "TPCBase/ParameterDetector.h"
 #include "DataFormatsTPC/Digit.h"
 #include "TPCSimulation/Digitizer.h"
 #include "TPCSimulation/Detector.h"
@@ -45,6 +46,10 @@
 #include "SimConfig/DigiParams.h"
 #include <filesystem>
 #include "TH3.h"
+#include "TROOT.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::framework;
 using SubSpecificationType = o2::framework::DataAllocator::SubSpecificationType;
@@ -175,6 +180,33 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     }
     mDigitizer.setContinuousReadout(!triggeredMode);
 
+    mNThreads = std::max(1, ic.options().get<int>("TPCthreads"));
+#ifndef WITH_OPENMP
+    if (mNThreads > 1) {
+      LOG(warning) << "TPC: OpenMP not available, digitizing the sectors sequentially";
+      mNThreads = 1;
+    }
+#endif
+    if (mNThreads > 1 && mInternalWriter) {
+      LOG(warning) << "TPC: The chunked writer works sector by sector, digitizing the sectors sequentially";
+      mNThreads = 1;
+    }
+    if (mNThreads > 1 && !ParameterDetector::Instance().CounterBasedRandom) {
+      // otherwise the random rings of every thread are filled from gRandom, in the order the threads happen to start
+      LOG(fatal) << "TPC: Digitizing the sectors concurrently requires TPCDetParam.CounterBasedRandom=true for reproducible digits";
+    }
+    if (mNThreads > 1) {
+      LOG(info) << "TPC: Digitizing up to " << mNThreads << " sectors concurrently";
+      ROOT::EnableThreadSafety();
+      // the digitizer of the task keeps the distortions shared by the threads, but never digitizes
+      mDigitizer.releaseDigitContainer();
+      for (int thread = 0; thread < mNThreads; ++thread) {
+        auto& state = mThreadStates.emplace_back(std::make_unique<ThreadState>());
+        state->digitizer.setUseSCDistortions(mDigitizer);
+        state->digitizer.setContinuousReadout(!triggeredMode);
+      }
+    }
+
     // we send the GRP data once if the corresponding output channel is available
     // and set the flag to false after
     mWriteGRP = true;
@@ -209,7 +241,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     {
       std::stringstream brname;
       brname << "TPCDigit_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mDigits);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mFlushBuffer.digits);
       br->Fill();
       br->ResetAddress();
     }
@@ -217,7 +249,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       // labels
       std::stringstream brname;
       brname << "TPCDigitMCTruth_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mLabels);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mFlushBuffer.labels);
       br->Fill();
       br->ResetAddress();
     }
@@ -225,7 +257,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       // common
       std::stringstream brname;
       brname << "TPCCommonMode_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mCommonMode);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mFlushBuffer.commonMode);
       br->Fill();
       br->ResetAddress();
     }
@@ -253,6 +285,10 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
            vd.corrFact, vd.refVDrift, vd.timeOffsetCorr, vd.refTimeOffset, mTPCVDriftHelper.getSourceName());
       mDigitizer.setVDrift(vd.getVDrift());
       mDigitizer.setTDriftOffset(vd.getTimeOffset());
+      for (auto& state : mThreadStates) {
+        state->digitizer.setVDrift(vd.getVDrift());
+        state->digitizer.setTDriftOffset(vd.getTimeOffset());
+      }
       mTPCVDriftHelper.acknowledgeUpdate();
     }
 
@@ -266,6 +302,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       cdb.setGainMapFromFile("GainMap.root");
     }
 
+    if (mNThreads > 1) {
+      processSectors(pc);
+      return;
+    }
+
     for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
       for (auto const& inputref : it) {
         if (inputref.spec->lifetime == o2::framework::Lifetime::Condition) { // process does not need conditions
@@ -273,7 +314,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         }
         process(pc, inputref);
         if (mInternalWriter) {
-          mInternalROOTFlushTTree->SetEntries(mFlushCounter);
+          mInternalROOTFlushTTree->SetEntries(mFlushBuffer.flushCounter);
           mInternalROOTFlushFile->Write("", TObject::kOverwrite);
           mInternalROOTFlushFile->Close();
           // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
@@ -281,8 +322,8 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
           mInternalROOTFlushFile = nullptr;
         }
         // TODO: make generic reset method?
-        mFlushCounter = 0;
-        mDigitCounter = 0;
+        mFlushBuffer.flushCounter = 0;
+        mFlushBuffer.digitCounter = 0;
       }
     }
   }
@@ -388,54 +429,213 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       throw std::runtime_error("Digitizer can only work on single sectors");
     }
 
-    mDigitizer.setSector(sector);
-    mDigitizer.init();
-
-    auto& eventParts = context->getEventParts();
-
-    auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush = false) {
-      mFlushCounter++;
-      // flush previous buffer
-      mDigits.clear();
-      mLabels.clear();
-      mCommonMode.clear();
-      mDigitizer.flush(mDigits, mLabels, mCommonMode, finalFlush);
-      LOG(info) << "TPC: Flushed " << mDigits.size() << " digits, " << mLabels.getNElements() << " labels and " << mCommonMode.size() << " common mode entries";
-
+    auto accumulate = [this, digitsAccum, &labelAccum, &commonModeAccum]() {
       if (mInternalWriter) {
         // the natural place to write out this independent datachunk immediately ...
         writeToROOTFile();
       } else {
         // ... or to accumulate and later forward to next DPL proc
-        std::copy(mDigits.begin(), mDigits.end(), std::back_inserter(*digitsAccum));
+        std::copy(mFlushBuffer.digits.begin(), mFlushBuffer.digits.end(), std::back_inserter(*digitsAccum));
         if (mWithMCTruth) {
-          labelAccum.mergeAtBack(mLabels);
+          labelAccum.mergeAtBack(mFlushBuffer.labels);
         }
-        std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
+        std::copy(mFlushBuffer.commonMode.begin(), mFlushBuffer.commonMode.end(), std::back_inserter(commonModeAccum));
       }
-      mDigitCounter += mDigits.size();
     };
 
-    if (isContinuous) {
-      auto& hbfu = o2::raw::HBFUtils::Instance();
-      double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
-      mDigitizer.setOutputDigitTimeOffset(time);
-      mDigitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+    TStopwatch timer;
+    timer.Start();
+
+    digitizeSector(mDigitizer, mSimChains, *context, sector, mFlushBuffer, eventAccum, accumulate);
+
+    if (!mInternalWriter) {
+      // send out to next stage
+      snapshotEvents(eventAccum);
+      // snapshotDigits(digitsAccum); --> done automatically
+      snapshotCommonMode(commonModeAccum);
+      snapshotLabels(labelAccum);
+    }
+
+    timer.Stop();
+    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+  }
+
+  // process all sectors of this device concurrently, each thread with its own digitizer
+  void processSectors(framework::ProcessingContext& pc)
+  {
+    using ContextPtr = decltype(pc.inputs().get<o2::steer::DigitizationContext*>(framework::DataRef{}));
+    struct SectorOutput {
+      ContextPtr context;
+      int sector = 0;
+      uint64_t activeSectors = 0;
+      SubSpecificationType subSpecification = 0;
+      std::vector<o2::tpc::Digit>* digits = nullptr;
+      o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+      std::vector<o2::tpc::CommonMode> commonMode;
+      std::vector<DigiGroupRef> events;
+    };
+    std::vector<SectorOutput> sectors;
+
+    // the inputs and outputs are handled sequentially
+    for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
+      for (auto const& inputref : it) {
+        if (inputref.spec->lifetime == o2::framework::Lifetime::Condition) { // process does not need conditions
+          continue;
+        }
+        auto context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
+        LOG(info) << "TPC: Processing " << context->getEventRecords().size() << " collisions";
+        if (context->getEventRecords().size() == 0) {
+          continue;
+        }
+        auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
+        if (mWriteGRP && pc.outputs().isAllowed({"TPC", "ROMode", 0})) {
+          auto roMode = mDigitizer.isContinuousReadout() ? o2::parameters::GRPObject::CONTINUOUS : o2::parameters::GRPObject::PRESENT;
+          LOG(info) << "TPC: Sending ROMode= " << (mDigitizer.isContinuousReadout() ? "Continuous" : "Triggered")
+                    << " to GRPUpdater from channel " << dh->subSpecification;
+          pc.outputs().snapshot(Output{"TPC", "ROMode", 0, Lifetime::Timeframe}, roMode);
+        }
+        mWriteGRP = false;
+
+        auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
+        if (sectorHeader == nullptr) {
+          LOG(error) << "TPC: Sector header missing, skipping processing";
+          continue;
+        }
+        auto sector = sectorHeader->sector();
+        if (sector < 0) {
+          throw std::runtime_error("Legacy control information is not expected any more");
+        }
+        if (sector >= TPCSectorHeader::NSectors) {
+          throw std::runtime_error("Digitizer can only work on single sectors");
+        }
+        mListOfSectors.push_back(sector);
+
+        // every thread reads the hits through its own chains
+        for (auto& state : mThreadStates) {
+          context->initSimChains(o2::detectors::DetID::TPC, state->simChains);
+        }
+
+        auto& output = sectors.emplace_back();
+        output.context = std::move(context);
+        output.sector = sector;
+        output.activeSectors = sectorHeader->activeSectors;
+        output.subSpecification = static_cast<SubSpecificationType>(dh->subSpecification);
+        o2::tpc::TPCSectorHeader header{sector};
+        header.activeSectors = output.activeSectors;
+        output.digits = &pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"TPC", "DIGITS", output.subSpecification, Lifetime::Timeframe, header});
+      }
+    }
+    if (sectors.empty()) {
+      return;
     }
 
+    // the distortions and the calibration objects shared by all threads are set up before the threads start
+    mDigitizer.init();
+
     TStopwatch timer;
     timer.Start();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (size_t iSector = 0; iSector < sectors.size(); ++iSector) {
+      int thread = 0;
+#ifdef WITH_OPENMP
+      thread = omp_get_thread_num();
+#endif
+      auto& state = *mThreadStates[thread];
+      auto& flushBuffer = state.flushBuffer;
+      auto& output = sectors[iSector];
+      flushBuffer.flushCounter = 0;
+      flushBuffer.digitCounter = 0;
+      auto accumulate = [this, &flushBuffer, &output]() {
+        std::copy(flushBuffer.digits.begin(), flushBuffer.digits.end(), std::back_inserter(*output.digits));
+        if (mWithMCTruth) {
+          output.labels.mergeAtBack(flushBuffer.labels);
+        }
+        std::copy(flushBuffer.commonMode.begin(), flushBuffer.commonMode.end(), std::back_inserter(output.commonMode));
+      };
+      digitizeSector(state.digitizer, state.simChains, *output.context, output.sector, flushBuffer, output.events, accumulate);
+    }
+    // the debug output of the shared distortions is flushed once, after all threads are done
+    mDigitizer.flushDebugStreamer();
+    timer.Stop();
+    LOG(info) << "TPC: Digitization of " << sectors.size() << " sectors with " << mNThreads << " threads took " << timer.CpuTime() << "s CPU, " << timer.RealTime() << "s real time";
+
+    for (auto& output : sectors) {
+      o2::tpc::TPCSectorHeader header{output.sector};
+      header.activeSectors = output.activeSectors;
+      LOG(info) << "TPC: Send TRIGGERS for sector " << output.sector << " channel " << output.subSpecification << " | size " << output.events.size();
+      pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", output.subSpecification, Lifetime::Timeframe, header}, output.events);
+      pc.outputs().snapshot(Output{"TPC", "COMMONMODE", output.subSpecification, Lifetime::Timeframe, header}, output.commonMode);
+      if (mWithMCTruth) {
+        auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", output.subSpecification, Lifetime::Timeframe, header});
+        output.labels.flatten_to(sharedlabels);
+      }
+    }
+  }
+
+ private:
+  /// output of one flush of a digitizer
+  struct FlushBuffer {
+    std::vector<o2::tpc::Digit> digits;
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    size_t digitCounter = 0;
+    size_t flushCounter = 0;
+  };
+
+  /// state of a thread digitizing sectors concurrently
+  struct ThreadState {
+    o2::tpc::Digitizer digitizer;
+    std::vector<TChain*> simChains;
+    FlushBuffer flushBuffer;
+  };
+
+  // digitize all collisions of the context in one sector, accumulate is called after each flush
+  template <typename Accumulate>
+  void digitizeSector(o2::tpc::Digitizer& digitizer, std::vector<TChain*> const& simChains, o2::steer::DigitizationContext const& context, int sector,
+                      FlushBuffer& flushBuffer, std::vector<DigiGroupRef>& eventAccum, Accumulate&& accumulate)
+  {
+    auto& irecords = context.getEventRecords();
+    auto& eventParts = context.getEventParts();
+    const bool isContinuous = digitizer.isContinuousReadout();
+
+    // the thread local GEM, transport and SAMPA instances are created and access the CDB in there
+#pragma omp critical
+    {
+      digitizer.setSector(sector);
+      digitizer.init();
+      if (isContinuous) {
+        auto& hbfu = o2::raw::HBFUtils::Instance();
+        double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
+        digitizer.setOutputDigitTimeOffset(time);
+        digitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+      }
+    }
+
+    auto flushDigitsAndLabels = [&digitizer, &flushBuffer, &accumulate](bool finalFlush = false) {
+      flushBuffer.flushCounter++;
+      // flush previous buffer
+      flushBuffer.digits.clear();
+      flushBuffer.labels.clear();
+      flushBuffer.commonMode.clear();
+      digitizer.flush(flushBuffer.digits, flushBuffer.labels, flushBuffer.commonMode, finalFlush);
+      LOG(info) << "TPC: Flushed " << flushBuffer.digits.size() << " digits, " << flushBuffer.labels.getNElements() << " labels and " << flushBuffer.commonMode.size() << " common mode entries";
+      accumulate();
+      flushBuffer.digitCounter += flushBuffer.digits.size();
+    };
 
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < irecords.size(); ++collID) {
       const double eventTime = irecords[collID].getTimeNS() / 1000.f;
       LOG(info) << "TPC: Event time " << eventTime << " us";
-      mDigitizer.setEventTime(eventTime);
+      digitizer.setEventTime(eventTime);
       if (!isContinuous) {
-        mDigitizer.setStartTime(eventTime);
+#pragma omp critical
+        digitizer.setStartTime(eventTime);
       }
-      size_t startSize = mDigitCounter; // digitsAccum->size();
+      size_t startSize = flushBuffer.digitCounter; // digitsAccum->size();
 
       // for each collision, loop over the constituents event and source IDs
       // (background signal merging is basically taking place here)
@@ -446,17 +646,17 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         // get the hits for this event and this source
         std::vector<o2::tpc::HitGroup> hitsLeft;
         std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        context.retrieveHits(simChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
+        context.retrieveHits(simChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
         LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
-        mDigitizer.process(hitsLeft, eventID, sourceID);
-        mDigitizer.process(hitsRight, eventID, sourceID);
+        digitizer.process(hitsLeft, eventID, sourceID);
+        digitizer.process(hitsRight, eventID, sourceID);
 
         flushDigitsAndLabels();
 
         if (!isContinuous) {
-          eventAccum.emplace_back(startSize, mDigits.size());
+          eventAccum.emplace_back(startSize, flushBuffer.digits.size());
         }
       }
     }
@@ -465,33 +665,19 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     if (isContinuous) {
       LOG(info) << "TPC: Final flush";
       flushDigitsAndLabels(true);
-      eventAccum.emplace_back(0, mDigitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
-    }
-
-    if (!mInternalWriter) {
-      // send out to next stage
-      snapshotEvents(eventAccum);
-      // snapshotDigits(digitsAccum); --> done automatically
-      snapshotCommonMode(commonModeAccum);
-      snapshotLabels(labelAccum);
+      eventAccum.emplace_back(0, flushBuffer.digitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
     }
-
-    timer.Stop();
-    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
   }
 
- private:
   o2::tpc::Digitizer mDigitizer;
   o2::tpc::VDriftHelper mTPCVDriftHelper{};
   std::vector<TChain*> mSimChains;
-  std::vector<o2::tpc::Digit> mDigits;
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
-  std::vector<o2::tpc::CommonMode> mCommonMode;
+  FlushBuffer mFlushBuffer;
+  std::vector<std::unique_ptr<ThreadState>> mThreadStates; // one per thread if the sectors are digitized concurrently
   std::vector<int> mListOfSectors; //  a list of sectors treated by this task
   TFile* mInternalROOTFlushFile = nullptr;
   TTree* mInternalROOTFlushTTree = nullptr;
-  size_t mDigitCounter = 0;
-  size_t mFlushCounter = 0;
+  int mNThreads = 1; // number of sectors digitized concurrently
   int mLaneId = 0; // the id of the current process within the parallel pipeline
   int mSector = 0;
   bool mWriteGRP = false;
@@ -537,6 +723,7 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
       {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
       {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}},
       {"TPCuseCCDB", VariantType::Bool, false, {"true: load calibrations from CCDB; false: use random calibratoins"}},
+      {"TPCthreads", VariantType::Int, 1, {"Number of threads digitizing the sectors of this device concurrently, with shared calibrations (use with few tpc-lanes, requires TPCDetParam.CounterBasedRandom=true)"}},
     }};
 }
 
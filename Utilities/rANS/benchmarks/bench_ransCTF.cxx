@@ -0,0 +1,189 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_ransCTF.cxx
+/// @brief  encoding/decoding speed and compression of CTF blocks for synthetic detector payloads
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "rANS/rans.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace
+{
+using namespace o2::ctf;
+
+struct BenchHeader {
+  int dummy = 0;
+};
+using container_t = EncodedBlocks<BenchHeader, 1, uint32_t>;
+
+constexpr size_t NSymbols = 1 << 20;  // symbols per block, typical for a column of a large TF
+constexpr uint32_t Seed = 0x5eed;     // fixed, such that all runs see the same payloads
+const char* DefaultOutput = "o2-bench-rans-ctf.json";
+
+template <typename source_T, typename F>
+std::shared_ptr<std::vector<source_T>> generate(F&& sample)
+{
+  std::mt19937 gen(Seed);
+  auto payload = std::make_shared<std::vector<source_T>>(NSymbols);
+  for (auto& s : *payload) {
+    s = static_cast<source_T>(sample(gen));
+  }
+  return payload;
+}
+
+// Zipf-like distribution of n values, e.g. for cluster pattern IDs
+std::discrete_distribution<int> makeZipf(int n, double exponent)
+{
+  std::vector<double> weights(n);
+  for (int i = 0; i < n; i++) {
+    weights[i] = 1. / std::pow(i + 1, exponent);
+  }
+  return {weights.begin(), weights.end()};
+}
+
+struct Variant {
+  const char* name;
+  Metadata::OptStore opt;
+};
+
+const Variant Variants[] = {{"EENCODE", Metadata::OptStore::EENCODE},
+                            {"EENCODE_INTERLEAVED", Metadata::OptStore::EENCODE_INTERLEAVED},
+                            {"AUTO", Metadata::OptStore::AUTO}};
+
+const uint8_t Precisions[] = {0, 12, 16, 20}; // 0: default precision from the symbol statistics
+
+template <typename source_T>
+void setCounters(benchmark::State& state, const container_t& ec)
+{
+  const auto& md = ec.getMetadata(0);
+  state.SetBytesProcessed(int64_t(state.iterations()) * NSymbols * sizeof(source_T));
+  state.counters["compressedBytes"] = md.getCompressedSize();
+  state.counters["compressionRatio"] = double(md.getUncompressedSize()) / md.getCompressedSize();
+  state.counters["probabilityBits"] = md.probabilityBits;
+}
+
+template <typename source_T>
+void encodeBlock(std::vector<BufferType>& buffer, const std::vector<source_T>& payload, uint8_t precision, Metadata::OptStore opt)
+{
+  buffer.clear();
+  container_t::create(buffer);
+  container_t::get(buffer.data())->encode(payload, 0, precision, opt, &buffer);
+}
+
+template <typename source_T>
+void registerPayload(const std::string& name, std::shared_ptr<std::vector<source_T>> payload)
+{
+  for (const auto& variant : Variants) {
+    for (auto precision : Precisions) {
+      if (variant.opt == Metadata::OptStore::AUTO && precision) {
+        continue; // precision is chosen by the encoder
+      }
+      const std::string prefix = name + "/" + variant.name + "/" + std::to_string(precision);
+
+      benchmark::RegisterBenchmark((prefix + "/encode").c_str(), [=](benchmark::State& state) {
+        std::vector<BufferType> buffer;
+        for (auto _ : state) {
+          encodeBlock(buffer, *payload, precision, variant.opt);
+          benchmark::DoNotOptimize(buffer.data());
+        }
+        setCounters<source_T>(state, *container_t::get(buffer.data()));
+      });
+
+      benchmark::RegisterBenchmark((prefix + "/decode").c_str(), [=](benchmark::State& state) {
+        std::vector<BufferType> buffer;
+        encodeBlock(buffer, *payload, precision, variant.opt);
+        const auto* ec = container_t::get(buffer.data());
+        std::vector<source_T> decoded(payload->size());
+        for (auto _ : state) {
+          ec->decode(decoded.begin(), 0);
+          benchmark::ClobberMemory();
+        }
+        if (decoded != *payload) {
+          state.SkipWithError("decoded message differs from the source");
+        }
+        setCounters<source_T>(state, *ec);
+      });
+    }
+  }
+
+  // per-TF dictionary: statistics, renormalization and construction of the coders
+  for (auto precision : Precisions) {
+    benchmark::RegisterBenchmark((name + "/dictionary/" + std::to_string(precision)).c_str(), [=](benchmark::State& state) {
+      for (auto _ : state) {
+        auto renormed = o2::rans::renorm(o2::rans::makeFrequencyTableFromSamples(payload->begin(), payload->end()), precision);
+        o2::rans::LiteralEncoder64<source_T> encoder{renormed};
+        o2::rans::LiteralDecoder64<source_T> decoder{renormed};
+        benchmark::DoNotOptimize(encoder);
+        benchmark::DoNotOptimize(decoder);
+      }
+      state.SetBytesProcessed(int64_t(state.iterations()) * NSymbols * sizeof(source_T));
+    });
+  }
+}
+
+// Distributions mimic the columns produced by the detector compressors: small increments, residuals wrapped around 0,
+// skewed charges and pattern IDs.
+void registerPayloads()
+{
+  registerPayload("ITSMFT/row", generate<uint16_t>([](auto& gen) { return std::uniform_int_distribution<int>(0, 511)(gen); }));
+  registerPayload("ITSMFT/colInc", generate<int16_t>([](auto& gen) { return std::geometric_distribution<int>(0.05)(gen); }));
+  registerPayload("ITSMFT/chipInc", generate<uint16_t>([](auto& gen) { return std::geometric_distribution<int>(0.4)(gen); }));
+  registerPayload("ITSMFT/pattID", generate<uint16_t>([zipf = makeZipf(2000, 1.2)](auto& gen) mutable { return zipf(gen); }));
+
+  registerPayload("TPC/qTotA", generate<uint16_t>([](auto& gen) { return std::min(std::lognormal_distribution<double>(4., 0.6)(gen), 8191.); }));
+  registerPayload("TPC/flagsA", generate<uint8_t>([flags = std::discrete_distribution<int>({90, 5, 3, 1, 1})](auto& gen) mutable { return flags(gen); }));
+  registerPayload("TPC/padResA", generate<uint16_t>([](auto& gen) { return int16_t(std::lround(std::normal_distribution<double>(0., 20.)(gen))); }));
+  registerPayload("TPC/timeResA", generate<uint32_t>([](auto& gen) { return uint32_t(std::lround(std::normal_distribution<double>(0., 60.)(gen))) & 0xffffff; }));
+
+  registerPayload("TOF/timeTDCInc", generate<uint32_t>([](auto& gen) { return std::geometric_distribution<int>(0.002)(gen); }));
+  registerPayload("TOF/tot", generate<uint16_t>([](auto& gen) { return std::max(std::normal_distribution<double>(400., 60.)(gen), 0.); }));
+
+  registerPayload("MCH/adc", generate<uint32_t>([](auto& gen) { return std::exponential_distribution<double>(1. / 300.)(gen); }));
+  registerPayload("MCH/nSamples", generate<uint16_t>([](auto& gen) { return std::max(std::normal_distribution<double>(20., 5.)(gen), 1.); }));
+}
+
+} // namespace
+
+// results are written as JSON to o2-bench-rans-ctf.json unless another --benchmark_out is requested
+int main(int argc, char** argv)
+{
+  registerPayloads();
+
+  std::vector<char*> args(argv, argv + argc);
+  std::string out = std::string("--benchmark_out=") + DefaultOutput;
+  std::string outFormat = "--benchmark_out_format=json";
+  bool hasOut = false;
+  for (int i = 1; i < argc; i++) {
+    hasOut |= std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+  }
+  if (!hasOut) {
+    args.push_back(out.data());
+    args.push_back(outFormat.data());
+  }
+  int nArgs = args.size();
+  args.push_back(nullptr);
+
+  benchmark::Initialize(&nArgs, args.data());
+  if (benchmark::ReportUnrecognizedArguments(nArgs, args.data())) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -32,6 +32,7 @@
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
 #include "rANS/internal/DecoderBase.h"
+#include "rANS/internal/InterleavedDecoder.h"
 
 namespace o2
 {
@@ -47,6 +48,10 @@ class LiteralDecoder : public internal::DecoderBase<coder_T, stream_T, source_T>
   template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const;
 
+  // decode a message produced by LiteralEncoder::processInterleaved with the same nStreams_V
+  template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  void processInterleaved(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const;
+
  private:
   using ransDecoder_t = typename internal::DecoderBase<coder_T, stream_T, source_T>::ransDecoder_t;
 };
@@ -119,6 +124,74 @@ void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, so
 
   LOG(trace) << "done decoding";
 }
+
+template <typename coder_T, typename stream_T, typename source_T>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+void LiteralDecoder<coder_T, stream_T, source_T>::processInterleaved(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const
+{
+  using namespace internal;
+  using interleavedCoder_t = InterleavedDecoder<coder_T, stream_T, nStreams_V>;
+  LOG(trace) << "start decoding";
+  RANSTimer t;
+  t.start();
+
+  if (messageLength == 0) {
+    LOG(warning) << "Empty message passed to decoder, skipping decode process";
+    return;
+  }
+
+  stream_IT inputIter = inputEnd;
+  source_IT it = outputBegin;
+
+  const DecoderSymbol* const escapeSymbol = &this->mSymbolTable.getEscapeSymbol();
+  auto toSourceSymbol = [&](symbol_t streamSymbol, const DecoderSymbol& decoderSymbol) -> source_T {
+    if (&decoderSymbol == escapeSymbol) {
+      const source_T symbol = literals.back();
+      literals.pop_back();
+      return symbol;
+    }
+    return streamSymbol;
+  };
+
+  // make Iter point to the last last element
+  --inputIter;
+
+  interleavedCoder_t coder{this->mSymbolTable.getPrecision()};
+  inputIter = coder.init(inputIter);
+
+  // hot loop, compiled for all supported instruction sets and selected at runtime
+  auto decodeLanes = [&, this]() RANS_ALWAYS_INLINE_LAMBDA {
+    std::array<symbol_t, nStreams_V> streamSymbols;
+    std::array<const DecoderSymbol*, nStreams_V> decoderSymbols;
+    for (size_t i = 0; i < messageLength / nStreams_V; ++i) {
+      coder.getSymbols(this->mReverseLUT.begin(), streamSymbols);
+      forEachLane<nStreams_V>([&, this](auto lane) {
+        decoderSymbols[lane] = &(this->mSymbolTable)[streamSymbols[lane]];
+        *it++ = toSourceSymbol(streamSymbols[lane], *decoderSymbols[lane]);
+      });
+      inputIter = coder.advanceSymbols(inputIter, decoderSymbols);
+    }
+  };
+  dispatchSIMD(decodeLanes);
+
+  // symbols beyond the last full set of lanes
+  for (size_t lane = 0; lane < messageLength % nStreams_V; ++lane) {
+    const symbol_t streamSymbol = (this->mReverseLUT)[coder.get(lane)];
+    const DecoderSymbol& decoderSymbol = (this->mSymbolTable)[streamSymbol];
+    *it++ = toSourceSymbol(streamSymbol, decoderSymbol);
+    inputIter = coder.advanceSymbol(inputIter, decoderSymbol, lane);
+  }
+  t.stop();
+
+  LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
+              << "processedBytes: " << messageLength * sizeof(source_T) << ","
+              << " nStreams: " << nStreams_V << ","
+              << " SIMD: " << toString(getSIMDWidth()) << ","
+              << " inclusiveTimeMS: " << t.getDurationMS() << ","
+              << " BandwidthMiBPS: " << std::fixed << std::setprecision(2) << (messageLength * sizeof(source_T) * 1.0) / (t.getDurationS() * 1.0 * (1 << 20)) << "}";
+
+  LOG(trace) << "done decoding";
+}
 } // namespace rans
 } // namespace o2
 
@@ -26,6 +26,7 @@
 
 #include "rANS/internal/EncoderBase.h"
 #include "rANS/internal/EncoderSymbol.h"
+#include "rANS/internal/InterleavedEncoder.h"
 #include "rANS/internal/helper.h"
 #include "rANS/internal/SymbolTable.h"
 
@@ -45,6 +46,10 @@ class LiteralEncoder : public internal::EncoderBase<coder_T, stream_T, source_T>
   template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
   stream_IT process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const;
 
+  // encode with nStreams_V interleaved rANS states, the output has to be decoded by LiteralDecoder::processInterleaved with the same nStreams_V
+  template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  stream_IT processInterleaved(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const;
+
  private:
   using ransCoder_t = typename internal::EncoderBase<coder_T, stream_T, source_T>::ransCoder_t;
 };
@@ -132,6 +137,69 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
   return outputIter;
 };
 
+template <typename coder_T, typename stream_T, typename source_T>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+stream_IT LiteralEncoder<coder_T, stream_T, source_T>::processInterleaved(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const
+{
+  using namespace internal;
+  using interleavedCoder_t = InterleavedEncoder<coder_T, stream_T, nStreams_V>;
+  using encoderSymbol_t = typename interleavedCoder_t::encoderSymbol_t;
+  LOG(trace) << "start encoding";
+  RANSTimer t;
+  t.start();
+
+  if (inputBegin == inputEnd) {
+    LOG(warning) << "passed empty message to encoder, skip encoding";
+    return outputBegin;
+  }
+
+  interleavedCoder_t coder{this->mSymbolTable.getPrecision()};
+
+  stream_IT outputIter = outputBegin;
+  source_IT inputIT = inputEnd;
+
+  const auto inputBufferSize = std::distance(inputBegin, inputEnd);
+
+  const encoderSymbol_t* const escapeSymbol = &this->mSymbolTable.getEscapeSymbol();
+  auto lookupSymbol = [&, this](source_T symbol) -> const encoderSymbol_t& {
+    const encoderSymbol_t& encoderSymbol = (this->mSymbolTable)[symbol];
+    if (&encoderSymbol == escapeSymbol) {
+      literals.push_back(symbol);
+    }
+    return encoderSymbol;
+  };
+
+  // symbols beyond the last full set of lanes, NB: working in reverse!
+  for (size_t lane = inputBufferSize % nStreams_V; lane-- > 0;) {
+    outputIter = coder.putSymbol(outputIter, lookupSymbol(*(--inputIT)), lane);
+  }
+
+  // hot loop, compiled for all supported instruction sets and selected at runtime
+  auto encodeLanes = [&]() RANS_ALWAYS_INLINE_LAMBDA {
+    std::array<const encoderSymbol_t*, nStreams_V> encoderSymbols;
+    while (inputIT != inputBegin) {
+      forEachLaneReverse<nStreams_V>([&](auto lane) { encoderSymbols[lane] = &lookupSymbol(*(--inputIT)); });
+      outputIter = coder.putSymbols(outputIter, encoderSymbols);
+    }
+  };
+  dispatchSIMD(encodeLanes);
+  outputIter = coder.flush(outputIter);
+  // first iterator past the range so that sizes, distances and iterators work correctly.
+  ++outputIter;
+
+  t.stop();
+
+  LOG(debug1) << "Encoder::" << __func__ << " {ProcessedBytes: " << inputBufferSize * sizeof(source_T) << ","
+              << " nStreams: " << nStreams_V << ","
+              << " SIMD: " << toString(getSIMDWidth()) << ","
+              << " inclusiveTimeMS: " << t.getDurationMS() << ","
+              << " BandwidthMiBPS: " << std::fixed << std::setprecision(2) << (inputBufferSize * sizeof(source_T) * 1.0) / (t.getDurationS() * 1.0 * (1 << 20)) << "}";
+
+  LOG(trace) << "done encoding";
+
+  return outputIter;
+};
+
 } // namespace rans
 } // namespace o2
 
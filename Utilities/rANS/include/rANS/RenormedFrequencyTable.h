@@ -88,6 +88,14 @@ RenormedFrequencyTable renorm(FrequencyTable oldTable, size_t newPrecision = 0);
 
 RenormedFrequencyTable renormCutoffIncompressible(FrequencyTable oldTable, uint8_t newPrecision = 0, uint8_t lowProbabilityCutoffBits = 3);
 
+// Renorms to increasing precisions, up to MaxRenormThreshold, until one more bit shortens the expected code length by less than
+// relTolerance. Smaller precisions give smaller symbol tables which are faster to build and to look up when decoding.
+RenormedFrequencyTable renormOptimal(FrequencyTable oldTable, double_t relTolerance = 1e-3);
+
+// Expected size in bits of the message described by frequencyTable when coded with renormedFrequencyTable,
+// including the literals of incompressible symbols.
+double_t computeExpectedCodeLength(const FrequencyTable& frequencyTable, const RenormedFrequencyTable& renormedFrequencyTable);
+
 } // namespace rans
 } // namespace o2
 
@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedDecoder.h
+/// @brief  nStreams_V rANS decoder states reading from one input stream, advanced in lock-step
+
+#ifndef RANS_INTERNAL_INTERLEAVEDDECODER_H
+#define RANS_INTERNAL_INTERLEAVEDDECODER_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+#include "rANS/internal/DecoderSymbol.h"
+#include "rANS/internal/helper.h"
+#include "rANS/internal/simd.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// Counterpart of InterleavedEncoder: symbol i of a message is decoded by state i % nStreams_V.
+template <typename state_T, typename stream_T, size_t nStreams_V>
+class InterleavedDecoder
+{
+  static_assert((sizeof(state_T) == sizeof(uint32_t) && sizeof(stream_T) == sizeof(uint8_t)) ||
+                  (sizeof(state_T) == sizeof(uint64_t) && sizeof(stream_T) == sizeof(uint32_t)),
+                "Coder can either be 32Bit with 8 Bit stream type or 64 Bit Type with 32 Bit stream type");
+  static_assert(nStreams_V > 0 && isPow2(nStreams_V), "number of interleaved streams must be a power of 2");
+
+ public:
+  explicit InterleavedDecoder(size_t symbolTablePrecission) noexcept;
+
+  static constexpr size_t getNStreams() noexcept { return nStreams_V; };
+
+  // Initializes all lanes, first lane first.
+  template <typename stream_IT>
+  stream_IT init(stream_IT inputIter);
+
+  // Looks up the symbol currently on top of each lane in the reverse symbol lookup table.
+  void getSymbols(const symbol_t* reverseLUT, std::array<symbol_t, nStreams_V>& symbols) const;
+
+  // Removes the decoded symbols from all lanes and renormalizes them, first lane first.
+  template <typename stream_IT>
+  stream_IT advanceSymbols(stream_IT inputIter, const std::array<const DecoderSymbol*, nStreams_V>& symbols);
+
+  // Single lane versions, used for messages which are not a multiple of nStreams_V.
+  uint32_t get(size_t lane) const;
+
+  template <typename stream_IT>
+  stream_IT advanceSymbol(stream_IT inputIter, const DecoderSymbol& symbol, size_t lane);
+
+ private:
+  std::array<state_T, nStreams_V> mStates{};
+  size_t mSymbolTablePrecission{};
+
+  template <typename stream_IT>
+  stream_IT renorm(state_T& state, stream_IT inputIter) const;
+
+  inline static constexpr state_T LOWER_BOUND = needs64Bit<state_T>() ? (1u << 31) : (1u << 23); // lower bound of our normalization interval
+
+  inline static constexpr state_T STREAM_BITS = sizeof(stream_T) * 8;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+InterleavedDecoder<state_T, stream_T, nStreams_V>::InterleavedDecoder(size_t symbolTablePrecission) noexcept
+  : mSymbolTablePrecission{symbolTablePrecission} {};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::init(stream_IT inputIter)
+{
+  stream_IT streamPosition = inputIter;
+  for (auto& state : mStates) {
+    if constexpr (needs64Bit<state_T>()) {
+      state = static_cast<state_T>(*streamPosition--) << 0;
+      state |= static_cast<state_T>(*streamPosition--) << 32;
+    } else {
+      state = static_cast<state_T>(*streamPosition--) << 0;
+      state |= static_cast<state_T>(*streamPosition--) << 8;
+      state |= static_cast<state_T>(*streamPosition--) << 16;
+      state |= static_cast<state_T>(*streamPosition--) << 24;
+    }
+  }
+  return streamPosition;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+RANS_ALWAYS_INLINE void InterleavedDecoder<state_T, stream_T, nStreams_V>::getSymbols(const symbol_t* reverseLUT, std::array<symbol_t, nStreams_V>& symbols) const
+{
+  LookupLanes::apply(mStates, reverseLUT, mSymbolTablePrecission, symbols);
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::advanceSymbols(stream_IT inputIter, const std::array<const DecoderSymbol*, nStreams_V>& symbols)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+
+  std::array<count_t, nStreams_V> frequencies;
+  std::array<count_t, nStreams_V> cumulatives;
+  forEachLane<nStreams_V>([&](auto lane) {
+    frequencies[lane] = symbols[lane]->getFrequency();
+    cumulatives[lane] = symbols[lane]->getCumulative();
+  });
+  // s, x = D(x) is independent for each lane
+  AdvanceLanes::apply(mStates, frequencies, cumulatives, mSymbolTablePrecission);
+  // renormalization reads from the shared stream and has to respect the lane order
+  forEachLane<nStreams_V>([&, this](auto lane) { inputIter = renorm(mStates[lane], inputIter); });
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+RANS_ALWAYS_INLINE uint32_t InterleavedDecoder<state_T, stream_T, nStreams_V>::get(size_t lane) const
+{
+  assert(lane < nStreams_V);
+  return mStates[lane] & ((pow2(mSymbolTablePrecission)) - 1);
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::advanceSymbol(stream_IT inputIter, const DecoderSymbol& symbol, size_t lane)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+  assert(lane < nStreams_V);
+
+  const state_T mask = (pow2(mSymbolTablePrecission)) - 1;
+  state_T& state = mStates[lane];
+  state = symbol.getFrequency() * (state >> mSymbolTablePrecission) + (state & mask) - symbol.getCumulative();
+  return renorm(state, inputIter);
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::renorm(state_T& state, stream_IT inputIter) const
+{
+  if (state < LOWER_BOUND) {
+    if constexpr (needs64Bit<state_T>()) {
+      state = (state << STREAM_BITS) | *inputIter--;
+      assert(state >= LOWER_BOUND);
+    } else {
+      do {
+        state = (state << STREAM_BITS) | *inputIter--;
+      } while (state < LOWER_BOUND);
+    }
+  }
+  return inputIter;
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_INTERLEAVEDDECODER_H */
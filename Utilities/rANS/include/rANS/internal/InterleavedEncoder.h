@@ -0,0 +1,177 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedEncoder.h
+/// @brief  nStreams_V rANS encoder states sharing one output stream, advanced in lock-step
+
+#ifndef RANS_INTERNAL_INTERLEAVEDENCODER_H
+#define RANS_INTERNAL_INTERLEAVEDENCODER_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+#include "rANS/internal/EncoderSymbol.h"
+#include "rANS/internal/helper.h"
+#include "rANS/internal/simd.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// Symbol i of a message is always coded by state i % nStreams_V. With nStreams_V = 2 the produced stream is
+// bit-identical to the one of the two-way interleaved Encoder used by LiteralEncoder::process.
+template <typename state_T, typename stream_T, size_t nStreams_V>
+class InterleavedEncoder
+{
+  static_assert((sizeof(state_T) == sizeof(uint32_t) && sizeof(stream_T) == sizeof(uint8_t)) ||
+                  (sizeof(state_T) == sizeof(uint64_t) && sizeof(stream_T) == sizeof(uint32_t)),
+                "Coder can either be 32Bit with 8 Bit stream type or 64 Bit Type with 32 Bit stream type");
+  static_assert(nStreams_V > 0 && isPow2(nStreams_V), "number of interleaved streams must be a power of 2");
+
+ public:
+  using encoderSymbol_t = EncoderSymbol<state_T>;
+
+  explicit InterleavedEncoder(size_t symbolTablePrecission) noexcept;
+
+  static constexpr size_t getNStreams() noexcept { return nStreams_V; };
+
+  // Encodes one symbol per lane, symbols[i] goes to lane i. Lanes are processed from last to first.
+  template <typename stream_IT>
+  stream_IT putSymbols(stream_IT outputIter, const std::array<const encoderSymbol_t*, nStreams_V>& symbols);
+
+  // Encodes a single symbol with the given lane, used for messages which are not a multiple of nStreams_V.
+  template <typename stream_IT>
+  stream_IT putSymbol(stream_IT outputIter, const encoderSymbol_t& symbol, size_t lane);
+
+  // Flushes all lanes, last lane first.
+  template <typename stream_IT>
+  stream_IT flush(stream_IT outputIter);
+
+ private:
+  std::array<state_T, nStreams_V> mStates{};
+  size_t mSymbolTablePrecission{};
+
+  template <typename stream_IT>
+  stream_IT renorm(state_T& state, stream_IT outputIter, uint32_t frequency) const;
+
+  inline static constexpr state_T LOWER_BOUND = needs64Bit<state_T>() ? (1u << 31) : (1u << 23); // lower bound of our normalization interval
+
+  inline static constexpr state_T STREAM_BITS = sizeof(stream_T) * 8;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+InterleavedEncoder<state_T, stream_T, nStreams_V>::InterleavedEncoder(size_t symbolTablePrecission) noexcept
+  : mSymbolTablePrecission{symbolTablePrecission}
+{
+  mStates.fill(LOWER_BOUND);
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedEncoder<state_T, stream_T, nStreams_V>::putSymbols(stream_IT outputIter, const std::array<const encoderSymbol_t*, nStreams_V>& symbols)
+{
+  if constexpr (needs64Bit<state_T>()) {
+    // there is no vector instruction for the upper half of a 64x64 bit multiplication, lanes are only interleaved
+    forEachLaneReverse<nStreams_V>([&, this](auto lane) { outputIter = putSymbol(outputIter, *symbols[lane], lane); });
+  } else {
+    std::array<state_T, nStreams_V> reciprocalFrequencies;
+    std::array<count_t, nStreams_V> reciprocalShifts;
+    std::array<count_t, nStreams_V> biases;
+    std::array<count_t, nStreams_V> frequencyComplements;
+
+    // renormalization writes to the shared stream and has to respect the lane order
+    for (size_t i = nStreams_V; i-- > 0;) {
+      const encoderSymbol_t& symbol = *symbols[i];
+      assert(symbol.getFrequency() != 0); // can't encode symbol with freq=0
+      outputIter = renorm(mStates[i], outputIter, symbol.getFrequency());
+      reciprocalFrequencies[i] = symbol.getReciprocalFrequency();
+      reciprocalShifts[i] = symbol.getReciprocalShift();
+      biases[i] = symbol.getBias();
+      frequencyComplements[i] = symbol.getFrequencyComplement();
+    }
+    // x = C(s,x) is independent for each lane
+    EncodeLanes::apply(mStates, reciprocalFrequencies, reciprocalShifts, biases, frequencyComplements);
+  }
+  return outputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedEncoder<state_T, stream_T, nStreams_V>::putSymbol(stream_IT outputIter, const encoderSymbol_t& symbol, size_t lane)
+{
+  assert(lane < nStreams_V);
+  assert(symbol.getFrequency() != 0); // can't encode symbol with freq=0
+  state_T& state = mStates[lane];
+  outputIter = renorm(state, outputIter, symbol.getFrequency());
+
+  state_T quotient = 0;
+  if constexpr (needs64Bit<state_T>()) {
+    __extension__ using uint128_t = unsigned __int128;
+    quotient = static_cast<state_T>((static_cast<uint128_t>(state) * symbol.getReciprocalFrequency()) >> 64);
+  } else {
+    quotient = static_cast<state_T>((static_cast<uint64_t>(state) * symbol.getReciprocalFrequency()) >> 32);
+  }
+  quotient = quotient >> symbol.getReciprocalShift();
+  state = state + symbol.getBias() + quotient * symbol.getFrequencyComplement();
+  return outputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedEncoder<state_T, stream_T, nStreams_V>::flush(stream_IT outputIter)
+{
+  stream_IT streamPosition = outputIter;
+  for (size_t i = nStreams_V; i-- > 0;) {
+    const state_T state = mStates[i];
+    if constexpr (needs64Bit<state_T>()) {
+      *(++streamPosition) = static_cast<stream_T>(state >> 32);
+      *(++streamPosition) = static_cast<stream_T>(state >> 0);
+    } else {
+      *(++streamPosition) = static_cast<stream_T>(state >> 24);
+      *(++streamPosition) = static_cast<stream_T>(state >> 16);
+      *(++streamPosition) = static_cast<stream_T>(state >> 8);
+      *(++streamPosition) = static_cast<stream_T>(state >> 0);
+    }
+    mStates[i] = 0;
+  }
+  return streamPosition;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+RANS_ALWAYS_INLINE stream_IT InterleavedEncoder<state_T, stream_T, nStreams_V>::renorm(state_T& state, stream_IT outputIter, uint32_t frequency) const
+{
+  const state_T maxState = ((LOWER_BOUND >> mSymbolTablePrecission) << STREAM_BITS) * frequency; // this turns into a shift.
+  if (state >= maxState) {
+    if constexpr (needs64Bit<state_T>()) {
+      *(++outputIter) = static_cast<stream_T>(state);
+      state >>= STREAM_BITS;
+      assert(state < maxState);
+    } else {
+      do {
+        *(++outputIter) = static_cast<stream_T>(state & 0xff);
+        state >>= STREAM_BITS;
+      } while (state >= maxState);
+    }
+  }
+  return outputIter;
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_INTERLEAVEDENCODER_H */
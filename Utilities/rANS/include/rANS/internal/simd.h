@@ -0,0 +1,194 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   simd.h
+/// @brief  runtime selection of SIMD kernels operating on interleaved rANS states
+
+#ifndef RANS_INTERNAL_SIMD_H
+#define RANS_INTERNAL_SIMD_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "rANS/definitions.h"
+#include "rANS/internal/helper.h"
+
+// Kernels are compiled several times with different target ISAs and picked at runtime,
+// such that the same binary runs on any x86-64 node but profits from AVX2 where available.
+// ROOT cling and CUDA only ever see the scalar version.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(__CLING__) && !defined(__CUDACC__)
+#define RANS_SIMD_DISPATCH
+#define RANS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define RANS_TARGET(isa)
+#endif
+
+#define RANS_ALWAYS_INLINE inline __attribute__((always_inline))
+#define RANS_ALWAYS_INLINE_LAMBDA __attribute__((always_inline))
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+enum class SIMDWidth : uint8_t { Scalar,
+                                 SSE41,
+                                 AVX2 };
+
+inline constexpr std::string_view toString(SIMDWidth width) noexcept
+{
+  switch (width) {
+    case SIMDWidth::AVX2:
+      return "AVX2";
+    case SIMDWidth::SSE41:
+      return "SSE4.1";
+    default:
+      return "Scalar";
+  }
+}
+
+inline SIMDWidth detectSIMDWidth() noexcept
+{
+#ifdef RANS_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMDWidth::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SIMDWidth::SSE41;
+  }
+#endif
+  return SIMDWidth::Scalar;
+}
+
+/// widest instruction set supported by the host, detected once per process
+inline SIMDWidth getSIMDWidth() noexcept
+{
+  static const SIMDWidth width = detectSIMDWidth();
+  return width;
+}
+
+/// call f(std::integral_constant<size_t, lane>) for all lanes, unrolled at compile time so that lane states stay in registers
+template <size_t nStreams_V, typename F, size_t... lanes_V>
+RANS_ALWAYS_INLINE void forEachLaneImpl(F&& f, std::index_sequence<lanes_V...>)
+{
+  (f(std::integral_constant<size_t, lanes_V>{}), ...);
+}
+
+template <size_t nStreams_V, typename F>
+RANS_ALWAYS_INLINE void forEachLane(F&& f)
+{
+  forEachLaneImpl<nStreams_V>(std::forward<F>(f), std::make_index_sequence<nStreams_V>{});
+}
+
+/// same as forEachLane, starting from the last lane
+template <size_t nStreams_V, typename F>
+RANS_ALWAYS_INLINE void forEachLaneReverse(F&& f)
+{
+  forEachLane<nStreams_V>([&f](auto lane) { f(std::integral_constant<size_t, nStreams_V - 1 - decltype(lane)::value>{}); });
+}
+
+// Lane kernels. Each operates on all nStreams_V states of an interleaved coder at once. The loops have a fixed trip count
+// and no cross-lane dependencies, so that the compiler turns them into vector code (including gathers for the LUT accesses)
+// for the target ISA selected by dispatchSIMD.
+
+/// decoder: map the cumulative frequency of each lane to its symbol
+struct LookupLanes {
+  template <typename state_T, size_t nStreams_V>
+  static RANS_ALWAYS_INLINE void apply(const std::array<state_T, nStreams_V>& states, const symbol_t* __restrict__ reverseLUT,
+                                       size_t symbolTablePrecision, std::array<symbol_t, nStreams_V>& symbols)
+  {
+    const state_T mask = pow2(symbolTablePrecision) - 1;
+    for (size_t i = 0; i < nStreams_V; ++i) {
+      symbols[i] = reverseLUT[states[i] & mask];
+    }
+  }
+};
+
+/// decoder: s, x = D(x) for each lane, renormalization is done by the caller
+struct AdvanceLanes {
+  template <typename state_T, size_t nStreams_V>
+  static RANS_ALWAYS_INLINE void apply(std::array<state_T, nStreams_V>& states, const std::array<count_t, nStreams_V>& frequencies,
+                                       const std::array<count_t, nStreams_V>& cumulatives, size_t symbolTablePrecision)
+  {
+    const state_T mask = pow2(symbolTablePrecision) - 1;
+    for (size_t i = 0; i < nStreams_V; ++i) {
+      states[i] = static_cast<state_T>(frequencies[i]) * (states[i] >> symbolTablePrecision) + (states[i] & mask) - cumulatives[i];
+    }
+  }
+};
+
+/// encoder: x = C(s,x) for each lane of already renormalized states
+struct EncodeLanes {
+  __extension__ using uint128_t = unsigned __int128;
+
+  template <typename state_T, size_t nStreams_V>
+  static RANS_ALWAYS_INLINE void apply(std::array<state_T, nStreams_V>& states, const std::array<state_T, nStreams_V>& reciprocalFrequencies,
+                                       const std::array<count_t, nStreams_V>& reciprocalShifts, const std::array<count_t, nStreams_V>& biases,
+                                       const std::array<count_t, nStreams_V>& frequencyComplements)
+  {
+    for (size_t i = 0; i < nStreams_V; ++i) {
+      state_T quotient = 0;
+      if constexpr (needs64Bit<state_T>()) {
+        quotient = static_cast<state_T>((static_cast<uint128_t>(states[i]) * reciprocalFrequencies[i]) >> 64);
+      } else {
+        quotient = static_cast<state_T>((static_cast<uint64_t>(states[i]) * reciprocalFrequencies[i]) >> 32);
+      }
+      quotient = quotient >> reciprocalShifts[i];
+      states[i] = states[i] + biases[i] + quotient * frequencyComplements[i];
+    }
+  }
+};
+
+#ifdef RANS_SIMD_DISPATCH
+template <typename F>
+RANS_TARGET("sse4.1")
+decltype(auto) runSSE41(F& f)
+{
+  return f();
+}
+
+template <typename F>
+RANS_TARGET("avx2")
+decltype(auto) runAVX2(F& f)
+{
+  return f();
+}
+#endif
+
+/// Run f compiled for the given instruction set, falls back to the scalar version if not available.
+/// f should be declared RANS_ALWAYS_INLINE_LAMBDA and contain the complete hot loop, such that the kernels
+/// and helpers it uses are inlined and generated for the selected target as well.
+template <typename F>
+inline decltype(auto) dispatchSIMD(F&& f, SIMDWidth width = getSIMDWidth())
+{
+#ifdef RANS_SIMD_DISPATCH
+  switch (width) {
+    case SIMDWidth::AVX2:
+      return runAVX2(f);
+    case SIMDWidth::SSE41:
+      return runSSE41(f);
+    default:
+      break;
+  }
+#endif
+  return f();
+}
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_SIMD_H */
@@ -16,6 +16,8 @@
 
 #include "rANS/RenormedFrequencyTable.h"
 
+#include <optional>
+
 namespace o2
 {
 namespace rans
@@ -226,5 +228,49 @@ RenormedFrequencyTable renormCutoffIncompressible(FrequencyTable frequencyTable,
   return RenormedFrequencyTable{std::move(newFrequencyTable), newPrecision};
 }
 
+RenormedFrequencyTable renormOptimal(FrequencyTable frequencyTable, double_t relTolerance)
+{
+  using namespace internal;
+  // renorm adds an incompressible symbol, which needs its own slot
+  const size_t minPrecision = std::max<size_t>(numBitsForNSymbols(frequencyTable.getNUsedAlphabetSymbols() + 1), 1);
+  const size_t maxPrecision = std::max<size_t>(minPrecision, MaxRenormThreshold);
+
+  // the code length decreases with the precision, with diminishing returns: stop as soon as one more bit does not gain more than
+  // relTolerance, larger precisions would only give larger symbol tables
+  std::optional<RenormedFrequencyTable> best;
+  double_t bestCodeLength = 0;
+  for (size_t precision = minPrecision; precision <= maxPrecision; ++precision) {
+    RenormedFrequencyTable candidate = renorm(frequencyTable, precision);
+    const double_t codeLength = computeExpectedCodeLength(frequencyTable, candidate);
+    if (best && codeLength >= bestCodeLength * (1. - relTolerance)) {
+      break;
+    }
+    best = std::move(candidate);
+    bestCodeLength = codeLength;
+  }
+  LOG(debug1) << __func__ << " selected precision " << best->getRenormingBits() << " out of [" << minPrecision << ", " << maxPrecision
+              << "], expected code length " << bestCodeLength << " bits";
+  return std::move(*best);
+}
+
+double_t computeExpectedCodeLength(const FrequencyTable& frequencyTable, const RenormedFrequencyTable& renormedFrequencyTable)
+{
+  const double_t nSamplesRenormed = renormedFrequencyTable.getNumSamples();
+  auto codeLength = [nSamplesRenormed](count_t renormedFrequency) { return -std::log2(renormedFrequency / nSamplesRenormed); };
+  const double_t literalLength = codeLength(renormedFrequencyTable.getIncompressibleSymbolFrequency()) + frequencyTable.getAlphabetRangeBits();
+
+  double_t length = frequencyTable.getIncompressibleSymbolFrequency() * literalLength;
+  for (size_t i = 0; i < frequencyTable.size(); ++i) {
+    const count_t frequency = frequencyTable.at(i);
+    if (frequency == 0) {
+      continue;
+    }
+    const int64_t renormedIndex = static_cast<int64_t>(frequencyTable.getMinSymbol()) + i - renormedFrequencyTable.getMinSymbol();
+    const count_t renormedFrequency = (renormedIndex >= 0 && renormedIndex < static_cast<int64_t>(renormedFrequencyTable.size())) ? renormedFrequencyTable.at(renormedIndex) : 0;
+    length += frequency * (renormedFrequency ? codeLength(renormedFrequency) : literalLength);
+  }
+  return length;
+}
+
 } // namespace rans
 } // namespace o2
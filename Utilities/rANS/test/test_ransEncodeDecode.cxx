@@ -147,6 +147,21 @@ struct EncodeDecodeLiteral : public EncodeDecodeBase<o2::rans::LiteralEncoder, o
   std::vector<typename Params<coder_T>::source_t> literals;
 };
 
+template <typename coder_T, size_t nStreams_V, class dictString_T, class testString_T>
+struct EncodeDecodeInterleaved : public EncodeDecodeBase<o2::rans::LiteralEncoder, o2::rans::LiteralDecoder, coder_T, dictString_T, testString_T> {
+  void encode() override
+  {
+    BOOST_CHECK_NO_THROW(this->encoder.template processInterleaved<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer), literals));
+  };
+  void decode() override
+  {
+    BOOST_CHECK_NO_THROW(this->decoder.template processInterleaved<nStreams_V>(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size(), literals));
+    BOOST_CHECK(literals.empty());
+  };
+
+  std::vector<typename Params<coder_T>::source_t> literals;
+};
+
 template <typename coder_T, class dictString_T, class testString_T>
 struct EncodeDecodeDedup : public EncodeDecodeBase<o2::rans::DedupEncoder, o2::rans::DedupDecoder, coder_T, dictString_T, testString_T> {
   void encode() override
@@ -174,6 +189,12 @@ using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, Em
                                       EncodeDecodeLiteral<uint64_t, FullTestString, FullTestString>,
                                       EncodeDecodeLiteral<uint32_t, EmptyTestString, FullTestString>,
                                       EncodeDecodeLiteral<uint64_t, EmptyTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint32_t, 4, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 4, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 8, EmptyTestString, EmptyTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 8, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 16, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 16, EmptyTestString, FullTestString>,
                                       EncodeDecodeDedup<uint32_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint64_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint32_t, FullTestString, FullTestString>,
@@ -185,4 +206,37 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, testCase_T, testCase_t)
   testCase.encode();
   testCase.decode();
   testCase.check();
+};
+
+BOOST_AUTO_TEST_CASE(test_interleavedCompatibility)
+{
+  // two interleaved streams must reproduce the stream of the classic LiteralEncoder
+  FullTestString source;
+  const auto& s = source.data;
+  o2::rans::RenormedFrequencyTable frequencyTable = o2::rans::renorm(o2::rans::makeFrequencyTableFromSamples(std::begin(s), std::end(s)), 16);
+  o2::rans::LiteralEncoder64<char> encoder{frequencyTable};
+  std::vector<uint32_t> classic, interleaved;
+  std::vector<char> literals;
+  encoder.process(std::begin(s), std::end(s), std::back_inserter(classic), literals);
+  encoder.processInterleaved<2>(std::begin(s), std::end(s), std::back_inserter(interleaved), literals);
+  BOOST_CHECK_EQUAL_COLLECTIONS(classic.begin(), classic.end(), interleaved.begin(), interleaved.end());
+};
+
+BOOST_AUTO_TEST_CASE(test_interleavedSIMDWidth)
+{
+  // all kernel variants must produce the same states
+  std::array<uint64_t, 8> reference{}, dispatched{};
+  std::array<uint64_t, 8> rcp{};
+  std::array<uint32_t, 8> shift{}, bias{}, cmpl{};
+  for (size_t i = 0; i < 8; ++i) {
+    reference[i] = dispatched[i] = (1ull << 40) + 12345 * i;
+    rcp[i] = 0x123456789ull * (i + 1);
+    shift[i] = i % 3;
+    bias[i] = 17 * i;
+    cmpl[i] = (1u << 16) - 3 * i - 1;
+  }
+  using namespace o2::rans::internal;
+  dispatchSIMD([&]() RANS_ALWAYS_INLINE_LAMBDA { EncodeLanes::apply(reference, rcp, shift, bias, cmpl); }, SIMDWidth::Scalar);
+  dispatchSIMD([&]() RANS_ALWAYS_INLINE_LAMBDA { EncodeLanes::apply(dispatched, rcp, shift, bias, cmpl); });
+  BOOST_CHECK_EQUAL_COLLECTIONS(reference.begin(), reference.end(), dispatched.begin(), dispatched.end());
 };
\ No newline at end of file
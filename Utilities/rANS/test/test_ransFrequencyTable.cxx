@@ -381,6 +381,26 @@ BOOST_AUTO_TEST_CASE(test_renorm)
   BOOST_CHECK_EQUAL_COLLECTIONS(renormedFrequencyTable.begin(), renormedFrequencyTable.end(), rescaledFrequencies.begin(), rescaledFrequencies.end());
 }
 
+BOOST_AUTO_TEST_CASE(test_renormOptimal)
+{
+  o2::rans::histogram_t frequencies{1, 1, 2, 2, 2, 2, 6, 8, 4, 10, 8, 14, 10, 19, 26, 30, 31, 35, 41, 45, 51, 44, 47, 39, 58, 52, 42, 53, 50, 34, 50, 30, 32, 24, 30, 20, 17, 12, 16, 6, 8, 5, 6, 4, 4, 2, 2, 2, 1};
+  o2::rans::FrequencyTable frequencyTable{frequencies.begin(), frequencies.end(), 0};
+
+  auto renormedFrequencyTable = o2::rans::renormOptimal(frequencyTable, 1e-3);
+  const double_t codeLength = o2::rans::computeExpectedCodeLength(frequencyTable, renormedFrequencyTable);
+  // at least the entropy, at most the tolerance above the best precision
+  double_t entropy = 0;
+  for (auto frequency : frequencies) {
+    entropy -= frequency * std::log2(static_cast<double_t>(frequency) / frequencyTable.getNumSamples());
+  }
+  BOOST_CHECK_GE(codeLength, entropy);
+  for (size_t precision = 6; precision <= o2::rans::MaxRenormThreshold; ++precision) {
+    BOOST_CHECK_LE(codeLength, (1. + 1e-3) * o2::rans::computeExpectedCodeLength(frequencyTable, o2::rans::renorm(frequencyTable, precision)));
+  }
+  // no gain in going beyond the selected precision is the reason to select it
+  BOOST_CHECK_LT(renormedFrequencyTable.getRenormingBits(), o2::rans::MaxRenormThreshold);
+}
+
 BOOST_AUTO_TEST_CASE(test_renormIncompressible)
 {
   o2::rans::histogram_t frequencies{1, 1, 2, 2, 2, 2, 6, 8, 4, 10, 8, 14, 10, 19, 26, 30, 31, 35, 41, 45, 51, 44, 47, 39, 58, 52, 42, 53, 50, 34, 50, 30, 32, 24, 30, 20, 17, 12, 16, 6, 8, 5, 6, 4, 4, 2, 2, 2, 1};